@@ -27,8 +27,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _MSC_VER
 #define stricmp _stricmp
 #define strnicmp _strnicmp
+#else
+#include <strings.h>
+#define stricmp strcasecmp
+#define strnicmp strncasecmp
+#endif
 
 typedef struct
 {
@@ -90,6 +96,36 @@ unsigned int cpuinfo_count;
 char cg_profile_names[4000][32];
 int cg_profile_count = 0;
 
+#define CG_FUSION_CANDIDATES_MAX 65536
+#define CG_FUSION_MAX 128
+
+typedef struct
+{
+  unsigned int first_opcode;
+  unsigned int second_opcode;
+  double count;
+} cg_fusion_pair;
+
+cg_fusion_pair cg_fusion_candidates[CG_FUSION_CANDIDATES_MAX];
+int cg_fusion_candidate_count = 0;
+cg_fusion_pair cg_fusion_pairs[CG_FUSION_MAX];
+int cg_fusion_count = 0;
+
+#define CG_HANDLERS_MAX 4000
+
+typedef struct
+{
+  char name[32];
+  int opcodes;
+  double count;
+  double cycles;
+} cg_handler_total;
+
+double cg_opcode_count[65536];
+double cg_opcode_cycles[65536];
+cg_handler_total cg_handler_totals[CG_HANDLERS_MAX];
+int cg_handler_count = 0;
+
 #define M68000 0x01
 #define M68010 0x02
 #define M68020 0x04
@@ -186,6 +222,268 @@ void cgProfileDeclarations()
     cgProfileLogLine(cg_profile_names[i]);
 }
 
+/*===================================*/
+/* Instruction pair fusion functions */
+/*===================================*/
+
+/* The pair profile is the cpupairs.txt written by an emulator built with */
+/* CPU_INSTRUCTION_PAIR_PROFILE, one "first second count" line per pair.  */
+
+int cgFusionCompare(const void *a, const void *b)
+{
+  double count_a = ((const cg_fusion_pair *) a)->count;
+  double count_b = ((const cg_fusion_pair *) b)->count;
+  if (count_a > count_b) return -1;
+  if (count_a < count_b) return 1;
+  return 0;
+}
+
+int cgReadPairProfile(char *filename)
+{
+  char line[256];
+  FILE *F = fopen(filename, "r");
+  if (F == NULL) return 0;
+  while (fgets(line, sizeof(line), F) != NULL && cg_fusion_candidate_count < CG_FUSION_CANDIDATES_MAX)
+  {
+    cg_fusion_pair *pair = &cg_fusion_candidates[cg_fusion_candidate_count];
+    if (sscanf(line, "%x\t%x\t%lf", &pair->first_opcode, &pair->second_opcode, &pair->count) == 3
+        && pair->first_opcode < 65536 && pair->second_opcode < 65536)
+    {
+      cg_fusion_candidate_count++;
+    }
+  }
+  fclose(F);
+  return 1;
+}
+
+/* The second instruction of a pair runs right after the first, before any */
+/* bus event that is due in between. Only second instructions that work on */
+/* registers and the instruction stream are fused, they can not see or     */
+/* change chip state at the wrong cycle.                                   */
+
+int cgFusionEaIsRegisterOrImmediate(unsigned int opcode, int allow_address_register)
+{
+  unsigned int mode = (opcode >> 3) & 7;
+  unsigned int reg = opcode & 7;
+  return mode == 0 || (mode == 1 && allow_address_register) || (mode == 7 && reg == 4);
+}
+
+int cgFusionSecondMakesNoBusAccess(unsigned int opcode)
+{
+  unsigned int size = (opcode >> 6) & 3;
+  unsigned int mode = (opcode >> 3) & 7;
+  unsigned int opmode = (opcode >> 6) & 7;
+
+  switch (opcode >> 12)
+  {
+    case 0x0:
+      // ORI, ANDI and EORI to CCR, not to SR
+      if (opcode == 0x003c || opcode == 0x023c || opcode == 0x0a3c) return 1;
+      // BTST, BCHG, BCLR and BSET on Dn, not MOVEP
+      if ((opcode & 0x0100) || (opcode & 0x0e00) == 0x0800) return mode == 0;
+      // MOVES
+      if ((opcode & 0x0e00) == 0x0e00) return 0;
+      // ORI, ANDI, SUBI, ADDI, EORI and CMPI on Dn
+      return size != 3 && mode == 0;
+    case 0x1:
+    case 0x2:
+    case 0x3:
+      // MOVE and MOVEA from a register or an immediate to a register
+      return cgFusionEaIsRegisterOrImmediate(opcode, 1) && opmode <= 1;
+    case 0x4:
+      if (opcode == 0x4e71) return 1;
+      // LEA only calculates the address
+      if ((opcode & 0xf1c0) == 0x41c0) return mode >= 2 && !(mode == 7 && (opcode & 7) == 4);
+      // SWAP, EXT and EXTB
+      if ((opcode & 0xfff8) == 0x4840 || (opcode & 0xfeb8) == 0x4880) return 1;
+      // NEGX, CLR, NEG, NOT and TST on Dn, not the SR and CCR moves or TAS
+      if ((opcode & 0xf900) == 0x4000 || (opcode & 0xff00) == 0x4a00) return size != 3 && mode == 0;
+      return 0;
+    case 0x5:
+      // Scc on Dn and DBcc, ADDQ and SUBQ on a register
+      if (size == 3) return mode == 0 || mode == 1;
+      return mode == 0 || (mode == 1 && size != 0);
+    case 0x6:
+      // Bcc and BRA, BSR writes to the stack
+      return (opcode & 0x0f00) != 0x0100;
+    case 0x7:
+      return (opcode & 0x0100) == 0;
+    case 0x8:
+    case 0xc:
+      // EXG
+      if ((opcode & 0xf1f8) == 0xc140 || (opcode & 0xf1f8) == 0xc148 || (opcode & 0xf1f8) == 0xc188) return 1;
+      // MULU and MULS, DIVU and DIVS can take an exception
+      if (opmode == 3 || opmode == 7) return (opcode & 0xf000) == 0xc000 && cgFusionEaIsRegisterOrImmediate(opcode, 0);
+      // ABCD, SBCD, PACK and UNPK on Dn
+      if (opmode >= 4) return mode == 0;
+      // OR and AND to Dn
+      return cgFusionEaIsRegisterOrImmediate(opcode, 0);
+    case 0x9:
+    case 0xb:
+    case 0xd:
+      // SUBA, CMPA and ADDA
+      if (opmode == 3 || opmode == 7) return cgFusionEaIsRegisterOrImmediate(opcode, 1);
+      // SUBX, ADDX and EOR on Dn, not CMPM
+      if (opmode >= 4) return mode == 0;
+      // SUB, CMP and ADD to Dn
+      return cgFusionEaIsRegisterOrImmediate(opcode, 1);
+    case 0xe:
+      // Shifts and rotates of a register
+      return size != 3;
+  }
+  return 0;
+}
+
+/* Pick the most frequent pairs, at most one pair for each first opcode */
+
+void cgFusionSelectPairs()
+{
+  int i, j;
+  qsort(cg_fusion_candidates, cg_fusion_candidate_count, sizeof(cg_fusion_pair), cgFusionCompare);
+  for (i = 0; i < cg_fusion_candidate_count && cg_fusion_count < CG_FUSION_MAX; ++i)
+  {
+    cg_fusion_pair *pair = &cg_fusion_candidates[i];
+    int taken = 0;
+    if (strcmp(cpu_opcode_data[pair->first_opcode].name, "cpuIllegalInstruction") == 0) continue;
+    if (strcmp(cpu_opcode_data[pair->second_opcode].name, "cpuIllegalInstruction") == 0) continue;
+    if (!cgFusionSecondMakesNoBusAccess(pair->second_opcode)) continue;
+    for (j = 0; j < cg_fusion_count; ++j)
+      if (cg_fusion_pairs[j].first_opcode == pair->first_opcode)
+	taken = 1;
+    if (!taken) cg_fusion_pairs[cg_fusion_count++] = *pair;
+  }
+  printf("Fused %d instruction pairs.\n", cg_fusion_count);
+}
+
+void cgFusionMakeFunctionName(char *fname, cg_fusion_pair *pair)
+{
+  sprintf(fname, "FUSED_%.4X_%.4X", pair->first_opcode, pair->second_opcode);
+}
+
+/* The second handler only runs when its opcode is next in the instruction stream */
+
+void cgFusionFunctions()
+{
+  int i;
+  char fname[64];
+  if (cg_fusion_count == 0) return;
+  fprintf(declf, "#ifdef CPU_INSTRUCTION_FUSION\n");
+  fprintf(codef, "#ifdef CPU_INSTRUCTION_FUSION\n");
+  for (i = 0; i < cg_fusion_count; ++i)
+  {
+    cg_fusion_pair *pair = &cg_fusion_pairs[i];
+    cgFusionMakeFunctionName(fname, pair);
+    fprintf(declf, "static void %s(ULO*opc_data);\n", fname);
+    fprintf(codef, "static void %s(ULO*opc_data)\n", fname);
+    fprintf(codef, "{\n");
+    fprintf(codef, "\t%s(opc_data);\n", cpu_opcode_data[pair->first_opcode].name);
+    fprintf(codef, "\tif (cpuFusionBegin(0x%.4X))\n", pair->second_opcode);
+    fprintf(codef, "\t{\n");
+    fprintf(codef, "\t\t%s(cpu_opcode_data[0x%.4X].data);\n", cpu_opcode_data[pair->second_opcode].name, pair->second_opcode);
+    fprintf(codef, "\t\tcpuFusionEnd();\n");
+    fprintf(codef, "\t}\n");
+    fprintf(codef, "}\n");
+  }
+  fprintf(declf, "#endif\n");
+  fprintf(codef, "#endif\n");
+}
+
+void cgFusionData()
+{
+  int i;
+  char fname[64];
+  fprintf(dataf, "#ifdef CPU_INSTRUCTION_FUSION\n");
+  fprintf(dataf, "typedef struct cpu_fusion_data_struct\n{\n");
+  fprintf(dataf, "\tUWO first_opcode;\n");
+  fprintf(dataf, "\tUWO second_opcode;\n");
+  fprintf(dataf, "\tcpuInstructionFunction instruction_func;\n} cpuFusionData;\n\n");
+  fprintf(dataf, "cpuFusionData cpu_fusion_data[%d] = {\n", cg_fusion_count + 1);
+  for (i = 0; i < cg_fusion_count; ++i)
+  {
+    cgFusionMakeFunctionName(fname, &cg_fusion_pairs[i]);
+    fprintf(dataf, "{0x%.4X,0x%.4X,%s},\n", cg_fusion_pairs[i].first_opcode, cg_fusion_pairs[i].second_opcode, fname);
+  }
+  fprintf(dataf, "{0x0000,0x0000,NULL}\n");
+  fprintf(dataf, "};\n");
+  fprintf(dataf, "#endif\n\n");
+}
+
+/*============================*/
+/* Opcode histogram functions */
+/*============================*/
+
+/* The opcode histogram is the cpuopcodes.txt written by an emulator built */
+/* with CPU_OPCODE_HISTOGRAM, one "opcode count cycles" line per opcode.   */
+/* The emulator only knows the handlers by address, here they get their    */
+/* names in cpuhandlers.txt, the most executed first.                      */
+
+int cgReadOpcodeHistogram(char *filename)
+{
+  char line[256];
+  FILE *F = fopen(filename, "r");
+  if (F == NULL) return 0;
+  while (fgets(line, sizeof(line), F) != NULL)
+  {
+    unsigned int opcode;
+    double count, cycles;
+    if (sscanf(line, "%x\t%lf\t%lf", &opcode, &count, &cycles) == 3 && opcode < 65536)
+    {
+      cg_opcode_count[opcode] = count;
+      cg_opcode_cycles[opcode] = cycles;
+    }
+  }
+  fclose(F);
+  return 1;
+}
+
+int cgHandlerCompare(const void *a, const void *b)
+{
+  double count_a = ((const cg_handler_total *) a)->count;
+  double count_b = ((const cg_handler_total *) b)->count;
+  if (count_a > count_b) return -1;
+  if (count_a < count_b) return 1;
+  return 0;
+}
+
+void cgHandlerReport(char *filename)
+{
+  unsigned int opcode;
+  int i;
+  FILE *F;
+  for (opcode = 0; opcode < 65536; opcode++)
+  {
+    if (cg_opcode_count[opcode] == 0) continue;
+    for (i = 0; i < cg_handler_count; ++i)
+      if (strcmp(cg_handler_totals[i].name, cpu_opcode_data[opcode].name) == 0)
+	break;
+    if (i == cg_handler_count)
+    {
+      if (cg_handler_count == CG_HANDLERS_MAX) continue;
+      strcpy(cg_handler_totals[i].name, cpu_opcode_data[opcode].name);
+      cg_handler_count++;
+    }
+    cg_handler_totals[i].opcodes++;
+    cg_handler_totals[i].count += cg_opcode_count[opcode];
+    cg_handler_totals[i].cycles += cg_opcode_cycles[opcode];
+  }
+  qsort(cg_handler_totals, cg_handler_count, sizeof(cg_handler_total), cgHandlerCompare);
+
+  F = fopen(filename, "w");
+  if (F == NULL)
+  {
+    printf("68kgenerate: Could not write %s\n", filename);
+    return;
+  }
+  fprintf(F, "NAME\tOPCODES\tCOUNT\tCYCLES\tCYCLES_PER_CALL\n");
+  for (i = 0; i < cg_handler_count; ++i)
+  {
+    cg_handler_total *handler = &cg_handler_totals[i];
+    fprintf(F, "%s\t%d\t%.0f\t%.0f\t%.2f\n", handler->name, handler->opcodes, handler->count, handler->cycles, handler->cycles / handler->count);
+  }
+  fclose(F);
+  printf("Wrote %d executed handlers to %s.\n", cg_handler_count, filename);
+}
+
 /*=======================*/
 /* Disassembly functions */
 /*=======================*/
@@ -339,6 +637,21 @@ char *cgMemoryStore(unsigned int size)
   return "ERROR_cgMemoryStore()";
 }
 
+// abs.L operands are how code reaches the custom chip registers, those get a direct dispatch
+char *cgMemoryFetchEa(unsigned int size, unsigned int eano)
+{
+  if (eano == 8 && size == 2) return "memoryReadWordAbsolute";
+  else if (eano == 8 && size == 4) return "memoryReadLongAbsolute";
+  return cgMemoryFetch(size);
+}
+
+char *cgMemoryStoreEa(unsigned int size, unsigned int eano)
+{
+  if (eano == 8 && size == 2) return "memoryWriteWordAbsolute";
+  else if (eano == 8 && size == 4) return "memoryWriteLongAbsolute";
+  return cgMemoryStore(size);
+}
+
 char *cgCalculateEA(unsigned int eano)
 {
   if (eano == 2) return "cpuEA02";
@@ -424,7 +737,7 @@ void cgFetchSrc(unsigned int eano, unsigned int eareg_cpu_data_index, unsigned i
   else if (eano >= 7 && eano < 11)
   {
     // Read source value from memory.
-    fprintf(codef, "%s(%s());\n", cgMemoryFetch(size), cgCalculateEA(eano));
+    fprintf(codef, "%s(%s());\n", cgMemoryFetchEa(size, eano), cgCalculateEA(eano));
   }
   else
   {
@@ -476,7 +789,7 @@ void cgFetchDst(unsigned int eano, unsigned int eareg_cpu_data_index, unsigned i
   }
   else if (eano >= 2 && eano < 11)
   {
-    fprintf(codef, "%s(dstea);\n", cgMemoryFetch(size));
+    fprintf(codef, "%s(dstea);\n", cgMemoryFetchEa(size, eano));
   }
   else
   {
@@ -505,7 +818,7 @@ void cgStoreDst(unsigned int eano, unsigned int eareg_cpu_data_index, unsigned i
   }
   else if (eano >= 2 && eano < 9)
   {
-    fprintf(codef, "\t%s(%s, dstea);\n", cgMemoryStore(size), dstname);
+    fprintf(codef, "\t%s(%s, dstea);\n", cgMemoryStoreEa(size, eano), dstname);
   }
   else
   {
@@ -762,7 +1075,7 @@ unsigned int cgAdd(cpu_data *cpudata, cpu_instruction_info i)
   {
     // operations on CCR/SR
     unsigned int opcode = base_opcode;
-    char fname[32];
+    char fname[64];
     icount++;
     cgMakeFunctionName(fname, i.instruction_name, opcode);
     cgDeclareFunction(fname);
@@ -783,7 +1096,7 @@ unsigned int cgAdd(cpu_data *cpudata, cpu_instruction_info i)
       if (i.eamask[eano] == '1')
       {
 	unsigned int opcode = base_opcode | cgEAReg(eano, 0);
-	char fname[32];
+	char fname[64];
 	icount++;
 	cgMakeFunctionName(fname, i.instruction_name, opcode);
 	cgDeclareFunction(fname);
@@ -1029,7 +1342,6 @@ unsigned int cgMove(cpu_data *cpudata, cpu_instruction_info i)
   unsigned int base_opcode = strtoul(i.opcode, &endchar, 0);
   unsigned int srcreg_cpu_data_index = 0;
   unsigned int dstreg_cpu_data_index = 1;
-  unsigned int time_cpu_data_index = 2;
   unsigned int size = atoi(i.size);
   int srceano, srceareg, dsteano, dsteareg;
   unsigned int icount = 0;
@@ -1045,7 +1357,7 @@ unsigned int cgMove(cpu_data *cpudata, cpu_instruction_info i)
 	if (i.eamask[srceano] == '1')
 	{
 	  unsigned int opcode = base_opcode | cgEAReg2(dsteano, 0) |cgEAReg(srceano, 0);
-	  char fname[32];
+	  char fname[64];
 	  icount++;
 	  cgMakeFunctionName(fname, i.instruction_name, opcode);
 	  cgDeclareFunction(fname);
@@ -1123,7 +1435,7 @@ unsigned int cgClr(cpu_data *cpudata, cpu_instruction_info i)
     if (i.eamask[eano] == '1')
     {
       unsigned int opcode = base_opcode | cgEAReg(eano, 0);
-      char fname[32];
+      char fname[64];
       icount++;
 
       cgMakeFunctionName(fname, i.instruction_name, opcode);
@@ -1351,7 +1663,7 @@ unsigned int cgMoveQ(cpu_data *cpudata, cpu_instruction_info i)
   int reg;
   unsigned int icount = 0, imm;
 
-  char fname[32];
+  char fname[64];
   cgMakeFunctionName(fname, i.instruction_name, base_opcode);
   cgDeclareFunction(fname);
   cgMakeFunctionHeader(fname, templ_name);
@@ -1394,7 +1706,7 @@ unsigned int cgAddx(cpu_data *cpudata, cpu_instruction_info i)
   unsigned int icount = 0;
   unsigned int size = atoi(i.size);
 
-  char fname[32];
+  char fname[64];
   cgMakeFunctionName(fname, i.instruction_name, base_opcode);
   cgDeclareFunction(fname);
   cgMakeFunctionHeader(fname, templ_name);
@@ -1437,12 +1749,11 @@ unsigned int cgMovep(cpu_data *cpudata, cpu_instruction_info i)
   unsigned int base_opcode = strtoul(i.opcode, &endchar, 0);
   unsigned int regx_cpu_data_index = 0;
   unsigned int regy_cpu_data_index = 1;
-  char regtype = i.reg[0];
   unsigned int regx;
   unsigned int regy;
   unsigned int icount = 0;
 
-  char fname[32];
+  char fname[64];
   cgMakeFunctionName(fname, i.instruction_name, base_opcode);
   cgDeclareFunction(fname);
   cgMakeFunctionHeader(fname, templ_name);
@@ -1481,7 +1792,6 @@ unsigned int cgBCC(cpu_data *cpudata, cpu_instruction_info i)
   char *templ_name = "bcc";
   char *endchar;
   unsigned int base_opcode = strtoul(i.opcode, &endchar, 0);
-  unsigned int cc_cpu_data_index = 0;
   unsigned int vector_cpu_data_index = 0;
   unsigned int offset_cpu_data_index = 1;
   unsigned int reg_cpu_data_index = 1;
@@ -1490,7 +1800,7 @@ unsigned int cgBCC(cpu_data *cpudata, cpu_instruction_info i)
   unsigned int icount = 0;
   unsigned int size = atoi(i.size);
   unsigned int offset;
-  char fname[32];
+  char fname[64];
 
   cgMakeFunctionName(fname, i.instruction_name, base_opcode);
   cgDeclareFunction(fname);
@@ -1701,7 +2011,7 @@ unsigned int cgShift(cpu_data *cpudata, cpu_instruction_info i)
   int eano, eareg, reg;
   unsigned int icount = 0;
   char regtype = i.reg[0];
-  char fname[32];
+  char fname[64];
 
   // For each EA in i.eamask
   for (eano = 0; eano < 12; ++eano)
@@ -1918,21 +2228,34 @@ int cgReadControlFile(char *filename)
   return 1;
 }
 
-int cgMain(char *definition_file, char *include_path)
+int cgMain(char *definition_file, char *include_path, char *pair_profile_file, char *opcode_histogram_file)
 {
-  sprintf(cpucode_path, "%s\\CpuModule_Code.h", include_path);
-  sprintf(cpudata_path, "%s\\CpuModule_Data.h", include_path);
-  sprintf(cpudecl_path, "%s\\CpuModule_Decl.h", include_path);
-  sprintf(cpuprofile_path, "%s\\CpuModule_Profile.h", include_path);
-  sprintf(cpudisfunc_path, "%s\\CpuModule_DisassemblerFunc.h", include_path);
+  sprintf(cpucode_path, "%s/CpuModule_Code.h", include_path);
+  sprintf(cpudata_path, "%s/CpuModule_Data.h", include_path);
+  sprintf(cpudecl_path, "%s/CpuModule_Decl.h", include_path);
+  sprintf(cpuprofile_path, "%s/CpuModule_Profile.h", include_path);
+  sprintf(cpudisfunc_path, "%s/CpuModule_DisassemblerFunc.h", include_path);
 
   if (!cgReadControlFile(definition_file)) return 0;
+  if (pair_profile_file != NULL && !cgReadPairProfile(pair_profile_file))
+  {
+    printf("68kgenerate: Could not read pair profile %s\n", pair_profile_file);
+  }
+  if (opcode_histogram_file != NULL && !cgReadOpcodeHistogram(opcode_histogram_file))
+  {
+    printf("68kgenerate: Could not read opcode histogram %s\n", opcode_histogram_file);
+    opcode_histogram_file = NULL;
+  }
   if (!cgOpenFiles()) return 0;
 
   cgClearCpuData();
 
   cgInstructions();
+  if (opcode_histogram_file != NULL) cgHandlerReport("cpuhandlers.txt");
+  cgFusionSelectPairs();
+  cgFusionFunctions();
   cgData();
+  cgFusionData();
   cgDisFunc();
 
   cgProfileLogHeader();
@@ -1945,15 +2268,19 @@ int cgMain(char *definition_file, char *include_path)
 }
 
 
-void main(int argc, char **argv)
+int main(int argc, char **argv)
 {
-  if (argc != 3)
+  char *pair_profile_file = NULL;
+  if (argc < 3 || argc > 5)
   {
-    printf("Usage:\n68kgenerate <definition file> <code destination path>\n\n");
-    return;
+    printf("Usage:\n68kgenerate <definition file> <code destination path> [pair profile|-] [opcode histogram]\n\n");
+    return 1;
   }
-  if (!cgMain(argv[1], argv[2]))
+  if (argc >= 4 && strcmp(argv[3], "-") != 0) pair_profile_file = argv[3];
+  if (!cgMain(argv[1], argv[2], pair_profile_file, (argc == 5) ? argv[4] : NULL))
   {
     printf("68kgenerate: Invalid path\n");
+    return 1;
   }
+  return 0;
 }
@@ -0,0 +1,201 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* Bus event queue                                                         */
+/*                                                                         */
+/* The queue is a list sorted by cycle, events with equal cycle are kept   */
+/* in the order they were inserted. An event is queued when it is at the  */
+/* head of the list or has a prev pointer, so removing an event that is    */
+/* not queued is O(1). At most seven events are ever queued, and a trace   */
+/* of the busreplay benchmark ran faster through this list than through a  */
+/* binary heap.                                                            */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include "defs.h"
+#include "fellow.h"
+#include "bus.h"
+
+#ifdef BUS_EVENT_TRACE
+#include "fileops.h"
+#endif
+
+static BOOLE busEventIsQueued(bus_event *ev)
+{
+  return ev->prev != NULL || bus.events == ev;
+}
+
+void busClearQueue(void)
+{
+  bus_event *next;
+  for (bus_event *tmp = bus.events; tmp != NULL; tmp = next)
+  {
+    next = tmp->next;
+    tmp->prev = tmp->next = NULL;
+  }
+  bus.events = NULL;
+  bus.queue_order = 0;
+}
+
+void busRemoveEvent(bus_event *ev)
+{
+  if (!busEventIsQueued(ev))
+  {
+    return;
+  }
+
+#ifdef BUS_EVENT_TRACE
+  busEventTraceAdd(BUS_EVENT_TRACE_REMOVE, ev);
+#endif
+  if (ev->prev == NULL)
+  {
+    bus.events = ev->next;
+  }
+  else
+  {
+    ev->prev->next = ev->next;
+  }
+  if (ev->next != NULL) ev->next->prev = ev->prev;
+  ev->prev = ev->next = NULL;
+}
+
+void busInsertEvent(bus_event *ev)
+{
+  bus_event *tmp;
+  bus_event *tmp_prev = NULL;
+
+  busRemoveEvent(ev);
+#ifdef BUS_EVENT_TRACE
+  busEventTraceAdd(BUS_EVENT_TRACE_INSERT, ev);
+#endif
+  bus.queue_order++;
+  for (tmp = bus.events; tmp != NULL; tmp = tmp->next)
+  {
+    if (ev->cycle < tmp->cycle)
+    {
+      ev->next = tmp;
+      ev->prev = tmp_prev;
+      tmp->prev = ev;
+      if (tmp_prev == NULL) bus.events = ev; /* In front */
+      else tmp_prev->next = ev;
+      return;
+    }
+    tmp_prev = tmp;
+  }
+  if (tmp_prev == NULL) bus.events = ev;
+  else tmp_prev->next = ev; /* At end */
+  ev->prev = tmp_prev;
+  ev->next = NULL;
+}
+
+bus_event *busPopEvent(void)
+{
+  bus_event *tmp = bus.events;
+#ifdef BUS_EVENT_TRACE
+  busEventTraceAdd(BUS_EVENT_TRACE_POP, tmp);
+#endif
+  bus.events = tmp->next;
+  if (bus.events != NULL) bus.events->prev = NULL;
+  tmp->next = NULL;
+  return tmp;
+}
+
+/*============================================================================*/
+/* Event queue trace (BUS_EVENT_TRACE)                                        */
+/*============================================================================*/
+
+#ifdef BUS_EVENT_TRACE
+
+/* The trace is kept in a buffer and written to file when it is full, */
+/* at the end of every frame and when emulation stops. */
+
+#define BUS_EVENT_TRACE_BUFFER_SIZE 16384
+
+static FILE *bus_event_trace_file;
+static BOOLE bus_event_trace_first = TRUE;
+static bus_event_trace_record bus_event_trace_buffer[BUS_EVENT_TRACE_BUFFER_SIZE];
+static ULO bus_event_trace_count;
+
+static bus_event *busEventTraceGetEvent(ULO index)
+{
+  switch (index)
+  {
+    case BUS_EVENT_TRACE_CPU: return &cpuEvent;
+    case BUS_EVENT_TRACE_COPPER: return &copperEvent;
+    case BUS_EVENT_TRACE_EOL: return &eolEvent;
+    case BUS_EVENT_TRACE_EOF: return &eofEvent;
+    case BUS_EVENT_TRACE_CIA: return &ciaEvent;
+    case BUS_EVENT_TRACE_BLITTER: return &blitterEvent;
+    case BUS_EVENT_TRACE_INTERRUPT: return &interruptEvent;
+  }
+  return NULL;
+}
+
+static ULO busEventTraceGetIndex(bus_event *ev)
+{
+  for (ULO i = BUS_EVENT_TRACE_CPU; i <= BUS_EVENT_TRACE_INTERRUPT; i++)
+  {
+    if (busEventTraceGetEvent(i) == ev) return i;
+  }
+  return 0;
+}
+
+static void busEventTraceWriteULO(ULO data)
+{
+  fwrite(&data, sizeof(data), 1, bus_event_trace_file);
+}
+
+void busEventTraceFlush(void)
+{
+  if (bus_event_trace_file == NULL) return;
+  fwrite(bus_event_trace_buffer, sizeof(bus_event_trace_record), bus_event_trace_count, bus_event_trace_file);
+  bus_event_trace_count = 0;
+  fflush(bus_event_trace_file);
+}
+
+void busEventTraceClose(void)
+{
+  if (bus_event_trace_file == NULL) return;
+  busEventTraceFlush();
+  fclose(bus_event_trace_file);
+  bus_event_trace_file = NULL;
+}
+
+/* The file is truncated by the first session that is traced, later sessions append to it. */
+/* Every session starts with the events already queued, inserted in the order they have.  */
+static BOOLE busEventTraceOpen(void)
+{
+  char filename[MAX_PATH];
+
+  fileopsGetGenericFileName(filename, "WinFellow", "busevents.trc");
+  bus_event_trace_file = fopen(filename, (bus_event_trace_first) ? "wb" : "ab");
+  if (bus_event_trace_file == NULL) return FALSE;
+  if (bus_event_trace_first)
+  {
+    bus_event_trace_first = FALSE;
+    busEventTraceWriteULO(BUS_EVENT_TRACE_MAGIC);
+    busEventTraceWriteULO(BUS_EVENT_TRACE_VERSION);
+  }
+  busEventTraceAdd(BUS_EVENT_TRACE_SESSION, NULL);
+  for (bus_event *tmp = bus.events; tmp != NULL; tmp = tmp->next)
+  {
+    busEventTraceAdd(BUS_EVENT_TRACE_INSERT, tmp);
+  }
+  return TRUE;
+}
+
+void busEventTraceAdd(ULO operation, bus_event *ev)
+{
+  bus_event_trace_record *record;
+
+  if (bus_event_trace_file == NULL && !busEventTraceOpen()) return;
+
+  record = &bus_event_trace_buffer[bus_event_trace_count];
+  record->operation = operation;
+  record->event = busEventTraceGetIndex(ev);
+  record->cycle = (ev != NULL) ? ev->cycle : 0;
+  if (++bus_event_trace_count == BUS_EVENT_TRACE_BUFFER_SIZE) busEventTraceFlush();
+}
+
+#endif
@@ -122,22 +122,22 @@ void CopperRegisters::ClearState()
   copper_dma = false;
 }
 
-void CopperRegisters::LoadState(FILE *F)
+void CopperRegisters::LoadState(savestate *S)
 {
-  fread(&copcon, sizeof(copcon), 1, F);
-  fread(&cop1lc, sizeof(cop1lc), 1, F);
-  fread(&cop2lc, sizeof(cop2lc), 1, F);
-  fread(&copper_pc, sizeof(copper_pc), 1, F);
-  fread(&copper_dma, sizeof(copper_dma), 1, F);
-  fread(&copper_suspended_wait, sizeof(copper_suspended_wait), 1, F);
+  savestateReadValue(S, copcon);
+  savestateReadValue(S, cop1lc);
+  savestateReadValue(S, cop2lc);
+  savestateReadValue(S, copper_pc);
+  savestateReadValue(S, copper_dma);
+  savestateReadValue(S, copper_suspended_wait);
 }
 
-void CopperRegisters::SaveState(FILE *F)
+void CopperRegisters::SaveState(savestate *S)
 {
-  fwrite(&copcon, sizeof(copcon), 1, F);
-  fwrite(&cop1lc, sizeof(cop1lc), 1, F);
-  fwrite(&cop2lc, sizeof(cop2lc), 1, F);
-  fwrite(&copper_pc, sizeof(copper_pc), 1, F);
-  fwrite(&copper_dma, sizeof(copper_dma), 1, F);
-  fwrite(&copper_suspended_wait, sizeof(copper_suspended_wait), 1, F);
+  savestateWriteValue(S, copcon);
+  savestateWriteValue(S, cop1lc);
+  savestateWriteValue(S, cop2lc);
+  savestateWriteValue(S, copper_pc);
+  savestateWriteValue(S, copper_dma);
+  savestateWriteValue(S, copper_suspended_wait);
 }
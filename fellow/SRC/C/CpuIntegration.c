@@ -32,6 +32,7 @@
 #include "bus.h"
 #include "fileops.h"
 #include "interrupt.h"
+#include "profiler.h"
 
 jmp_buf cpu_integration_exception_buffer;
 ULO cpu_integration_chip_interrupt_number;
@@ -261,10 +262,30 @@ void cpuIntegrationInterruptLogging(ULO level, ULO vector_address)
 
 #endif
 
+/*============================================================================*/
+/* Runs one instruction, timed by the profiler for its opcode group when it   */
+/* is turned on. A plain start and add instead of a scope object, exceptions  */
+/* leave the instruction by longjmp.                                          */
+/*============================================================================*/
+
+static ULO cpuIntegrationExecuteInstruction(void)
+{
+  if (!profilerGetEnabled())
+  {
+    return cpuExecuteInstruction();
+  }
+
+  PROFILER_COUNTER counter = (cpuGetRaiseInterrupt()) ? PROFILER_CPU_INTERRUPT : PROFILER_CPU_COUNTER(cpuGetPrefetchWord());
+  ULL start = profilerGetTicks();
+  ULO cycles = cpuExecuteInstruction();
+  profilerAdd(counter, start, cycles);
+  return cycles;
+}
+
 void cpuIntegrationExecuteInstructionEventHandler68000Fast(void)
 {
   ULO cycles;
-  cycles = cpuExecuteInstruction();
+  cycles = cpuIntegrationExecuteInstruction();
 
   if (cpuGetStop())
   {
@@ -277,6 +298,25 @@ void cpuIntegrationExecuteInstructionEventHandler68000Fast(void)
   cpuIntegrationSetChipCycles(0);
 }
 
+/*============================================================================*/
+/* Runs 68000 instructions back to back while the CPU is the next event.      */
+/* deadline is the cycle of the first pending bus event. The loop ends as     */
+/* soon as the CPU passes it, or when something may have moved it: an event   */
+/* was inserted (by a chip or CIA register write), an interrupt was raised,   */
+/* or the CPU stopped.                                                        */
+/*============================================================================*/
+
+void cpuIntegrationExecuteInstructionsUntil68000Fast(ULO deadline)
+{
+  ULL queue_order = bus.queue_order;
+
+  do
+  {
+    busSetCycle(cpuEvent.cycle);
+    cpuIntegrationExecuteInstructionEventHandler68000Fast();
+  } while (cpuEvent.cycle <= deadline && bus.queue_order == queue_order && !cpuGetRaiseInterrupt());
+}
+
 void cpuIntegrationExecuteInstructionEventHandler68000General(void)
 {
   ULO cycles = 0;
@@ -284,7 +324,7 @@ void cpuIntegrationExecuteInstructionEventHandler68000General(void)
 
   do
   {
-    cycles = cpuExecuteInstruction();
+    cycles = cpuIntegrationExecuteInstruction();
     cycles = cycles*cpuIntegrationGetChipSlowdown(); // Compensate for blitter time
     time_used += (cpuIntegrationGetChipCycles()<<12) + (cycles<<cpuIntegrationGetSpeedMultiplier());
   }
@@ -306,7 +346,7 @@ void cpuIntegrationExecuteInstructionEventHandler68020(void)
   ULO time_used = 0;
   do
   {
-    cpuExecuteInstruction();
+    cpuIntegrationExecuteInstruction();
     time_used += (cpuIntegrationGetChipCycles()<<12) + (4<<cpuIntegrationGetSpeedMultiplier());
   }
   while (time_used < 8192 && !cpuGetStop());
@@ -344,19 +384,27 @@ void cpuIntegrationSetDefaultConfig(void)
 /* Fellow lifecycle events */
 /*=========================*/
 
-void cpuIntegrationSaveState(FILE *F)
+void cpuIntegrationSaveState(savestate *S)
 {
-  cpuSaveState(F);
+  savestateChunkBegin(S, SAVESTATE_CPU, SAVESTATE_CPU_VERSION);
+  cpuSaveState(S);
 
-  fwrite(&cpu_integration_chip_slowdown, sizeof(cpu_integration_chip_slowdown), 1, F);
+  savestateWriteValue(S, cpu_integration_chip_slowdown);
   // Everything else is configuration options which will be set when the associated config-file is loaded.
+  savestateChunkEnd(S);
 }
 
-void cpuIntegrationLoadState(FILE *F)
+void cpuIntegrationLoadState(savestate *S)
 {
-  cpuLoadState(F);
+  // Version 1 did not save D7, A7 and the stopped and interrupt state
+  if (savestateGetChunkVersion(S) < 2)
+  {
+    savestateFail(S, "The CPU state in the state file is incomplete");
+    return;
+  }
+  cpuLoadState(S);
 
-  fread(&cpu_integration_chip_slowdown, sizeof(cpu_integration_chip_slowdown), 1, F);
+  savestateReadValue(S, cpu_integration_chip_slowdown);
   // Everything else is configuration options which will be set when the associated config-file is loaded.
 }
 
@@ -388,4 +436,10 @@ void cpuIntegrationStartup(void)
 void cpuIntegrationShutdown(void)
 {
   cpuProfileWrite();
+#ifdef CPU_INSTRUCTION_PAIR_PROFILE
+  cpuPairProfileWrite();
+#endif
+#ifdef CPU_OPCODE_HISTOGRAM
+  cpuOpcodeHistogramWrite();
+#endif
 }
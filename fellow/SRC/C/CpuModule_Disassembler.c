@@ -105,7 +105,7 @@ static STR cpuDisSizeChar(ULO size)
   return (STR) ((size == 8) ? 'B' : ((size == 16) ? 'W' : 'L'));
 }
 
-static STR *cpu_dis_btab[16] = {"RA", "SR", "HI", "LS", "CC", "CS", "NE", "EQ", "VC", "VS",
+static const STR *cpu_dis_btab[16] = {"RA", "SR", "HI", "LS", "CC", "CS", "NE", "EQ", "VC", "VS",
 "PL", "MI", "GE", "LT", "GT", "LE"};
 
 static ULO cpuDisGetBranchType(UWO opc)
@@ -155,7 +155,7 @@ static ULO cpuDis05(ULO regno, ULO pcp, STR *sdata, STR *soperands)
 
 static ULO cpuDis06Brief(ULO regno, ULO pcp, ULO ext, BOOLE is_pc_indirect, STR *sdata, STR *soperands)
 {
-  STR *scale[4] = {"", "*2", "*4", "*8"};
+  const STR *scale[4] = {"", "*2", "*4", "*8"};
   STR indexregtype = (STR) ((ext & 0x8000) ? 'A' : 'D');
   STR indexsize = (STR) ((ext & 0x0800) ? 'L' : 'W');
   ULO indexregno = (ext >> 12) & 7;
@@ -211,7 +211,7 @@ static ULO cpuDis06Od(ULO pcp, BOOLE wordsize, STR *sdata, STR *soperands)
 
 static ULO cpuDis06Extended(ULO regno, ULO pcp, ULO ext, BOOLE is_pc_indirect, STR *sdata, STR *soperands)
 {
-  STR *scale[4] = {"", "*2", "*4", "*8"};
+  const STR *scale[4] = {"", "*2", "*4", "*8"};
   STR indexregtype = (STR) ((ext & 0x8000) ? 'A' : 'D');
   STR indexsize = (STR)((ext & 0x0800) ? 'L' : 'W');
   ULO indexregno = (ext >> 12) & 7;
@@ -465,7 +465,7 @@ static ULO cpuDisAdrMode(ULO eamode, ULO earegno, ULO pcp, ULO size, STR *sdata,
 /* Common disassembly for BCHG, BCLR, BSET, BTST */
 
 static ULO cpu_dis_btX_trans[4] = {3, 0, 1, 2};
-static STR *cpu_dis_bnr[4] = {"CHG","CLR","SET","TST"};
+static const STR *cpu_dis_bnr[4] = {"CHG","CLR","SET","TST"};
 
 static ULO cpuDisBtX(ULO prc, UWO opc, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -492,7 +492,7 @@ static ULO cpuDisBtX(ULO prc, UWO opc, STR *sdata, STR *sinstruction, STR *soper
 
 /* Common disassembly for ADD, SUB, CMP, AND, EOR, OR */
 
-static STR *cpu_dis_anr[6] = {"ADD","SUB","CMP","AND","EOR","OR"};
+static const STR *cpu_dis_anr[6] = {"ADD","SUB","CMP","AND","EOR","OR"};
 
 static ULO cpuDisArith1(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -566,13 +566,13 @@ static ULO cpuDisArith4(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction,
 
 /* Common disassembly for ADDX, SUBX, ABCD, SBCD, CMPM */
 
-static STR *cpu_dis_a5nr[5] = {"ADDX","SUBX","ABCD","SBCD","CMPM"};
+static const STR *cpu_dis_a5nr[5] = {"ADDX","SUBX","ABCD","SBCD","CMPM"};
 
 static ULO cpuDisArith5(ULO prc, UWO opc, ULO nr, STR *sinstruction, STR *soperands)
 {
   ULO bit3 = cpuDisGetBit(opc, 3);
-  STR *minus = ((nr == 4) || !bit3) ? "" : "-";
-  STR *plus = ((nr == 4) && !bit3) ? "+" : "";
+  const STR *minus = ((nr == 4) || !bit3) ? "" : "-";
+  const STR *plus = ((nr == 4) && !bit3) ? "+" : "";
 
   sprintf(sinstruction, "%s.%c", cpu_dis_a5nr[nr], cpuDisSizeChar(cpuDisGetSize(opc)));
   sprintf(soperands,
@@ -590,7 +590,7 @@ static ULO cpuDisArith5(ULO prc, UWO opc, ULO nr, STR *sinstruction, STR *sopera
 
 /* Common disassembly for ASX, LSX, ROX, ROXX */
 
-static STR *cpu_dis_shnr[4] = {"AS", "LS", "RO", "ROX"};
+static const STR *cpu_dis_shnr[4] = {"AS", "LS", "RO", "ROX"};
 
 static ULO cpuDisShift(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -630,7 +630,7 @@ static ULO cpuDisShift(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction,
 
 /* Common disassembly for CLR, NEG, NOT, TST, JMP, JSR, PEA, NBCD, NEGX */
 
-static STR *cpu_dis_unanr[10] = {"CLR","NEG","NOT","TST","JMP","JSR","PEA","TAS","NCBD","NEGX"};
+static const STR *cpu_dis_unanr[10] = {"CLR","NEG","NOT","TST","JMP","JSR","PEA","TAS","NCBD","NEGX"};
 
 static ULO cpuDisUnary(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -650,7 +650,7 @@ static ULO cpuDisUnary(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction,
 
 /* Common disassembly for NOP, RESET, RTE, RTR, RTS, TRAPV */
 
-static STR *cpu_dis_singnr[6] = {"NOP","RESET","RTE","RTR","RTS","TRAPV"};
+static const STR *cpu_dis_singnr[6] = {"NOP","RESET","RTE","RTR","RTS","TRAPV"};
 
 static ULO cpuDisSingle(ULO prc, ULO nr, STR *sinstruction)
 {
@@ -660,7 +660,7 @@ static ULO cpuDisSingle(ULO prc, ULO nr, STR *sinstruction)
 
 /* Common disassembly for CHK, DIVS, DIVU, LEA, MULS, MULU */
 
-static STR *cpu_dis_var1nr[6] = {"CHK","DIVS","DIVU","LEA","MULS","MULU"};
+static const STR *cpu_dis_var1nr[6] = {"CHK","DIVS","DIVU","LEA","MULS","MULU"};
 
 static ULO cpuDisVarious1(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -676,7 +676,7 @@ static ULO cpuDisVarious1(ULO prc, UWO opc, ULO nr, STR *sdata, STR *sinstructio
 
 /* Common disassembly for SWAP, UNLK */
 
-static STR *cpu_dis_var2nr[2] = {"SWAP","UNLK"};
+static const STR *cpu_dis_var2nr[2] = {"SWAP","UNLK"};
 
 static ULO cpuDisVarious2(ULO prc, UWO opc, ULO nr, STR *sinstruction, STR *soperands)
 {
@@ -1206,7 +1206,7 @@ static ULO cpuDisBkpt(ULO prc, UWO opc, STR *sdata, STR *sinstruction, STR *sope
   return prc + 2;
 }
 
-static STR *cpu_dis_bftxt[8] = {"TST ","EXTU","CHG ","EXTS","CLR ","FFO ","SET ","INS "};
+static const STR *cpu_dis_bftxt[8] = {"TST ","EXTU","CHG ","EXTS","CLR ","FFO ","SET ","INS "};
 
 static ULO cpuDisBf(ULO prc, UWO opc, STR *sdata, STR *sinstruction, STR *soperands)
 {
@@ -61,7 +61,7 @@ ULO cpuEA05(ULO regno)
 /* Calculates EA for disp8(Ax,Ri.size) with 68020 extended modes. */
 static ULO cpuEA06Ext(UWO ext, ULO base_reg_value, ULO index_value)
 {
-  ULO base_displacement;
+  ULO base_displacement = 0;
   ULO outer_displacement;
   BOOLE index_register_suppressed = (ext & 0x0040);
   BOOLE base_register_suppressed = (ext & 0x0080);
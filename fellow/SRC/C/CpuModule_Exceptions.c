@@ -55,6 +55,7 @@ void cpuSetResetExceptionFunc(cpuResetExceptionFunc func)
   cpu_reset_exception_func = func;
 }
 
+#ifdef CPU_INSTRUCTION_LOGGING
 static STR *cpuGetExceptionName(ULO vector_offset)
 {
   char *name;
@@ -88,6 +89,7 @@ static STR *cpuGetExceptionName(ULO vector_offset)
 
   return name;
 }
+#endif
 
 /*===============================================
   Sets up an exception
@@ -25,10 +25,85 @@
 #include "CpuModule.h"
 #include "CpuModule_Internal.h"
 
+#ifdef CPU_LAZY_FLAGS
+
+/*============================================================================*/
+/* Lazy flags                                                                 */
+/* The most common flag setting operations (add, sub, cmp and the logical     */
+/* and move operations that set NZ00) only record the operation, its size,    */
+/* operands and result. cpu_sr then holds stale XNZVC bits until something    */
+/* needs them. cpuResolveLazyFlags() is called before every other use of      */
+/* the flags, by cpuGetSR(), the condition code tests and the flag setters.   */
+/*============================================================================*/
+
+cpu_lazy_flags_operation cpu_lazy_flags_op = CPU_LAZY_FLAGS_NONE;
+ULO cpu_lazy_flags_msb;
+ULO cpu_lazy_flags_res;
+static ULO cpu_lazy_flags_dst;
+static ULO cpu_lazy_flags_src;
+
+/// <summary>
+/// Record a flag setting operation.
+/// </summary>
+/// <param name="op">The operation.</param>        
+/// <param name="msb">The sign bit for the size of the operation.</param>        
+/// <param name="res">The result, zero extended.</param>        
+/// <param name="dst">The destination operand, zero extended.</param>        
+/// <param name="src">The source operand, zero extended.</param>        
+void cpuSetLazyFlags(cpu_lazy_flags_operation op, ULO msb, ULO res, ULO dst, ULO src)
+{
+  if ((op == CPU_LAZY_FLAGS_CMP || op == CPU_LAZY_FLAGS_NZ00)
+    && (cpu_lazy_flags_op == CPU_LAZY_FLAGS_ADD || cpu_lazy_flags_op == CPU_LAZY_FLAGS_SUB))
+  {
+    // The new operation keeps X, which is still pending
+    cpuMaterializeLazyFlags();
+  }
+  cpu_lazy_flags_op = op;
+  cpu_lazy_flags_msb = msb;
+  cpu_lazy_flags_res = res;
+  cpu_lazy_flags_dst = dst;
+  cpu_lazy_flags_src = src;
+}
+
+/// <summary>
+/// Calculate the flags of the recorded operation into cpu_sr.
+/// </summary>
+void cpuMaterializeLazyFlags(void)
+{
+  ULO msb = cpu_lazy_flags_msb;
+  BOOLE z = (cpu_lazy_flags_res == 0);
+  BOOLE rm = !!(cpu_lazy_flags_res & msb);
+  BOOLE dm = !!(cpu_lazy_flags_dst & msb);
+  BOOLE sm = !!(cpu_lazy_flags_src & msb);
+  cpu_lazy_flags_operation op = cpu_lazy_flags_op;
+
+  cpu_lazy_flags_op = CPU_LAZY_FLAGS_NONE;
+  switch (op)
+  {
+    case CPU_LAZY_FLAGS_ADD:
+      cpuSetFlagsAdd(z, rm, dm, sm);
+      break;
+    case CPU_LAZY_FLAGS_SUB:
+      cpuSetFlagsSub(z, rm, dm, sm);
+      break;
+    case CPU_LAZY_FLAGS_CMP:
+      cpuSetFlagsCmp(z, rm, dm, sm);
+      break;
+    case CPU_LAZY_FLAGS_NZ00:
+      cpu_sr = (cpu_sr & 0xfff0) | ((rm) ? 8 : ((z) ? 4 : 0));
+      break;
+    case CPU_LAZY_FLAGS_NONE:
+      break;
+  }
+}
+
+#endif
+
 
 /// Sets the Z flag for bit operations
 void cpuSetZFlagBitOpsB(UBY res)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfffb;
   if (res == 0) flags |= 4;
   cpu_sr = flags;
@@ -37,6 +112,7 @@ void cpuSetZFlagBitOpsB(UBY res)
 /// Sets the Z flag for bit operations
 void cpuSetZFlagBitOpsL(ULO res)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfffb;
   if (res == 0) flags |= 4;
   cpu_sr = flags;
@@ -59,17 +135,6 @@ static ULO cpuMakeFlagXNVCAdd(BOOLE rm, BOOLE dm, BOOLE sm)
 // rm,dm,sm
 ULO cpu_nvc_flag_add_table[2][2][2] = { 0,1,1,3,0xa,8,8,9};
 
-/// <summary>
-/// Calculate NVC flags of an add operation for instructions not setting X.
-/// </summary>
-/// <param name="rm">The MSB of the result.</param>        
-/// <param name="dm">The MSB of the destination source.</param>        
-/// <param name="sm">The MSB of the source.</param>        
-static ULO cpuMakeFlagNVCAdd(BOOLE rm, BOOLE dm, BOOLE sm)
-{
-  return cpu_nvc_flag_add_table[rm][dm][sm];
-}
-
 // rm,dm,sm
 ULO cpu_xnvc_flag_sub_table[2][2][2] = { 0,0x11,2,0,0x19,0x1b,8,0x19};
 
@@ -104,6 +169,7 @@ static ULO cpuMakeFlagNVCSub(BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="f">The new state of the flags.</param>        
 void cpuSetFlagXC(BOOLE f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xffee) | ((f) ? 0x11 : 0);
 }
 
@@ -113,6 +179,7 @@ void cpuSetFlagXC(BOOLE f)
 /// <param name="f">The new state of the flag.</param>        
 void cpuSetFlagC(BOOLE f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfffe) | ((f) ? 1 : 0);
 }
 
@@ -122,22 +189,16 @@ void cpuSetFlagC(BOOLE f)
 /// <param name="f">The new state of the flag.</param>        
 void cpuSetFlagV(BOOLE f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfffd) | ((f) ? 2 : 0);
 }
 
-/// <summary>
-/// Clear the V flag.
-/// </summary>
-static void cpuClearFlagV(void)
-{
-  cpu_sr = cpu_sr & 0xfffd;
-}
-
 /// <summary>
 /// Get the V flag.
 /// </summary>
 BOOLE cpuGetFlagV(void)
 {
+  cpuResolveLazyFlags();
   return cpu_sr & 0x2;
 }
 
@@ -147,6 +208,7 @@ BOOLE cpuGetFlagV(void)
 /// <param name="f">The new state of the flag.</param>        
 void cpuSetFlagN(BOOLE f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfff7) | ((f) ? 8 : 0);
 }
 
@@ -156,30 +218,16 @@ void cpuSetFlagN(BOOLE f)
 /// <param name="f">The new state of the flag.</param>        
 void cpuSetFlagZ(BOOLE f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfffb) | ((f) ? 4 : 0);
 }
 
-/// <summary>
-/// Clear the Z flag.
-/// </summary>
-static void cpuClearFlagZ(void)
-{
-  cpu_sr = cpu_sr & 0xfffb;
-}
-
-/// <summary>
-/// Get the Z flag.
-/// </summary>
-static BOOLE cpuGetFlagZ(void)
-{
-  return cpu_sr & 0x4;
-}
-
 /// <summary>
 /// Get the X flag.
 /// </summary>
 BOOLE cpuGetFlagX(void)
 {
+  cpuResolveLazyFlags();
   return cpu_sr & 0x10;
 }
 
@@ -188,6 +236,7 @@ BOOLE cpuGetFlagX(void)
 /// </summary>
 void cpuSetFlags0100(void)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfff0) | 4;
 }
 
@@ -196,6 +245,7 @@ void cpuSetFlags0100(void)
 /// </summary>
 void cpuClearFlagsVC(void)
 {
+  cpuResolveLazyFlags();
   cpu_sr = cpu_sr & 0xfffc;
 }
 
@@ -216,6 +266,7 @@ UWO cpuGetNFlagL(ULO res) {return (UWO)((res & 0x80000000) >> 28);}
 /// <param name="c">The C flag.</param>        
 void cpuSetFlagsNZVC(BOOLE z, BOOLE n, BOOLE v, BOOLE c)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfff0;
   if (n) flags |= 8;
   else if (z) flags |= 4;
@@ -231,6 +282,7 @@ void cpuSetFlagsNZVC(BOOLE z, BOOLE n, BOOLE v, BOOLE c)
 /// <param name="c">The C flag.</param>        
 void cpuSetFlagsVC(BOOLE v, BOOLE c)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfffc;
   if (v) flags |= 2;
   if (c) flags |= 1;
@@ -246,6 +298,7 @@ void cpuSetFlagsVC(BOOLE v, BOOLE c)
 /// <param name="sm">The MSB of the source.</param>        
 void cpuSetFlagsAdd(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xffe0;
   if (z) flags |= 4;
   flags |= cpuMakeFlagXNVCAdd(rm, dm, sm);
@@ -261,6 +314,7 @@ void cpuSetFlagsAdd(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="sm">The MSB of the source.</param>        
 void cpuSetFlagsSub(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xffe0;
   if (z) flags |= 4;
   flags |= cpuMakeFlagXNVCSub(rm, dm, sm);
@@ -276,6 +330,7 @@ void cpuSetFlagsSub(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="sm">The MSB of the source.</param>        
 void cpuSetFlagsAddX(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & ((z) ? 0xffe4 : 0xffe0); // Clear z if result is non-zero
   flags |= cpuMakeFlagXNVCAdd(rm, dm, sm);
   cpu_sr = flags;
@@ -290,6 +345,7 @@ void cpuSetFlagsAddX(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="sm">The MSB of the source.</param>        
 void cpuSetFlagsSubX(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & ((z) ? 0xffe4 : 0xffe0); // Clear z if result is non-zero
   flags |= cpuMakeFlagXNVCSub(rm, dm, sm);
   cpu_sr = flags;
@@ -303,6 +359,7 @@ void cpuSetFlagsSubX(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="dm">The MSB of the destination source.</param>        
 void cpuSetFlagsNeg(BOOLE z, BOOLE rm, BOOLE dm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xffe0;
   if (z) flags |= 4;
   else
@@ -325,6 +382,7 @@ void cpuSetFlagsNeg(BOOLE z, BOOLE rm, BOOLE dm)
 /// <param name="dm">The MSB of the destination source.</param>        
 void cpuSetFlagsNegx(BOOLE z, BOOLE rm, BOOLE dm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & ((z) ? 0xffe4 : 0xffe0); // Clear z if result is non-zero
   if (dm || rm)
   {
@@ -347,6 +405,7 @@ void cpuSetFlagsNegx(BOOLE z, BOOLE rm, BOOLE dm)
 /// <param name="sm">The MSB of the source.</param>        
 void cpuSetFlagsCmp(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfff0;
   if (z) flags |= 4;    
   flags |= cpuMakeFlagNVCSub(rm, dm, sm);
@@ -360,6 +419,7 @@ void cpuSetFlagsCmp(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm)
 /// <param name="rm">The MSB of the result.</param>        
 void cpuSetFlagsShiftZero(BOOLE z, BOOLE rm)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfff0; // Always clearing the VC flag
   if (rm) flags |= 8;
   else if (z) flags |= 4;  
@@ -375,6 +435,7 @@ void cpuSetFlagsShiftZero(BOOLE z, BOOLE rm)
 /// <param name="c">The overflow of the result.</param>        
 void cpuSetFlagsShift(BOOLE z, BOOLE rm, BOOLE c, BOOLE v)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xffe0;
   if (rm) flags |= 8;
   else if (z) flags |= 4;
@@ -391,6 +452,7 @@ void cpuSetFlagsShift(BOOLE z, BOOLE rm, BOOLE c, BOOLE v)
 /// <param name="c">The carry of the result.</param>        
 void cpuSetFlagsRotate(BOOLE z, BOOLE rm, BOOLE c)
 {
+  cpuResolveLazyFlags();
   ULO flags = cpu_sr & 0xfff0; // Always clearing the V flag
   
   if (rm) flags |= 8;
@@ -408,6 +470,7 @@ void cpuSetFlagsRotate(BOOLE z, BOOLE rm, BOOLE c)
 /// <param name="c">The extend bit and carry of the result.</param>        
 void cpuSetFlagsRotateX(UWO z, UWO rm, UWO x)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xffe0) | z | rm | x;
 }
 
@@ -416,10 +479,14 @@ void cpuSetFlagsRotateX(UWO z, UWO rm, UWO x)
 /// </summary>
 void cpuSetFlagsNZ00NewB(UBY res)
 {
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_NZ00, 0x80, res, 0, 0);
+#else
   ULO flag = cpu_sr & 0xfff0;
   if (res & 0x80) flag |= 0x8;
   else if (res == 0) flag |= 0x4;
   cpu_sr = flag;
+#endif
 }
 
 /// <summary>
@@ -427,10 +494,14 @@ void cpuSetFlagsNZ00NewB(UBY res)
 /// </summary>
 void cpuSetFlagsNZ00NewW(UWO res)
 {
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_NZ00, 0x8000, res, 0, 0);
+#else
   ULO flag = cpu_sr & 0xfff0;
   if (res & 0x8000) flag |= 0x8;
   else if (res == 0) flag |= 0x4;
   cpu_sr = flag;
+#endif
 }
 
 /// <summary>
@@ -438,10 +509,14 @@ void cpuSetFlagsNZ00NewW(UWO res)
 /// </summary>
 void cpuSetFlagsNZ00NewL(ULO res)
 {
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_NZ00, 0x80000000, res, 0, 0);
+#else
   ULO flag = cpu_sr & 0xfff0;
   if (res & 0x80000000) flag |= 0x8;
   else if (res == 0) flag |= 0x4;
   cpu_sr = flag;
+#endif
 }
 
 /// <summary>
@@ -449,6 +524,7 @@ void cpuSetFlagsNZ00NewL(ULO res)
 /// </summary>
 void cpuSetFlagsNZ00New64(LLO res)
 {
+  cpuResolveLazyFlags();
   ULO flag = cpu_sr & 0xfff0;
   if (res < 0) flag |= 0x8;
   else if (res == 0) flag |= 0x4;
@@ -461,6 +537,7 @@ void cpuSetFlagsNZ00New64(LLO res)
 /// <param name="f">flags</param>        
 void cpuSetFlagsAbs(UWO f)
 {
+  cpuResolveLazyFlags();
   cpu_sr = (cpu_sr & 0xfff0) | f;
 }
 
@@ -480,74 +557,100 @@ BOOLE cpuCalculateConditionCode1(void)
 
 BOOLE cpuCalculateConditionCode2(void)
 {
+  cpuResolveLazyFlags();
   return !(cpu_sr & 5);     // HI - !C && !Z
 }
 
 BOOLE cpuCalculateConditionCode3(void)
 {
+  cpuResolveLazyFlags();
   return cpu_sr & 5;	      // LS - C || Z
 }
 
 BOOLE cpuCalculateConditionCode4(void)
 {
+  cpuResolveLazyFlags();
   return (~cpu_sr) & 1;	      // CC - !C
 }
 
 BOOLE cpuCalculateConditionCode5(void)
 {
+  cpuResolveLazyFlags();
   return cpu_sr & 1;	      // CS - C
 }
 
 BOOLE cpuCalculateConditionCode6(void)
 {
+#ifdef CPU_LAZY_FLAGS
+  // All lazy operations set Z and N from the result, return the same values as below
+  if (cpu_lazy_flags_op != CPU_LAZY_FLAGS_NONE) return (cpu_lazy_flags_res != 0) ? 4 : 0;
+#endif
   return (~cpu_sr) & 4;	      // NE - !Z
 }
 
 BOOLE cpuCalculateConditionCode7(void)
 {
+#ifdef CPU_LAZY_FLAGS
+  // All lazy operations set Z and N from the result, return the same values as below
+  if (cpu_lazy_flags_op != CPU_LAZY_FLAGS_NONE) return (cpu_lazy_flags_res == 0) ? 4 : 0;
+#endif
   return cpu_sr & 4;	      // EQ - Z
 }
 
 BOOLE cpuCalculateConditionCode8(void)
 {
+  cpuResolveLazyFlags();
   return (~cpu_sr) & 2;	      // VC - !V
 }
 
 BOOLE cpuCalculateConditionCode9(void)
 {
+  cpuResolveLazyFlags();
   return cpu_sr & 2;	      // VS - V
 }
 
 BOOLE cpuCalculateConditionCode10(void)
 {
+#ifdef CPU_LAZY_FLAGS
+  // All lazy operations set Z and N from the result, return the same values as below
+  if (cpu_lazy_flags_op != CPU_LAZY_FLAGS_NONE) return (cpu_lazy_flags_res & cpu_lazy_flags_msb) ? 0 : 8;
+#endif
   return (~cpu_sr) & 8;      // PL - !N
 }
 
 BOOLE cpuCalculateConditionCode11(void)
 {
+#ifdef CPU_LAZY_FLAGS
+  // All lazy operations set Z and N from the result, return the same values as below
+  if (cpu_lazy_flags_op != CPU_LAZY_FLAGS_NONE) return (cpu_lazy_flags_res & cpu_lazy_flags_msb) ? 8 : 0;
+#endif
   return cpu_sr & 8;	      // MI - N
 }
 
 BOOLE cpuCalculateConditionCode12(void)
 {
+  cpuResolveLazyFlags();
   ULO tmp = cpu_sr & 0xa;
   return (tmp == 0xa) || (tmp == 0);  // GE - (N && V) || (!N && !V)
 }
 
 BOOLE cpuCalculateConditionCode13(void)
 {
+  cpuResolveLazyFlags();
   ULO tmp = cpu_sr & 0xa;
   return (tmp == 0x8) || (tmp == 0x2);	// LT - (N && !V) || (!N && V)
 }
 
 BOOLE cpuCalculateConditionCode14(void)
 {
+  cpuResolveLazyFlags();
   ULO tmp = cpu_sr & 0xa;
   return (!(cpu_sr & 0x4)) && ((tmp == 0xa) || (tmp == 0)); // GT - (N && V && !Z) || (!N && !V && !Z) 
 }
 
 BOOLE cpuCalculateConditionCode15(void)
 {
+  cpuResolveLazyFlags();
   ULO tmp = cpu_sr & 0xa;
   return (cpu_sr & 0x4) || (tmp == 0x8) || (tmp == 2);// LE - Z || (N && !V) || (!N && V)
 }
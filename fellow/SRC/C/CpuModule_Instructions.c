@@ -28,6 +28,10 @@
 #include "CpuModule.h"
 #include "CpuModule_Internal.h"
 
+#if defined(CPU_INSTRUCTION_PAIR_PROFILE) || defined(CPU_OPCODE_HISTOGRAM)
+#include "fileops.h"
+#endif
+
 /*============================================================================*/
 /* profiling help functions                                                   */
 /*============================================================================*/
@@ -176,7 +180,7 @@ static void cpuBkpt(ULO vector)
 static UBY cpuAddB(UBY src2, UBY src1)
 {
   UBY res = src2 + src1;
-  cpuSetFlagsAdd(cpuIsZeroB(res), cpuMsbB(res), cpuMsbB(src2), cpuMsbB(src1));
+  cpuSetFlagsAddOperands(res, src2, src1, 0x80);
   return res;
 }
 
@@ -187,7 +191,7 @@ static UBY cpuAddB(UBY src2, UBY src1)
 static UWO cpuAddW(UWO src2, UWO src1)
 {
   UWO res = src2 + src1;
-  cpuSetFlagsAdd(cpuIsZeroW(res), cpuMsbW(res), cpuMsbW(src2), cpuMsbW(src1));
+  cpuSetFlagsAddOperands(res, src2, src1, 0x8000);
   return res;
 }
 
@@ -198,7 +202,7 @@ static UWO cpuAddW(UWO src2, UWO src1)
 static ULO cpuAddL(ULO src2, ULO src1)
 {
   ULO res = src2 + src1;
-  cpuSetFlagsAdd(cpuIsZeroL(res), cpuMsbL(res), cpuMsbL(src2), cpuMsbL(src1));
+  cpuSetFlagsAddOperands(res, src2, src1, 0x80000000);
   return res;
 }
 
@@ -227,7 +231,7 @@ static ULO cpuAddaL(ULO src2, ULO src1)
 static UBY cpuSubB(UBY src2, UBY src1)
 {
   UBY res = src2 - src1;
-  cpuSetFlagsSub(cpuIsZeroB(res), cpuMsbB(res), cpuMsbB(src2), cpuMsbB(src1));
+  cpuSetFlagsSubOperands(res, src2, src1, 0x80);
   return res;
 }
 
@@ -238,7 +242,7 @@ static UBY cpuSubB(UBY src2, UBY src1)
 static UWO cpuSubW(UWO src2, UWO src1)
 {
   UWO res = src2 - src1;
-  cpuSetFlagsSub(cpuIsZeroW(res), cpuMsbW(res), cpuMsbW(src2), cpuMsbW(src1));
+  cpuSetFlagsSubOperands(res, src2, src1, 0x8000);
   return res;
 }
 
@@ -249,7 +253,7 @@ static UWO cpuSubW(UWO src2, UWO src1)
 static ULO cpuSubL(ULO src2, ULO src1)
 {
   ULO res = src2 - src1;
-  cpuSetFlagsSub(cpuIsZeroL(res), cpuMsbL(res), cpuMsbL(src2), cpuMsbL(src1));
+  cpuSetFlagsSubOperands(res, src2, src1, 0x80000000);
   return res;
 }
 
@@ -277,7 +281,7 @@ static ULO cpuSubaL(ULO src2, ULO src1)
 static void cpuCmpB(UBY src2, UBY src1)
 {
   UBY res = src2 - src1;
-  cpuSetFlagsCmp(cpuIsZeroB(res), cpuMsbB(res), cpuMsbB(src2), cpuMsbB(src1));
+  cpuSetFlagsCmpOperands(res, src2, src1, 0x80);
 }
 
 /// <summary>
@@ -286,7 +290,7 @@ static void cpuCmpB(UBY src2, UBY src1)
 static void cpuCmpW(UWO src2, UWO src1)
 {
   UWO res = src2 - src1;
-  cpuSetFlagsCmp(cpuIsZeroW(res), cpuMsbW(res), cpuMsbW(src2), cpuMsbW(src1));
+  cpuSetFlagsCmpOperands(res, src2, src1, 0x8000);
 }
 
 /// <summary>
@@ -295,7 +299,7 @@ static void cpuCmpW(UWO src2, UWO src1)
 static void cpuCmpL(ULO src2, ULO src1)
 {
   ULO res = src2 - src1;
-  cpuSetFlagsCmp(cpuIsZeroL(res), cpuMsbL(res), cpuMsbL(src2), cpuMsbL(src1));
+  cpuSetFlagsCmpOperands(res, src2, src1, 0x80000000);
 }
 
 /// <summary>
@@ -2079,7 +2083,7 @@ static void cpuMovemwPre(UWO regs, ULO reg)
     if (regs & index)
     {
       dstea -= 2;
-      if (cpuGetModelMajor() >= 2 && j == reg)
+      if (cpuGetModelMajor() >= 2 && j == (LON) reg)
       {
 	ea_reg_seen = TRUE;
 	ea_reg_ea = dstea;
@@ -2131,7 +2135,7 @@ static void cpuMovemlPre(UWO regs, ULO reg)
     if (regs & index)
     {
       dstea -= 4;
-      if (cpuGetModelMajor() >= 2 && j == reg)
+      if (cpuGetModelMajor() >= 2 && j == (LON) reg)
       {
 	ea_reg_seen = TRUE;
 	ea_reg_ea = dstea;
@@ -3572,10 +3576,7 @@ static void cpuPflush030(ULO ea, UWO extension)
     }
     else if ((extension & 0xe300) == 0x2000)
     {
-      // pflusha, pflush
-      ULO mode = (extension >> 10) & 7;
-      ULO mask = (extension >> 5) & 7;
-      ULO fc = extension & 0x1f;
+      // pflusha, pflush, there is no MMU to flush
     }
   }
   else
@@ -3654,6 +3655,125 @@ static void cpuPtest040(ULO rw, ULO regno)
   cpuSetInstructionTime(4);
 }
 
+/*============================================================================*/
+/* Fused instruction pairs                                                    */
+/* A fused handler runs the first instruction, then the second instruction    */
+/* only if its opcode is the next one in the instruction stream. The pair is  */
+/* split whenever something must be able to happen between the two, like an  */
+/* interrupt, trace or STOP.                                                  */
+/*============================================================================*/
+
+#ifdef CPU_INSTRUCTION_FUSION
+
+static ULO cpu_fusion_old_sr;
+static ULO cpu_fusion_first_time;
+
+static BOOLE cpuFusionBegin(UWO second_opcode)
+{
+  if (cpuGetPrefetchWord() != second_opcode
+    || cpuGetRaiseInterrupt()
+    || cpuGetStop()
+    || ((cpu_fusion_old_sr | cpuGetFlagsTrace()) & 0xc000))
+  {
+    return FALSE;
+  }
+
+#ifdef CPU_INSTRUCTION_LOGGING
+  cpuCallInstructionLoggingFunc();
+#endif
+
+  cpu_fusion_first_time = cpuGetInstructionTime();
+  cpuSetOriginalPC(cpuGetPC());
+  cpuGetNextWord();
+
+#ifdef CPU_INSTRUCTION_LOGGING
+  cpuSetCurrentOpcode(second_opcode);
+#endif
+
+  cpuSetInstructionTime(0);
+  return TRUE;
+}
+
+static void cpuFusionEnd(void)
+{
+  cpuSetInstructionTime(cpu_fusion_first_time + cpuGetInstructionTime());
+}
+
+#endif
+
+/*============================================================================*/
+/* Instruction pair profile, input to 68kgenerate for instruction fusion      */
+/*============================================================================*/
+
+#ifdef CPU_INSTRUCTION_PAIR_PROFILE
+
+#define CPU_PAIR_PROFILE_SIZE 0x10000
+#define CPU_PAIR_PROFILE_MAX_PROBES 32
+#define CPU_PAIR_PROFILE_NO_OPCODE 0xffffffff
+
+typedef struct cpu_pair_profile_entry_
+{
+  ULO pair;
+  ULL count;
+} cpu_pair_profile_entry;
+
+static cpu_pair_profile_entry cpu_pair_profile[CPU_PAIR_PROFILE_SIZE];
+static ULO cpu_pair_profile_previous_opcode = CPU_PAIR_PROFILE_NO_OPCODE;
+
+static void cpuPairProfileAdd(UWO opcode)
+{
+  if (cpu_pair_profile_previous_opcode != CPU_PAIR_PROFILE_NO_OPCODE)
+  {
+    ULO pair = (cpu_pair_profile_previous_opcode << 16) | opcode;
+    ULO index = (pair * 0x9e3779b1) >> 16;
+
+    // Open addressing, pair 0 marks a free slot so 0000 followed by 0000 is not counted.
+    // A pair that finds no slot within a few probes is not counted, with a full table
+    // every new pair would otherwise search all of it.
+    for (ULO probe = 0; probe < CPU_PAIR_PROFILE_MAX_PROBES; probe++)
+    {
+      cpu_pair_profile_entry *entry = &cpu_pair_profile[(index + probe) & (CPU_PAIR_PROFILE_SIZE - 1)];
+      if (entry->pair == pair)
+      {
+        entry->count++;
+        break;
+      }
+      if (entry->pair == 0)
+      {
+        if (pair != 0)
+        {
+          entry->pair = pair;
+          entry->count = 1;
+        }
+        break;
+      }
+    }
+  }
+  cpu_pair_profile_previous_opcode = opcode;
+}
+
+void cpuPairProfileWrite(void)
+{
+  char filename[MAX_PATH];
+  FILE *F = NULL;
+  fileopsGetGenericFileName(filename, "WinFellow", "cpupairs.txt");
+  F = fopen(filename, "w");
+  if (F != NULL)
+  {
+    fprintf(F, "FIRST\tSECOND\tCOUNT\n");
+    for (ULO i = 0; i < CPU_PAIR_PROFILE_SIZE; i++)
+    {
+      if (cpu_pair_profile[i].pair != 0)
+      {
+        fprintf(F, "%.4X\t%.4X\t%llu\n", cpu_pair_profile[i].pair >> 16, cpu_pair_profile[i].pair & 0xffff, (unsigned long long) cpu_pair_profile[i].count);
+      }
+    }
+    fclose(F);
+  }
+}
+
+#endif
+
 #include "CpuModule_Decl.h"
 #include "CpuModule_Data.h"
 #include "CpuModule_Profile.h"
@@ -3678,8 +3798,178 @@ void cpuMakeOpcodeTableForModel(void)
       cpu_opcode_data_current[opcode].data[2] = 0;
     }
   }
+#ifdef CPU_INSTRUCTION_FUSION
+  for (cpuFusionData *fusion = cpu_fusion_data; fusion->instruction_func != NULL; fusion++)
+  {
+    if ((cpu_opcode_model_mask[fusion->first_opcode] & cpuGetModelMask())
+      && (cpu_opcode_model_mask[fusion->second_opcode] & cpuGetModelMask()))
+    {
+      cpu_opcode_data_current[fusion->first_opcode].instruction_func = fusion->instruction_func;
+    }
+  }
+#endif
 }
 
+/*============================================================================*/
+/* Opcode histogram, executions and 68000 cycles for each opcode word         */
+/* cpuopcodes.txt has one "opcode count cycles" line for each executed        */
+/* opcode, it is input to 68kgenerate. cpuopcodereport.txt has the same       */
+/* numbers sorted, for each instruction handler and for each opcode.          */
+/* Instructions that end in an exception are not counted, and with            */
+/* CPU_INSTRUCTION_FUSION the second instruction of a pair is counted with    */
+/* the first.                                                                 */
+/*============================================================================*/
+
+#ifdef CPU_OPCODE_HISTOGRAM
+
+typedef struct cpu_opcode_histogram_entry_
+{
+  ULL count;
+  ULL cycles;
+} cpu_opcode_histogram_entry;
+
+static cpu_opcode_histogram_entry cpu_opcode_histogram[65536];
+
+static void cpuOpcodeHistogramAdd(UWO opcode, ULO cycles)
+{
+  cpu_opcode_histogram[opcode].count++;
+  cpu_opcode_histogram[opcode].cycles += cycles;
+}
+
+// The table that the sort by count compares, the opcodes or the handler totals
+static cpu_opcode_histogram_entry *cpu_opcode_histogram_sort_table;
+
+static int cpuOpcodeHistogramCompareCount(const void *a, const void *b)
+{
+  ULL count_a = cpu_opcode_histogram_sort_table[*(const ULO *) a].count;
+  ULL count_b = cpu_opcode_histogram_sort_table[*(const ULO *) b].count;
+  if (count_a > count_b) return -1;
+  if (count_a < count_b) return 1;
+  return (int) *(const ULO *) a - (int) *(const ULO *) b;
+}
+
+/* Orders opcodes by handler, then by opcode */
+static int cpuOpcodeHistogramCompareHandler(const void *a, const void *b)
+{
+  size_t handler_a = (size_t) cpu_opcode_data_current[*(const ULO *) a].instruction_func;
+  size_t handler_b = (size_t) cpu_opcode_data_current[*(const ULO *) b].instruction_func;
+  if (handler_a < handler_b) return -1;
+  if (handler_a > handler_b) return 1;
+  return (int) *(const ULO *) a - (int) *(const ULO *) b;
+}
+
+static void cpuOpcodeHistogramSort(ULO *order, int (*compare)(const void *, const void *))
+{
+  for (ULO opcode = 0; opcode < 65536; opcode++)
+  {
+    order[opcode] = opcode;
+  }
+  qsort(order, 65536, sizeof(ULO), compare);
+}
+
+static double cpuOpcodeHistogramPercent(ULL part, ULL total)
+{
+  return (total == 0) ? 0.0 : ((100.0*part)/total);
+}
+
+static double cpuOpcodeHistogramCyclesPerCall(cpu_opcode_histogram_entry *entry)
+{
+  return (entry->count == 0) ? 0.0 : (((double) entry->cycles)/entry->count);
+}
+
+void cpuOpcodeHistogramWrite(void)
+{
+  char filename[MAX_PATH];
+  FILE *F = NULL;
+  ULO *order = (ULO *) malloc(sizeof(ULO)*65536);
+  ULO *handler_first = (ULO *) malloc(sizeof(ULO)*65536);
+  ULO *handler_opcodes = (ULO *) calloc(65536, sizeof(ULO));
+  cpu_opcode_histogram_entry *handlers = (cpu_opcode_histogram_entry *) calloc(65536, sizeof(cpu_opcode_histogram_entry));
+  ULL total_count = 0, total_cycles = 0;
+  ULO executed = 0, executed_handlers = 0, handler_count = 0, first = 0;
+
+  fileopsGetGenericFileName(filename, "WinFellow", "cpuopcodes.txt");
+  F = fopen(filename, "w");
+  if (F != NULL)
+  {
+    fprintf(F, "OPCODE\tCOUNT\tCYCLES\n");
+    for (ULO opcode = 0; opcode < 65536; opcode++)
+    {
+      if (cpu_opcode_histogram[opcode].count != 0)
+      {
+	fprintf(F, "%.4X\t%llu\t%llu\n", opcode, cpu_opcode_histogram[opcode].count, cpu_opcode_histogram[opcode].cycles);
+      }
+    }
+    fclose(F);
+  }
+
+  if (order == NULL || handler_first == NULL || handler_opcodes == NULL || handlers == NULL)
+  {
+    free(order);
+    free(handler_first);
+    free(handler_opcodes);
+    free(handlers);
+    return;
+  }
+
+  // Group the opcodes by handler, a handler is named by the first opcode that runs it, 68kgenerate knows its function name
+  cpuOpcodeHistogramSort(order, cpuOpcodeHistogramCompareHandler);
+  for (ULO i = 0; i < 65536; i++)
+  {
+    ULO opcode = order[i];
+    if (i == 0 || cpu_opcode_data_current[opcode].instruction_func != cpu_opcode_data_current[order[i - 1]].instruction_func)
+    {
+      first = opcode;
+      handler_count++;
+    }
+    handler_first[opcode] = first;
+    handlers[first].count += cpu_opcode_histogram[opcode].count;
+    handlers[first].cycles += cpu_opcode_histogram[opcode].cycles;
+    handler_opcodes[first]++;
+    total_count += cpu_opcode_histogram[opcode].count;
+    total_cycles += cpu_opcode_histogram[opcode].cycles;
+    if (cpu_opcode_histogram[opcode].count != 0) executed++;
+  }
+  for (ULO opcode = 0; opcode < 65536; opcode++)
+  {
+    if (handlers[opcode].count != 0) executed_handlers++;
+  }
+
+  fileopsGetGenericFileName(filename, "WinFellow", "cpuopcodereport.txt");
+  F = fopen(filename, "w");
+  if (F != NULL)
+  {
+    fprintf(F, "%llu instructions, %llu cycles, %.2f cycles per instruction\n", total_count, total_cycles, (total_count == 0) ? 0.0 : (((double) total_cycles)/total_count));
+    fprintf(F, "%u of %u handlers and %u opcodes executed\n\n", executed_handlers, handler_count, executed);
+
+    fprintf(F, "HANDLER\tOPCODES\tCOUNT\tCOUNT%%\tCYCLES\tCYCLES%%\tCYCLES_PER_CALL\n");
+    cpu_opcode_histogram_sort_table = handlers;
+    cpuOpcodeHistogramSort(order, cpuOpcodeHistogramCompareCount);
+    for (ULO i = 0; i < 65536 && handlers[order[i]].count != 0; i++)
+    {
+      cpu_opcode_histogram_entry *entry = &handlers[order[i]];
+      fprintf(F, "%.4X\t%u\t%llu\t%.2f\t%llu\t%.2f\t%.2f\n", order[i], handler_opcodes[order[i]], entry->count, cpuOpcodeHistogramPercent(entry->count, total_count), entry->cycles, cpuOpcodeHistogramPercent(entry->cycles, total_cycles), cpuOpcodeHistogramCyclesPerCall(entry));
+    }
+
+    fprintf(F, "\nOPCODE\tHANDLER\tCOUNT\tCOUNT%%\tCYCLES\tCYCLES%%\tCYCLES_PER_CALL\n");
+    cpu_opcode_histogram_sort_table = cpu_opcode_histogram;
+    cpuOpcodeHistogramSort(order, cpuOpcodeHistogramCompareCount);
+    for (ULO i = 0; i < 65536 && cpu_opcode_histogram[order[i]].count != 0; i++)
+    {
+      cpu_opcode_histogram_entry *entry = &cpu_opcode_histogram[order[i]];
+      fprintf(F, "%.4X\t%.4X\t%llu\t%.2f\t%llu\t%.2f\t%.2f\n", order[i], handler_first[order[i]], entry->count, cpuOpcodeHistogramPercent(entry->count, total_count), entry->cycles, cpuOpcodeHistogramPercent(entry->cycles, total_cycles), cpuOpcodeHistogramCyclesPerCall(entry));
+    }
+    fclose(F);
+  }
+
+  free(order);
+  free(handler_first);
+  free(handler_opcodes);
+  free(handlers);
+}
+
+#endif
+
 ULO irq_arrival_time = -1;
 extern ULO busGetCycle();
 
@@ -3689,11 +3979,14 @@ ULO cpuExecuteInstruction(void)
   {
     cpuSetUpInterrupt(cpuGetRaiseInterruptLevel());
     cpuCheckPendingInterrupts();
+#ifdef CPU_INSTRUCTION_PAIR_PROFILE
+    cpu_pair_profile_previous_opcode = CPU_PAIR_PROFILE_NO_OPCODE;
+#endif
     return 44;
   }
   else
   {
-    ULO oldSr = cpuGetSR();
+    ULO oldSr = cpuGetFlagsTrace();
     UWO opcode;
 
 #ifdef CPU_INSTRUCTION_LOGGING
@@ -3707,6 +4000,14 @@ ULO cpuExecuteInstruction(void)
     cpuSetCurrentOpcode(opcode);
 #endif
 
+#ifdef CPU_INSTRUCTION_PAIR_PROFILE
+    cpuPairProfileAdd(opcode);
+#endif
+
+#ifdef CPU_INSTRUCTION_FUSION
+    cpu_fusion_old_sr = oldSr;
+#endif
+
     cpuSetInstructionTime(0);
 
 	cpu_opcode_data_current[opcode].instruction_func(
@@ -3718,6 +4019,9 @@ ULO cpuExecuteInstruction(void)
       cpuThrowTraceException();
       cpuSetInstructionTime(cpuGetInstructionTime() + cycles);
     }
+#ifdef CPU_OPCODE_HISTOGRAM
+    cpuOpcodeHistogramAdd(opcode, cpuGetInstructionTime());
+#endif
     return cpuGetInstructionTime();
   }
 }
@@ -95,6 +95,14 @@ BOOLE cpuGetFlagMaster(void)
   return cpu_sr & 0x1000;
 }
 
+/// <summary>
+/// Get the trace bits from sr, without resolving lazy flags.
+/// </summary>
+ULO cpuGetFlagsTrace(void)
+{
+  return cpu_sr & 0xc000;
+}
+
 void cpuSetUspDirect(ULO usp) {cpu_usp = usp;}
 ULO cpuGetUspDirect(void) {return cpu_usp;}
 ULO cpuGetUspAutoMap(void) {return (cpuGetFlagSupervisor()) ? cpuGetUspDirect() : cpuGetAReg(7);}
@@ -181,8 +189,8 @@ ULO cpuGetCacr(void) {return cpu_cacr;}
 void cpuSetCaar(ULO caar) {cpu_caar = caar;}
 ULO cpuGetCaar(void) {return cpu_caar;}
 
-void cpuSetSR(ULO sr) {cpu_sr = sr;}
-ULO cpuGetSR(void) {return cpu_sr;}
+void cpuSetSR(ULO sr) {cpuDiscardLazyFlags(); cpu_sr = sr;}
+ULO cpuGetSR(void) {cpuResolveLazyFlags(); return cpu_sr;}
 
 void cpuSetInstructionTime(ULO cycles) {cpu_instruction_time = cycles;}
 ULO cpuGetInstructionTime(void) {return cpu_instruction_time;}
@@ -245,7 +253,7 @@ void cpuSetModel(ULO major, ULO minor)
   if (makeOpcodeTable) cpuMakeOpcodeTableForModel();
 }
 
-void cpuSetDRegWord(ULO regno, UWO val) {*((WOR*)&cpu_regs[0][regno]) = val;}
+void cpuSetDRegWord(ULO regno, UWO val) {cpu_regs[0][regno] = (cpu_regs[0][regno] & 0xffff0000) | val;}
 void cpuSetDRegByte(ULO regno, UBY val) {*((UBY*)&cpu_regs[0][regno]) = val;}
 UWO cpuGetRegWord(ULO i, ULO regno) {return (UWO)cpu_regs[i][regno];}
 
@@ -306,6 +314,11 @@ void cpuClearPrefetch(void)
   cpu_prefetch_word = 0;
 }
 
+UWO cpuGetPrefetchWord(void)
+{
+  return cpu_prefetch_word;
+}
+
 void cpuSkipNextWord(void)
 {
   cpuSetPC(cpuGetPC() + 2);
@@ -324,59 +337,67 @@ void cpuInitializeFromNewPC(ULO new_pc)
   cpuInitializePrefetch();
 }
 
-void cpuSaveState(FILE *F)
+void cpuSaveState(savestate *S)
 {
   ULO i, j;
 
-  fwrite(&cpu_model_major, sizeof(cpu_model_major), 1, F);
-  fwrite(&cpu_model_minor, sizeof(cpu_model_minor), 1, F);
+  savestateWriteValue(S, cpu_model_major);
+  savestateWriteValue(S, cpu_model_minor);
   for (i = 0; i < 2; i++)
   {
-    for (j = 0; j < 7; j++)
+    for (j = 0; j < 8; j++)
     {
-      fwrite(&cpu_regs[i][j], sizeof(cpu_regs[i][j]), 1, F);
+      savestateWriteValue(S, cpu_regs[i][j]);
     }
   }
-  fwrite(&cpu_pc, sizeof(cpu_pc), 1, F);
-  fwrite(&cpu_usp, sizeof(cpu_usp), 1, F);
-  fwrite(&cpu_ssp, sizeof(cpu_ssp), 1, F);
-  fwrite(&cpu_msp, sizeof(cpu_msp), 1, F);
-  fwrite(&cpu_sfc, sizeof(cpu_sfc), 1, F);
-  fwrite(&cpu_dfc, sizeof(cpu_dfc), 1, F);
-  fwrite(&cpu_sr, sizeof(cpu_sr), 1, F);
-  fwrite(&cpu_prefetch_word, sizeof(cpu_prefetch_word), 1, F);
-  fwrite(&cpu_vbr, sizeof(cpu_vbr), 1, F);
-  fwrite(&cpu_cacr, sizeof(cpu_cacr), 1, F);
-  fwrite(&cpu_caar, sizeof(cpu_caar), 1, F);
-  fwrite(&cpu_initial_pc, sizeof(cpu_initial_pc), 1, F);
-  fwrite(&cpu_initial_sp, sizeof(cpu_initial_sp), 1, F);
+  savestateWriteValue(S, cpu_pc);
+  savestateWriteValue(S, cpu_usp);
+  savestateWriteValue(S, cpu_ssp);
+  savestateWriteValue(S, cpu_msp);
+  savestateWriteValue(S, cpu_sfc);
+  savestateWriteValue(S, cpu_dfc);
+  cpuResolveLazyFlags();
+  savestateWriteValue(S, cpu_sr);
+  savestateWriteValue(S, cpu_prefetch_word);
+  savestateWriteValue(S, cpu_vbr);
+  savestateWriteValue(S, cpu_cacr);
+  savestateWriteValue(S, cpu_caar);
+  savestateWriteValue(S, cpu_initial_pc);
+  savestateWriteValue(S, cpu_initial_sp);
+  savestateWriteValue(S, cpu_stop);
+  savestateWriteValue(S, cpu_raise_irq);
+  savestateWriteValue(S, cpu_raise_irq_level);
 }
 
-void cpuLoadState(FILE *F)
+void cpuLoadState(savestate *S)
 {
   ULO i, j;
 
-  fread(&cpu_model_major, sizeof(cpu_model_major), 1, F);
-  fread(&cpu_model_minor, sizeof(cpu_model_minor), 1, F);
+  savestateReadValue(S, cpu_model_major);
+  savestateReadValue(S, cpu_model_minor);
   for (i = 0; i < 2; i++)
   {
-    for (j = 0; j < 7; j++)
+    for (j = 0; j < 8; j++)
     {
-      fread(&cpu_regs[i][j], sizeof(cpu_regs[i][j]), 1, F);
+      savestateReadValue(S, cpu_regs[i][j]);
     }
   }
-  fread(&cpu_pc, sizeof(cpu_pc), 1, F);
-  fread(&cpu_usp, sizeof(cpu_usp), 1, F);
-  fread(&cpu_ssp, sizeof(cpu_ssp), 1, F);
-  fread(&cpu_msp, sizeof(cpu_msp), 1, F);
-  fread(&cpu_sfc, sizeof(cpu_sfc), 1, F);
-  fread(&cpu_dfc, sizeof(cpu_dfc), 1, F);
-  fread(&cpu_sr, sizeof(cpu_sr), 1, F);
-  fread(&cpu_prefetch_word, sizeof(cpu_prefetch_word), 1, F);
-  fread(&cpu_vbr, sizeof(cpu_vbr), 1, F);
-  fread(&cpu_cacr, sizeof(cpu_cacr), 1, F);
-  fread(&cpu_caar, sizeof(cpu_caar), 1, F);
-  fread(&cpu_initial_pc, sizeof(cpu_initial_pc), 1, F);
-  fread(&cpu_initial_sp, sizeof(cpu_initial_sp), 1, F);
+  savestateReadValue(S, cpu_pc);
+  savestateReadValue(S, cpu_usp);
+  savestateReadValue(S, cpu_ssp);
+  savestateReadValue(S, cpu_msp);
+  savestateReadValue(S, cpu_sfc);
+  savestateReadValue(S, cpu_dfc);
+  cpuDiscardLazyFlags();
+  savestateReadValue(S, cpu_sr);
+  savestateReadValue(S, cpu_prefetch_word);
+  savestateReadValue(S, cpu_vbr);
+  savestateReadValue(S, cpu_cacr);
+  savestateReadValue(S, cpu_caar);
+  savestateReadValue(S, cpu_initial_pc);
+  savestateReadValue(S, cpu_initial_sp);
+  savestateReadValue(S, cpu_stop);
+  savestateReadValue(S, cpu_raise_irq);
+  savestateReadValue(S, cpu_raise_irq_level);
   cpuSetModel(cpu_model_major, cpu_model_minor); // Recalculates stack frames etc.
 }
@@ -175,13 +175,13 @@ void LineExactCopper::EventHandler()
       {
         // Copper waits until Blitter is finished
         copper_registers.copper_pc = chipsetMaskPtr(copper_registers.copper_pc - 4);
-        if ((blitterEvent.cycle + 4) <= bus.cycle)
+        if ((blitterGetFinishCycle() + 4) <= bus.cycle)
         {
           InsertEvent(bus.cycle + 4);
         }
         else
         {
-          InsertEvent(blitterEvent.cycle + 4);
+          InsertEvent(blitterGetFinishCycle() + 4);
         }
       }
       else
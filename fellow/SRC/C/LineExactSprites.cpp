@@ -8,6 +8,11 @@
 #include "DRAW.H"
 #include "chipset.h"
 
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 spr_register_func LineExactSprites::sprxptl_functions[8] =
 {
   &LineExactSprites::aspr0ptl,
@@ -252,6 +257,8 @@ void LineExactSprites::MergeListClear(spr_merge_list_master* l)
 
 /*===========================================================================*/
 /* Save sprite data for later processing on HAM bitmaps                      */
+/* The sprites are drawn in the colors of the line description, which can   */
+/* be drawn on the present thread while the emulation changes the colors.   */
 /*===========================================================================*/
 
 void LineExactSprites::MergeHAM(graph_line *linedescription)
@@ -273,6 +280,44 @@ void LineExactSprites::MergeHAM(graph_line *linedescription)
   sprite_ham_slot_next++;
 }
 
+/*===========================================================================*/
+/* Merge sprites with HAM, the pixels of an item that are drawn              */
+/* Bit n is set when pixel n of the visible pixels is not transparent, the  */
+/* 16 pixels of the item are tested in one SSE2 compare. The colors are     */
+/* looked up one opaque pixel at a time, SSE2 has no gather.                */
+/*===========================================================================*/
+
+ULO LineExactSprites::MergeHAMOpaquePixels(spr_merge_list_item &item, ULO first_pixel, ULO pixel_count)
+{
+  ULO opaque = 0;
+
+  if (ham_sse2)
+  {
+    __m128i pixels = _mm_loadu_si128((__m128i *) item.sprite_data);
+    opaque = ~_mm_movemask_epi8(_mm_cmpeq_epi8(pixels, _mm_setzero_si128())) & 0xffff;
+  }
+  else
+  {
+    for (ULO i = 0; i < 16; i++)
+    {
+      if (item.sprite_data[i] != 0) opaque |= 1 << i;
+    }
+  }
+  return (opaque >> first_pixel) & ((1 << pixel_count) - 1);
+}
+
+/* Index of the lowest set bit, opaque is not 0 */
+static __inline ULO MergeHAMFirstPixel(ULO opaque)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, opaque);
+  return index;
+#else
+  return __builtin_ctz(opaque);
+#endif
+}
+
 /*===========================================================================*/
 /* Merge sprites with HAM, actual drawing                                    */
 /* 16-bit pixels, 2x horisontal scale                                        */
@@ -311,17 +356,15 @@ void LineExactSprites::MergeHAM2x1x16(ULO *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULO *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULO color = graph_color_shadow[pixel >> 2];
-              *frame_ptr = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULO *pixel_ptr = frame_ptr + x;
+            ULO color = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color;
           }
         }
       }
@@ -367,18 +410,16 @@ void LineExactSprites::MergeHAM2x2x16(ULO *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULO *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULO color = graph_color_shadow[pixel >> 2];
-              frame_ptr[0] = color;
-              frame_ptr[nextlineoffset] = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULO *pixel_ptr = frame_ptr + x;
+            ULO color = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color;
+            pixel_ptr[nextlineoffset] = color;
           }
         }
       }
@@ -424,18 +465,16 @@ void LineExactSprites::MergeHAM4x2x16(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-              frame_ptr[nextlineoffset] = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
+            pixel_ptr[nextlineoffset] = color;
           }
         }
       }
@@ -481,20 +520,18 @@ void LineExactSprites::MergeHAM4x4x16(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-              frame_ptr[nextlineoffset] = color;
-              frame_ptr[nextlineoffset2] = color;
-              frame_ptr[nextlineoffset3] = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
+            pixel_ptr[nextlineoffset] = color;
+            pixel_ptr[nextlineoffset2] = color;
+            pixel_ptr[nextlineoffset3] = color;
           }
         }
       }
@@ -546,22 +583,21 @@ void LineExactSprites::MergeHAM2x1x24(UBY *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           UBY *frame_ptr = frameptr + 6 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              union sprham24helper color;
-              color.color_i = graph_color_shadow[pixel >> 2];
-              *frame_ptr++ = color.color_b[0];
-              *frame_ptr++ = color.color_b[1];
-              *frame_ptr++ = color.color_b[2];
-              *frame_ptr++ = color.color_b[0];
-              *frame_ptr++ = color.color_b[1];
-              *frame_ptr++ = color.color_b[2];
-            }
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            UBY *pixel_ptr = frame_ptr + 6 * x;
+            union sprham24helper color;
+            color.color_i = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color.color_b[0];
+            pixel_ptr[1] = color.color_b[1];
+            pixel_ptr[2] = color.color_b[2];
+            pixel_ptr[3] = color.color_b[0];
+            pixel_ptr[4] = color.color_b[1];
+            pixel_ptr[5] = color.color_b[2];
           }
         }
       }
@@ -607,30 +643,28 @@ void LineExactSprites::MergeHAM2x2x24(UBY *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           UBY *frame_ptr = frameptr + 6 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              union sprham24helper color;
-              color.color_i = graph_color_shadow[pixel >> 2];
-              frame_ptr[0] = color.color_b[0];
-              frame_ptr[1] = color.color_b[1];
-              frame_ptr[2] = color.color_b[2];
-              frame_ptr[3] = color.color_b[0];
-              frame_ptr[4] = color.color_b[1];
-              frame_ptr[5] = color.color_b[2];
-
-              frame_ptr[nextlineoffset] = color.color_b[0];
-              frame_ptr[1 + nextlineoffset] = color.color_b[1];
-              frame_ptr[2 + nextlineoffset] = color.color_b[2];
-              frame_ptr[3 + nextlineoffset] = color.color_b[0];
-              frame_ptr[4 + nextlineoffset] = color.color_b[1];
-              frame_ptr[5 + nextlineoffset] = color.color_b[2];
-            }
-            frame_ptr += 6;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            UBY *pixel_ptr = frame_ptr + 6 * x;
+            union sprham24helper color;
+            color.color_i = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color.color_b[0];
+            pixel_ptr[1] = color.color_b[1];
+            pixel_ptr[2] = color.color_b[2];
+            pixel_ptr[3] = color.color_b[0];
+            pixel_ptr[4] = color.color_b[1];
+            pixel_ptr[5] = color.color_b[2];
+
+            pixel_ptr[nextlineoffset] = color.color_b[0];
+            pixel_ptr[1 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[2 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[3 + nextlineoffset] = color.color_b[0];
+            pixel_ptr[4 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[5 + nextlineoffset] = color.color_b[2];
           }
         }
       }
@@ -676,42 +710,40 @@ void LineExactSprites::MergeHAM4x2x24(UBY *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           UBY *frame_ptr = frameptr + 12 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              union sprham24helper color;
-              color.color_i = graph_color_shadow[pixel >> 2];
-              frame_ptr[0] = color.color_b[0];
-              frame_ptr[1] = color.color_b[1];
-              frame_ptr[2] = color.color_b[2];
-              frame_ptr[3] = color.color_b[0];
-              frame_ptr[4] = color.color_b[1];
-              frame_ptr[5] = color.color_b[2];
-              frame_ptr[6] = color.color_b[0];
-              frame_ptr[7] = color.color_b[1];
-              frame_ptr[8] = color.color_b[2];
-              frame_ptr[9] = color.color_b[0];
-              frame_ptr[10] = color.color_b[1];
-              frame_ptr[11] = color.color_b[2];
-
-              frame_ptr[nextlineoffset] = color.color_b[0];
-              frame_ptr[1 + nextlineoffset] = color.color_b[1];
-              frame_ptr[2 + nextlineoffset] = color.color_b[2];
-              frame_ptr[3 + nextlineoffset] = color.color_b[0];
-              frame_ptr[4 + nextlineoffset] = color.color_b[1];
-              frame_ptr[5 + nextlineoffset] = color.color_b[2];
-              frame_ptr[6 + nextlineoffset] = color.color_b[1];
-              frame_ptr[7 + nextlineoffset] = color.color_b[2];
-              frame_ptr[8 + nextlineoffset] = color.color_b[0];
-              frame_ptr[9 + nextlineoffset] = color.color_b[1];
-              frame_ptr[10 + nextlineoffset] = color.color_b[2];
-              frame_ptr[11 + nextlineoffset] = color.color_b[2];
-            }
-            frame_ptr += 12;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            UBY *pixel_ptr = frame_ptr + 12 * x;
+            union sprham24helper color;
+            color.color_i = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color.color_b[0];
+            pixel_ptr[1] = color.color_b[1];
+            pixel_ptr[2] = color.color_b[2];
+            pixel_ptr[3] = color.color_b[0];
+            pixel_ptr[4] = color.color_b[1];
+            pixel_ptr[5] = color.color_b[2];
+            pixel_ptr[6] = color.color_b[0];
+            pixel_ptr[7] = color.color_b[1];
+            pixel_ptr[8] = color.color_b[2];
+            pixel_ptr[9] = color.color_b[0];
+            pixel_ptr[10] = color.color_b[1];
+            pixel_ptr[11] = color.color_b[2];
+
+            pixel_ptr[nextlineoffset] = color.color_b[0];
+            pixel_ptr[1 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[2 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[3 + nextlineoffset] = color.color_b[0];
+            pixel_ptr[4 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[5 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[6 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[7 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[8 + nextlineoffset] = color.color_b[0];
+            pixel_ptr[9 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[10 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[11 + nextlineoffset] = color.color_b[2];
           }
         }
       }
@@ -757,68 +789,66 @@ void LineExactSprites::MergeHAM4x4x24(UBY *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           UBY *frame_ptr = frameptr + 12 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              union sprham24helper color;
-              color.color_i = graph_color_shadow[pixel >> 2];
-              frame_ptr[0] = color.color_b[0];
-              frame_ptr[1] = color.color_b[1];
-              frame_ptr[2] = color.color_b[2];
-              frame_ptr[3] = color.color_b[0];
-              frame_ptr[4] = color.color_b[1];
-              frame_ptr[5] = color.color_b[2];
-              frame_ptr[6] = color.color_b[0];
-              frame_ptr[7] = color.color_b[1];
-              frame_ptr[8] = color.color_b[2];
-              frame_ptr[9] = color.color_b[0];
-              frame_ptr[10] = color.color_b[1];
-              frame_ptr[11] = color.color_b[2];
-
-              frame_ptr[nextlineoffset] = color.color_b[0];
-              frame_ptr[1 + nextlineoffset] = color.color_b[1];
-              frame_ptr[2 + nextlineoffset] = color.color_b[2];
-              frame_ptr[3 + nextlineoffset] = color.color_b[0];
-              frame_ptr[4 + nextlineoffset] = color.color_b[1];
-              frame_ptr[5 + nextlineoffset] = color.color_b[2];
-              frame_ptr[6 + nextlineoffset] = color.color_b[1];
-              frame_ptr[7 + nextlineoffset] = color.color_b[2];
-              frame_ptr[8 + nextlineoffset] = color.color_b[0];
-              frame_ptr[9 + nextlineoffset] = color.color_b[1];
-              frame_ptr[10 + nextlineoffset] = color.color_b[2];
-              frame_ptr[11 + nextlineoffset] = color.color_b[2];
-
-              frame_ptr[nextlineoffset2] = color.color_b[0];
-              frame_ptr[1 + nextlineoffset2] = color.color_b[1];
-              frame_ptr[2 + nextlineoffset2] = color.color_b[2];
-              frame_ptr[3 + nextlineoffset2] = color.color_b[0];
-              frame_ptr[4 + nextlineoffset2] = color.color_b[1];
-              frame_ptr[5 + nextlineoffset2] = color.color_b[2];
-              frame_ptr[6 + nextlineoffset2] = color.color_b[1];
-              frame_ptr[7 + nextlineoffset2] = color.color_b[2];
-              frame_ptr[8 + nextlineoffset2] = color.color_b[0];
-              frame_ptr[9 + nextlineoffset2] = color.color_b[1];
-              frame_ptr[10 + nextlineoffset2] = color.color_b[2];
-              frame_ptr[11 + nextlineoffset2] = color.color_b[2];
-
-              frame_ptr[nextlineoffset3] = color.color_b[0];
-              frame_ptr[1 + nextlineoffset3] = color.color_b[1];
-              frame_ptr[2 + nextlineoffset3] = color.color_b[2];
-              frame_ptr[3 + nextlineoffset3] = color.color_b[0];
-              frame_ptr[4 + nextlineoffset3] = color.color_b[1];
-              frame_ptr[5 + nextlineoffset3] = color.color_b[2];
-              frame_ptr[6 + nextlineoffset3] = color.color_b[1];
-              frame_ptr[7 + nextlineoffset3] = color.color_b[2];
-              frame_ptr[8 + nextlineoffset3] = color.color_b[0];
-              frame_ptr[9 + nextlineoffset3] = color.color_b[1];
-              frame_ptr[10 + nextlineoffset3] = color.color_b[2];
-              frame_ptr[11 + nextlineoffset3] = color.color_b[2];
-            }
-            frame_ptr += 12;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            UBY *pixel_ptr = frame_ptr + 12 * x;
+            union sprham24helper color;
+            color.color_i = linedescription->colors[pixel >> 2];
+            pixel_ptr[0] = color.color_b[0];
+            pixel_ptr[1] = color.color_b[1];
+            pixel_ptr[2] = color.color_b[2];
+            pixel_ptr[3] = color.color_b[0];
+            pixel_ptr[4] = color.color_b[1];
+            pixel_ptr[5] = color.color_b[2];
+            pixel_ptr[6] = color.color_b[0];
+            pixel_ptr[7] = color.color_b[1];
+            pixel_ptr[8] = color.color_b[2];
+            pixel_ptr[9] = color.color_b[0];
+            pixel_ptr[10] = color.color_b[1];
+            pixel_ptr[11] = color.color_b[2];
+
+            pixel_ptr[nextlineoffset] = color.color_b[0];
+            pixel_ptr[1 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[2 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[3 + nextlineoffset] = color.color_b[0];
+            pixel_ptr[4 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[5 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[6 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[7 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[8 + nextlineoffset] = color.color_b[0];
+            pixel_ptr[9 + nextlineoffset] = color.color_b[1];
+            pixel_ptr[10 + nextlineoffset] = color.color_b[2];
+            pixel_ptr[11 + nextlineoffset] = color.color_b[2];
+
+            pixel_ptr[nextlineoffset2] = color.color_b[0];
+            pixel_ptr[1 + nextlineoffset2] = color.color_b[1];
+            pixel_ptr[2 + nextlineoffset2] = color.color_b[2];
+            pixel_ptr[3 + nextlineoffset2] = color.color_b[0];
+            pixel_ptr[4 + nextlineoffset2] = color.color_b[1];
+            pixel_ptr[5 + nextlineoffset2] = color.color_b[2];
+            pixel_ptr[6 + nextlineoffset2] = color.color_b[1];
+            pixel_ptr[7 + nextlineoffset2] = color.color_b[2];
+            pixel_ptr[8 + nextlineoffset2] = color.color_b[0];
+            pixel_ptr[9 + nextlineoffset2] = color.color_b[1];
+            pixel_ptr[10 + nextlineoffset2] = color.color_b[2];
+            pixel_ptr[11 + nextlineoffset2] = color.color_b[2];
+
+            pixel_ptr[nextlineoffset3] = color.color_b[0];
+            pixel_ptr[1 + nextlineoffset3] = color.color_b[1];
+            pixel_ptr[2 + nextlineoffset3] = color.color_b[2];
+            pixel_ptr[3 + nextlineoffset3] = color.color_b[0];
+            pixel_ptr[4 + nextlineoffset3] = color.color_b[1];
+            pixel_ptr[5 + nextlineoffset3] = color.color_b[2];
+            pixel_ptr[6 + nextlineoffset3] = color.color_b[1];
+            pixel_ptr[7 + nextlineoffset3] = color.color_b[2];
+            pixel_ptr[8 + nextlineoffset3] = color.color_b[0];
+            pixel_ptr[9 + nextlineoffset3] = color.color_b[1];
+            pixel_ptr[10 + nextlineoffset3] = color.color_b[2];
+            pixel_ptr[11 + nextlineoffset3] = color.color_b[2];
           }
         }
       }
@@ -864,17 +894,15 @@ void LineExactSprites::MergeHAM2x1x32(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
           }
         }
       }
@@ -920,18 +948,16 @@ void LineExactSprites::MergeHAM2x2x32(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-              frame_ptr[nextlineoffset] = color;
-            }
-            frame_ptr++;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
+            pixel_ptr[nextlineoffset] = color;
           }
         }
       }
@@ -977,20 +1003,18 @@ void LineExactSprites::MergeHAM4x2x32(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + 2 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-              frame_ptr[1] = color;
-              frame_ptr[nextlineoffset] = color;
-              frame_ptr[1 + nextlineoffset] = color;
-            }
-            frame_ptr += 2;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + 2 * x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
+            pixel_ptr[1] = color;
+            pixel_ptr[nextlineoffset] = color;
+            pixel_ptr[1 + nextlineoffset] = color;
           }
         }
       }
@@ -1036,24 +1060,22 @@ void LineExactSprites::MergeHAM4x4x32(ULL *frameptr, graph_line *linedescription
           UBY *spr_ptr = &(item.sprite_data[first_visible_cylinder - item.sprx]);
           /* frameptr points to the first visible HAM pixel in the framebuffer */
           ULL *frame_ptr = frameptr + 2 * (first_visible_cylinder - DIW_first_visible);
-          LON pixel_count = last_visible_cylinder - first_visible_cylinder;
+          ULO pixel_count = last_visible_cylinder - first_visible_cylinder;
 
-          while (--pixel_count >= 0)
+          for (ULO opaque = MergeHAMOpaquePixels(item, first_visible_cylinder - item.sprx, pixel_count); opaque != 0; opaque &= opaque - 1)
           {
-            UBY pixel = *spr_ptr++;
-            if (pixel != 0)
-            {
-              ULL color = drawMake64BitColorFrom32Bit(graph_color_shadow[pixel >> 2]);
-              frame_ptr[0] = color;
-              frame_ptr[1] = color;
-              frame_ptr[nextlineoffset] = color;
-              frame_ptr[1 + nextlineoffset] = color;
-              frame_ptr[nextlineoffset2] = color;
-              frame_ptr[1 + nextlineoffset2] = color;
-              frame_ptr[nextlineoffset3] = color;
-              frame_ptr[1 + nextlineoffset3] = color;
-            }
-            frame_ptr += 2;
+            ULO x = MergeHAMFirstPixel(opaque);
+            UBY pixel = spr_ptr[x];
+            ULL *pixel_ptr = frame_ptr + 2 * x;
+            ULL color = drawMake64BitColorFrom32Bit(linedescription->colors[pixel >> 2]);
+            pixel_ptr[0] = color;
+            pixel_ptr[1] = color;
+            pixel_ptr[nextlineoffset] = color;
+            pixel_ptr[1 + nextlineoffset] = color;
+            pixel_ptr[nextlineoffset2] = color;
+            pixel_ptr[1 + nextlineoffset2] = color;
+            pixel_ptr[nextlineoffset3] = color;
+            pixel_ptr[1 + nextlineoffset3] = color;
           }
         }
       }
@@ -1272,7 +1294,7 @@ void LineExactSprites::ClearState()
     spr_arm_comparator[i] = FALSE;
     for (ULO j = 0; j < 2; j++)
     {
-      sprdat[i][j];
+      sprdat[i][j] = 0;
     }
     sprite_state[i] = 0;
     sprite_state_old[i] = 0;
@@ -1280,7 +1302,7 @@ void LineExactSprites::ClearState()
     sprite_online[i] = FALSE;
     for (ULO j = 0; j < 16; j++)
     {
-      sprite[i][j];
+      sprite[i][j] = 0;
     }
   }
   sprites_online = false;
@@ -1288,7 +1310,7 @@ void LineExactSprites::ClearState()
   {
     for (ULO j = 0; j < 2; j++)
     {
-      sprite_write_buffer[i][j];
+      sprite_write_buffer[i][j] = 0;
     }
   }
   sprite_write_next = 0;
@@ -1739,14 +1761,12 @@ void LineExactSprites::ProcessActionList()
 void LineExactSprites::ProcessActionListNOP()
 {
   spr_action_list_item * action_item;
-  ULO x_pos;
   ULO i, count;
   ULO sprnr = 0;
 
   sprites_online = false;
   while (sprnr < 8)
   {
-    x_pos = 0;
     sprite_online[sprnr] = FALSE;
     sprite_16col[sprnr] = FALSE;
 
@@ -1756,7 +1776,6 @@ void LineExactSprites::ProcessActionListNOP()
       action_item = ActionListGet(&spr_action_list[sprnr], i);
       // we can execute the coming action item
       (this->*(action_item->called_function))(action_item->data, action_item->address);
-      x_pos = action_item->raster_x;
     }
 
     // clear the list at the end
@@ -2470,7 +2489,8 @@ void LineExactSprites::EndOfFrame()
     ActionListClear(&spr_action_list[i]);
     ActionListClear(&spr_dma_action_list[i]);
   }
-  sprite_ham_slot_next = 0;
+  sprite_ham_slot_first = (sprite_ham_slot_first == 0) ? 313 : 0;
+  sprite_ham_slot_next = sprite_ham_slot_first;
 }
 
 
@@ -2490,12 +2510,41 @@ void LineExactSprites::EmulationStop()
 {
 }
 
+/*===========================================================================*/
+/* Save and load, DMA and the action lists start over at the end of a frame  */
+/* and are not saved.                                                        */
+/*===========================================================================*/
+
+void LineExactSprites::SaveState(savestate *S)
+{
+  savestateWriteValue(S, sprx);
+  savestateWriteValue(S, spry);
+  savestateWriteValue(S, sprly);
+  savestateWriteValue(S, spratt);
+  savestateWriteValue(S, sprdat);
+  savestateWriteValue(S, sprite_16col);
+  savestateWriteValue(S, sprite);
+}
+
+void LineExactSprites::LoadState(savestate *S)
+{
+  savestateReadValue(S, sprx);
+  savestateReadValue(S, spry);
+  savestateReadValue(S, sprly);
+  savestateReadValue(S, spratt);
+  savestateReadValue(S, sprdat);
+  savestateReadValue(S, sprite_16col);
+  savestateReadValue(S, sprite);
+}
+
 LineExactSprites::LineExactSprites()
   : Sprites(),
   sprite_to_block(0),
   output_sprite_log(FALSE),
   output_action_sprite_log(FALSE),
-  sprite_ham_slot_next(0)
+  sprite_ham_slot_first(0),
+  sprite_ham_slot_next(0),
+  ham_sse2(fellowCPUHasSSE2() == TRUE)
 {
   for (int i = 0; i < 8; i++)
   {
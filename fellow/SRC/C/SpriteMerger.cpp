@@ -9,7 +9,8 @@ void SpriteMerger::MergeLores(ULO sprite_number, UBY *playfield, UBY *sprite, UL
 
   for (ULO i = 0; i < pixel_count; ++i)
   {
-    *playfield++ = sprite_translate[in_front][*playfield][*sprite++];
+    *playfield = sprite_translate[in_front][*playfield][*sprite++];
+    playfield++;
   }
 }
 
@@ -20,8 +21,9 @@ void SpriteMerger::MergeHires(ULO sprite_number, UBY *playfield, UBY *sprite, UL
 
   for (ULO i = 0; i < pixel_count; ++i)
   {
-    *playfield++ = sprite_translate[in_front][*playfield][*sprite];
-    *playfield++ = sprite_translate[in_front][*playfield][*sprite++];
+    playfield[0] = sprite_translate[in_front][playfield[0]][*sprite];
+    playfield[1] = sprite_translate[in_front][playfield[1]][*sprite++];
+    playfield += 2;
   }
 }
 
@@ -112,26 +112,26 @@ void SpriteRegisters::ClearState()
   }
 }
 
-void SpriteRegisters::LoadState(FILE *F)
+void SpriteRegisters::LoadState(savestate *S)
 {
   for (int i = 0; i < 8; i++)
   {
-    fread(&sprpt[i], sizeof(sprpt[i]), 1, F);
-    fread(&sprpos[i], sizeof(sprpos[i]), 1, F);
-    fread(&sprctl[i], sizeof(sprctl[i]), 1, F);
-    fread(&sprdata[i], sizeof(sprdata[i]), 1, F);
-    fread(&sprdatb[i], sizeof(sprdatb[i]), 1, F);
+    savestateReadValue(S, sprpt[i]);
+    savestateReadValue(S, sprpos[i]);
+    savestateReadValue(S, sprctl[i]);
+    savestateReadValue(S, sprdata[i]);
+    savestateReadValue(S, sprdatb[i]);
   }
 }
 
-void SpriteRegisters::SaveState(FILE *F)
+void SpriteRegisters::SaveState(savestate *S)
 {
   for (int i = 0; i < 8; i++)
   {
-    fwrite(&sprpt[i], sizeof(sprpt[i]), 1, F);
-    fwrite(&sprpos[i], sizeof(sprpos[i]), 1, F);
-    fwrite(&sprctl[i], sizeof(sprctl[i]), 1, F);
-    fwrite(&sprdata[i], sizeof(sprdata[i]), 1, F);
-    fwrite(&sprdatb[i], sizeof(sprdatb[i]), 1, F);
+    savestateWriteValue(S, sprpt[i]);
+    savestateWriteValue(S, sprpos[i]);
+    savestateWriteValue(S, sprctl[i]);
+    savestateWriteValue(S, sprdata[i]);
+    savestateWriteValue(S, sprdatb[i]);
   }
 }
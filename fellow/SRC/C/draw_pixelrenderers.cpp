@@ -24,511 +24,14 @@
 /*=========================================================================*/
 
 #include "DEFS.H"
+#include "FELLOW.H"
 #include "GRAPH.H"
 #include "DRAW.H"
 #include "draw_interlace_control.h"
 #include "LineExactSprites.h"
+#include "profiler.h"
 
-#ifdef DRAW_TSC_PROFILE
-#include "fileops.h"
-#endif
-
-/* 
-Enable this for detailed profiling, log written to drawprofile.txt
-It can be imported into excel for better viewing
-*/
-
-//#define DRAW_TSC_PROFILE
-#ifdef DRAW_TSC_PROFILE
-
-// variables for holding profile data on background lines
-
-LLO dlsbg2x1_16bit_tmp = 0;
-LLO dlsbg2x1_16bit = 0;
-LON dlsbg2x1_16bit_times = 0;
-LON dlsbg2x1_16bit_pixels = 0;
-
-LLO dlsbg2x2_16bit_tmp = 0;
-LLO dlsbg2x2_16bit = 0;
-LON dlsbg2x2_16bit_times = 0;
-LON dlsbg2x2_16bit_pixels = 0;
-
-LLO dlsbg4x2_16bit_tmp = 0;
-LLO dlsbg4x2_16bit = 0;
-LON dlsbg4x2_16bit_times = 0;
-LON dlsbg4x2_16bit_pixels = 0;
-
-LLO dlsbg4x4_16bit_tmp = 0;
-LLO dlsbg4x4_16bit = 0;
-LON dlsbg4x4_16bit_times = 0;
-LON dlsbg4x4_16bit_pixels = 0;
-
-LLO dlsbg2x1_24bit_tmp = 0;
-LLO dlsbg2x1_24bit = 0;
-LON dlsbg2x1_24bit_times = 0;
-LON dlsbg2x1_24bit_pixels = 0;
-
-LLO dlsbg2x2_24bit_tmp = 0;
-LLO dlsbg2x2_24bit = 0;
-LON dlsbg2x2_24bit_times = 0;
-LON dlsbg2x2_24bit_pixels = 0;
-
-LLO dlsbg4x2_24bit_tmp = 0;
-LLO dlsbg4x2_24bit = 0;
-LON dlsbg4x2_24bit_times = 0;
-LON dlsbg4x2_24bit_pixels = 0;
-
-LLO dlsbg4x4_24bit_tmp = 0;
-LLO dlsbg4x4_24bit = 0;
-LON dlsbg4x4_24bit_times = 0;
-LON dlsbg4x4_24bit_pixels = 0;
-
-LLO dlsbg2x1_32bit_tmp = 0;
-LLO dlsbg2x1_32bit = 0;
-LON dlsbg2x1_32bit_times = 0;
-LON dlsbg2x1_32bit_pixels = 0;
-
-LLO dlsbg2x2_32bit_tmp = 0;
-LLO dlsbg2x2_32bit = 0;
-LON dlsbg2x2_32bit_times = 0;
-LON dlsbg2x2_32bit_pixels = 0;
-
-LLO dlsbg4x2_32bit_tmp = 0;
-LLO dlsbg4x2_32bit = 0;
-LON dlsbg4x2_32bit_times = 0;
-LON dlsbg4x2_32bit_pixels = 0;
-
-LLO dlsbg4x4_32bit_tmp = 0;
-LLO dlsbg4x4_32bit = 0;
-LON dlsbg4x4_32bit_times = 0;
-LON dlsbg4x4_32bit_pixels = 0;
-
-// variables for holding profile data on normal line drawing
-
-LLO dln1x1_16bit_tmp = 0;
-LLO dln1x1_16bit = 0;
-LON dln1x1_16bit_times = 0;
-LON dln1x1_16bit_pixels = 0;
-
-LLO dln2x1_16bit_tmp = 0;
-LLO dln2x1_16bit = 0;
-LON dln2x1_16bit_times = 0;
-LON dln2x1_16bit_pixels = 0;
-
-LLO dln1x2_16bit_tmp = 0;
-LLO dln1x2_16bit = 0;
-LON dln1x2_16bit_times = 0;
-LON dln1x2_16bit_pixels = 0;
-
-LLO dln2x2_16bit_tmp = 0;
-LLO dln2x2_16bit = 0;
-LON dln2x2_16bit_times = 0;
-LON dln2x2_16bit_pixels = 0;
-
-LLO dln2x4_16bit_tmp = 0;
-LLO dln2x4_16bit = 0;
-LON dln2x4_16bit_times = 0;
-LON dln2x4_16bit_pixels = 0;
-
-LLO dln4x2_16bit_tmp = 0;
-LLO dln4x2_16bit = 0;
-LON dln4x2_16bit_times = 0;
-LON dln4x2_16bit_pixels = 0;
-
-LLO dln4x4_16bit_tmp = 0;
-LLO dln4x4_16bit = 0;
-LON dln4x4_16bit_times = 0;
-LON dln4x4_16bit_pixels = 0;
-
-LLO dln1x1_24bit_tmp = 0;
-LLO dln1x1_24bit = 0;
-LON dln1x1_24bit_times = 0;
-LON dln1x1_24bit_pixels = 0;
-
-LLO dln2x1_24bit_tmp = 0;
-LLO dln2x1_24bit = 0;
-LON dln2x1_24bit_times = 0;
-LON dln2x1_24bit_pixels = 0;
-
-LLO dln1x2_24bit_tmp = 0;
-LLO dln1x2_24bit = 0;
-LON dln1x2_24bit_times = 0;
-LON dln1x2_24bit_pixels = 0;
-
-LLO dln2x2_24bit_tmp = 0;
-LLO dln2x2_24bit = 0;
-LON dln2x2_24bit_times = 0;
-LON dln2x2_24bit_pixels = 0;
-
-LLO dln2x4_24bit_tmp = 0;
-LLO dln2x4_24bit = 0;
-LON dln2x4_24bit_times = 0;
-LON dln2x4_24bit_pixels = 0;
-
-LLO dln4x2_24bit_tmp = 0;
-LLO dln4x2_24bit = 0;
-LON dln4x2_24bit_times = 0;
-LON dln4x2_24bit_pixels = 0;
-
-LLO dln4x4_24bit_tmp = 0;
-LLO dln4x4_24bit = 0;
-LON dln4x4_24bit_times = 0;
-LON dln4x4_24bit_pixels = 0;
-
-LLO dln1x1_32bit_tmp = 0;
-LLO dln1x1_32bit = 0;
-LON dln1x1_32bit_times = 0;
-LON dln1x1_32bit_pixels = 0;
-
-LLO dln2x1_32bit_tmp = 0;
-LLO dln2x1_32bit = 0;
-LON dln2x1_32bit_times = 0;
-LON dln2x1_32bit_pixels = 0;
-
-LLO dln1x2_32bit_tmp = 0;
-LLO dln1x2_32bit = 0;
-LON dln1x2_32bit_times = 0;
-LON dln1x2_32bit_pixels = 0;
-
-LLO dln2x2_32bit_tmp = 0;
-LLO dln2x2_32bit = 0;
-LON dln2x2_32bit_times = 0;
-LON dln2x2_32bit_pixels = 0;
-
-LLO dln2x4_32bit_tmp = 0;
-LLO dln2x4_32bit = 0;
-LON dln2x4_32bit_times = 0;
-LON dln2x4_32bit_pixels = 0;
-
-LLO dln4x2_32bit_tmp = 0;
-LLO dln4x2_32bit = 0;
-LON dln4x2_32bit_times = 0;
-LON dln4x2_32bit_pixels = 0;
-
-LLO dln4x4_32bit_tmp = 0;
-LLO dln4x4_32bit = 0;
-LON dln4x4_32bit_times = 0;
-LON dln4x4_32bit_pixels = 0;
-
-// variables for holding profile data on dual playfield line drawing
-
-LLO dld1x1_16bit_tmp = 0;
-LLO dld1x1_16bit = 0;
-LON dld1x1_16bit_times = 0;
-LON dld1x1_16bit_pixels = 0;
-
-LLO dld2x1_16bit_tmp = 0;
-LLO dld2x1_16bit = 0;
-LON dld2x1_16bit_times = 0;
-LON dld2x1_16bit_pixels = 0;
-
-LLO dld1x2_16bit_tmp = 0;
-LLO dld1x2_16bit = 0;
-LON dld1x2_16bit_times = 0;
-LON dld1x2_16bit_pixels = 0;
-
-LLO dld2x2_16bit_tmp = 0;
-LLO dld2x2_16bit = 0;
-LON dld2x2_16bit_times = 0;
-LON dld2x2_16bit_pixels = 0;
-
-LLO dld2x4_16bit_tmp = 0;
-LLO dld2x4_16bit = 0;
-LON dld2x4_16bit_times = 0;
-LON dld2x4_16bit_pixels = 0;
-
-LLO dld4x2_16bit_tmp = 0;
-LLO dld4x2_16bit = 0;
-LON dld4x2_16bit_times = 0;
-LON dld4x2_16bit_pixels = 0;
-
-LLO dld4x4_16bit_tmp = 0;
-LLO dld4x4_16bit = 0;
-LON dld4x4_16bit_times = 0;
-LON dld4x4_16bit_pixels = 0;
-
-LLO dld1x1_24bit_tmp = 0;
-LLO dld1x1_24bit = 0;
-LON dld1x1_24bit_times = 0;
-LON dld1x1_24bit_pixels = 0;
-
-LLO dld2x1_24bit_tmp = 0;
-LLO dld2x1_24bit = 0;
-LON dld2x1_24bit_times = 0;
-LON dld2x1_24bit_pixels = 0;
-
-LLO dld1x2_24bit_tmp = 0;
-LLO dld1x2_24bit = 0;
-LON dld1x2_24bit_times = 0;
-LON dld1x2_24bit_pixels = 0;
-
-LLO dld2x2_24bit_tmp = 0;
-LLO dld2x2_24bit = 0;
-LON dld2x2_24bit_times = 0;
-LON dld2x2_24bit_pixels = 0;
-
-LLO dld2x4_24bit_tmp = 0;
-LLO dld2x4_24bit = 0;
-LON dld2x4_24bit_times = 0;
-LON dld2x4_24bit_pixels = 0;
-
-LLO dld4x2_24bit_tmp = 0;
-LLO dld4x2_24bit = 0;
-LON dld4x2_24bit_times = 0;
-LON dld4x2_24bit_pixels = 0;
-
-LLO dld4x4_24bit_tmp = 0;
-LLO dld4x4_24bit = 0;
-LON dld4x4_24bit_times = 0;
-LON dld4x4_24bit_pixels = 0;
-
-LLO dld1x1_32bit_tmp = 0;
-LLO dld1x1_32bit = 0;
-LON dld1x1_32bit_times = 0;
-LON dld1x1_32bit_pixels = 0;
-
-LLO dld2x1_32bit_tmp = 0;
-LLO dld2x1_32bit = 0;
-LON dld2x1_32bit_times = 0;
-LON dld2x1_32bit_pixels = 0;
-
-LLO dld1x2_32bit_tmp = 0;
-LLO dld1x2_32bit = 0;
-LON dld1x2_32bit_times = 0;
-LON dld1x2_32bit_pixels = 0;
-
-LLO dld2x2_32bit_tmp = 0;
-LLO dld2x2_32bit = 0;
-LON dld2x2_32bit_times = 0;
-LON dld2x2_32bit_pixels = 0;
-
-LLO dld2x4_32bit_tmp = 0;
-LLO dld2x4_32bit = 0;
-LON dld2x4_32bit_times = 0;
-LON dld2x4_32bit_pixels = 0;
-
-LLO dld4x2_32bit_tmp = 0;
-LLO dld4x2_32bit = 0;
-LON dld4x2_32bit_times = 0;
-LON dld4x2_32bit_pixels = 0;
-
-LLO dld4x4_32bit_tmp = 0;
-LLO dld4x4_32bit = 0;
-LON dld4x4_32bit_times = 0;
-LON dld4x4_32bit_pixels = 0;
-
-// variables for holding profile data on HAM line drawing
-
-LLO dlh2x1_16bit_tmp = 0;
-LLO dlh2x1_16bit = 0;
-LON dlh2x1_16bit_times = 0;
-LON dlh2x1_16bit_pixels = 0;
-
-LLO dlh2x2_16bit_tmp = 0;
-LLO dlh2x2_16bit = 0;
-LON dlh2x2_16bit_times = 0;
-LON dlh2x2_16bit_pixels = 0;
-
-LLO dlh4x2_16bit_tmp = 0;
-LLO dlh4x2_16bit = 0;
-LON dlh4x2_16bit_times = 0;
-LON dlh4x2_16bit_pixels = 0;
-
-LLO dlh4x4_16bit_tmp = 0;
-LLO dlh4x4_16bit = 0;
-LON dlh4x4_16bit_times = 0;
-LON dlh4x4_16bit_pixels = 0;
-
-LLO dlh2x1_24bit_tmp = 0;
-LLO dlh2x1_24bit = 0;
-LON dlh2x1_24bit_times = 0;
-LON dlh2x1_24bit_pixels = 0;
-
-LLO dlh2x2_24bit_tmp = 0;
-LLO dlh2x2_24bit = 0;
-LON dlh2x2_24bit_times = 0;
-LON dlh2x2_24bit_pixels = 0;
-
-LLO dlh4x2_24bit_tmp = 0;
-LLO dlh4x2_24bit = 0;
-LON dlh4x2_24bit_times = 0;
-LON dlh4x2_24bit_pixels = 0;
-
-LLO dlh4x4_24bit_tmp = 0;
-LLO dlh4x4_24bit = 0;
-LON dlh4x4_24bit_times = 0;
-LON dlh4x4_24bit_pixels = 0;
-
-LLO dlh2x1_32bit_tmp = 0;
-LLO dlh2x1_32bit = 0;
-LON dlh2x1_32bit_times = 0;
-LON dlh2x1_32bit_pixels = 0;
-
-LLO dlh2x2_32bit_tmp = 0;
-LLO dlh2x2_32bit = 0;
-LON dlh2x2_32bit_times = 0;
-LON dlh2x2_32bit_pixels = 0;
-
-LLO dlh4x2_32bit_tmp = 0;
-LLO dlh4x2_32bit = 0;
-LON dlh4x2_32bit_times = 0;
-LON dlh4x2_32bit_pixels = 0;
-
-LLO dlh4x4_32bit_tmp = 0;
-LLO dlh4x4_32bit = 0;
-LON dlh4x4_32bit_times = 0;
-LON dlh4x4_32bit_pixels = 0;
-
-/*============================================================================*/
-/* profiling help functions                                                   */
-/*============================================================================*/
-
-static __inline void drawTscBefore(LLO* a)
-{
-  LLO local_a = *a;
-  __asm 
-  {
-    push    eax
-    push    edx
-    push    ecx
-    mov     ecx,10h
-    rdtsc
-    pop     ecx
-    mov     dword ptr [local_a], eax
-    mov     dword ptr [local_a + 4], edx
-    pop     edx
-    pop     eax
-  }
-  *a = local_a;
-}
-
-static __inline void drawTscAfter(LLO* a, LLO* b, LON* c)
-{
-  LLO local_a = *a;
-  LLO local_b = *b;
-  LON local_c = *c;
-
-  __asm 
-  {
-    push    eax
-    push    edx
-    push    ecx
-    mov     ecx, 10h
-    rdtsc
-    pop     ecx
-    sub     eax, dword ptr [local_a]
-    sbb     edx, dword ptr [local_a + 4]
-    add     dword ptr [local_b], eax
-    adc     dword ptr [local_b + 4], edx
-    inc     dword ptr [local_c]
-    pop     edx
-    pop     eax
-  }
-  *a = local_a;
-  *b = local_b;
-  *c = local_c;
-}
-
-#endif
-
-void drawWriteProfilingResultsToFile(void)
-{
-#ifdef DRAW_TSC_PROFILE
-  char filename[MAX_PATH];
-
-  fileopsGetGenericFileName(filename, "WinFellow", "drawprofile.txt");
-  FILE *F = fopen(filename, "w");
-  fprintf(F, "FUNCTION\tTOTALCYCLES\tCALLEDCOUNT\tAVGCYCLESPERCALL\tTOTALPIXELS\tPIXELSPERCALL\tCYCLESPERPIXEL\n");
-
-  // drawing background lines
-
-  fprintf(F, "drawLineBG2x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x1_16bit, dlsbg2x1_16bit_times, (dlsbg2x1_16bit_times == 0) ? 0 : (dlsbg2x1_16bit / dlsbg2x1_16bit_times), dlsbg2x1_16bit_pixels, (dlsbg2x1_16bit_times == 0) ? 0 : (dlsbg2x1_16bit_pixels / dlsbg2x1_16bit_times), (dlsbg2x1_16bit_pixels == 0) ? 0 : (dlsbg2x1_16bit / dlsbg2x1_16bit_pixels));
-  fprintf(F, "drawLineBG2x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x2_16bit, dlsbg2x2_16bit_times, (dlsbg2x2_16bit_times == 0) ? 0 : (dlsbg2x2_16bit / dlsbg2x2_16bit_times), dlsbg2x2_16bit_pixels, (dlsbg2x2_16bit_times == 0) ? 0 : (dlsbg2x2_16bit_pixels / dlsbg2x2_16bit_times), (dlsbg2x2_16bit_pixels == 0) ? 0 : (dlsbg2x2_16bit / dlsbg2x2_16bit_pixels));
-  fprintf(F, "drawLineBG4x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x2_16bit, dlsbg4x2_16bit_times, (dlsbg4x2_16bit_times == 0) ? 0 : (dlsbg4x2_16bit / dlsbg4x2_16bit_times), dlsbg4x2_16bit_pixels, (dlsbg4x2_16bit_times == 0) ? 0 : (dlsbg4x2_16bit_pixels / dlsbg4x2_16bit_times), (dlsbg4x2_16bit_pixels == 0) ? 0 : (dlsbg4x2_16bit / dlsbg4x2_16bit_pixels));
-  fprintf(F, "drawLineBG4x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x4_16bit, dlsbg4x4_16bit_times, (dlsbg4x4_16bit_times == 0) ? 0 : (dlsbg4x4_16bit / dlsbg4x4_16bit_times), dlsbg4x4_16bit_pixels, (dlsbg4x4_16bit_times == 0) ? 0 : (dlsbg4x4_16bit_pixels / dlsbg4x4_16bit_times), (dlsbg4x4_16bit_pixels == 0) ? 0 : (dlsbg4x4_16bit / dlsbg4x4_16bit_pixels));
-
-  fprintf(F, "drawLineBG2x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x1_24bit, dlsbg2x1_24bit_times, (dlsbg2x1_24bit_times == 0) ? 0 : (dlsbg2x1_24bit / dlsbg2x1_24bit_times), dlsbg2x1_24bit_pixels, (dlsbg2x1_24bit_times == 0) ? 0 : (dlsbg2x1_24bit_pixels / dlsbg2x1_24bit_times), (dlsbg2x1_24bit_pixels == 0) ? 0 : (dlsbg2x1_24bit / dlsbg2x1_24bit_pixels));
-  fprintf(F, "drawLineBG2x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x2_24bit, dlsbg2x2_24bit_times, (dlsbg2x2_24bit_times == 0) ? 0 : (dlsbg2x2_24bit / dlsbg2x2_24bit_times), dlsbg2x2_24bit_pixels, (dlsbg2x2_24bit_times == 0) ? 0 : (dlsbg2x2_24bit_pixels / dlsbg2x2_24bit_times), (dlsbg2x2_24bit_pixels == 0) ? 0 : (dlsbg2x2_24bit / dlsbg2x2_24bit_pixels));
-  fprintf(F, "drawLineBG4x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x2_24bit, dlsbg4x2_24bit_times, (dlsbg4x2_24bit_times == 0) ? 0 : (dlsbg4x2_24bit / dlsbg4x2_24bit_times), dlsbg4x2_24bit_pixels, (dlsbg4x2_24bit_times == 0) ? 0 : (dlsbg4x2_24bit_pixels / dlsbg4x2_24bit_times), (dlsbg4x2_24bit_pixels == 0) ? 0 : (dlsbg4x2_24bit / dlsbg4x2_24bit_pixels));
-  fprintf(F, "drawLineBG4x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x4_24bit, dlsbg4x4_24bit_times, (dlsbg4x4_24bit_times == 0) ? 0 : (dlsbg4x4_24bit / dlsbg4x4_24bit_times), dlsbg4x4_24bit_pixels, (dlsbg4x4_24bit_times == 0) ? 0 : (dlsbg4x4_24bit_pixels / dlsbg4x4_24bit_times), (dlsbg4x4_24bit_pixels == 0) ? 0 : (dlsbg4x4_24bit / dlsbg4x4_24bit_pixels));
-
-  fprintf(F, "drawLineBG2x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x1_32bit, dlsbg2x1_32bit_times, (dlsbg2x1_32bit_times == 0) ? 0 : (dlsbg2x1_32bit / dlsbg2x1_32bit_times), dlsbg2x1_32bit_pixels, (dlsbg2x1_32bit_times == 0) ? 0 : (dlsbg2x1_32bit_pixels / dlsbg2x1_32bit_times), (dlsbg2x1_32bit_pixels == 0) ? 0 : (dlsbg2x1_32bit / dlsbg2x1_32bit_pixels));
-  fprintf(F, "drawLineBG2x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg2x2_32bit, dlsbg2x2_32bit_times, (dlsbg2x2_32bit_times == 0) ? 0 : (dlsbg2x2_32bit / dlsbg2x2_32bit_times), dlsbg2x2_32bit_pixels, (dlsbg2x2_32bit_times == 0) ? 0 : (dlsbg2x2_32bit_pixels / dlsbg2x2_32bit_times), (dlsbg2x2_32bit_pixels == 0) ? 0 : (dlsbg2x2_32bit / dlsbg2x2_32bit_pixels));
-  fprintf(F, "drawLineBG4x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x2_32bit, dlsbg4x2_32bit_times, (dlsbg4x2_32bit_times == 0) ? 0 : (dlsbg4x2_32bit / dlsbg4x2_32bit_times), dlsbg4x2_32bit_pixels, (dlsbg4x2_32bit_times == 0) ? 0 : (dlsbg4x2_32bit_pixels / dlsbg4x2_32bit_times), (dlsbg4x2_32bit_pixels == 0) ? 0 : (dlsbg4x2_32bit / dlsbg4x2_32bit_pixels));
-  fprintf(F, "drawLineBG4x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlsbg4x4_32bit, dlsbg4x4_32bit_times, (dlsbg4x4_32bit_times == 0) ? 0 : (dlsbg4x4_32bit / dlsbg4x4_32bit_times), dlsbg4x4_32bit_pixels, (dlsbg4x4_32bit_times == 0) ? 0 : (dlsbg4x4_32bit_pixels / dlsbg4x4_32bit_times), (dlsbg4x4_32bit_pixels == 0) ? 0 : (dlsbg4x4_32bit / dlsbg4x4_32bit_pixels));
-
-  // drawing normal lines
-
-  fprintf(F, "drawLineNormal1x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x1_16bit, dln1x1_16bit_times, (dln1x1_16bit_times == 0) ? 0 : (dln1x1_16bit / dln1x1_16bit_times), dln1x1_16bit_pixels, (dln1x1_16bit_times == 0) ? 0 : (dln1x1_16bit_pixels / dln1x1_16bit_times), (dln1x1_16bit_pixels == 0) ? 0 : (dln1x1_16bit / dln1x1_16bit_pixels));
-  fprintf(F, "drawLineNormal1x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x2_16bit, dln1x2_16bit_times, (dln1x2_16bit_times == 0) ? 0 : (dln1x2_16bit / dln1x2_16bit_times), dln1x2_16bit_pixels, (dln1x2_16bit_times == 0) ? 0 : (dln1x2_16bit_pixels / dln1x2_16bit_times), (dln1x2_16bit_pixels == 0) ? 0 : (dln1x2_16bit / dln1x2_16bit_pixels));
-  fprintf(F, "drawLineNormal2x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x1_16bit, dln2x1_16bit_times, (dln2x1_16bit_times == 0) ? 0 : (dln2x1_16bit / dln2x1_16bit_times), dln2x1_16bit_pixels, (dln2x1_16bit_times == 0) ? 0 : (dln2x1_16bit_pixels / dln2x1_16bit_times), (dln2x1_16bit_pixels == 0) ? 0 : (dln2x1_16bit / dln2x1_16bit_pixels));
-  fprintf(F, "drawLineNormal2x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x2_16bit, dln2x2_16bit_times, (dln2x2_16bit_times == 0) ? 0 : (dln2x2_16bit / dln2x2_16bit_times), dln2x2_16bit_pixels, (dln2x2_16bit_times == 0) ? 0 : (dln2x2_16bit_pixels / dln2x2_16bit_times), (dln2x2_16bit_pixels == 0) ? 0 : (dln2x2_16bit / dln2x2_16bit_pixels));
-  fprintf(F, "drawLineNormal2x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x4_16bit, dln2x4_16bit_times, (dln2x4_16bit_times == 0) ? 0 : (dln2x4_16bit / dln2x4_16bit_times), dln2x4_16bit_pixels, (dln2x4_16bit_times == 0) ? 0 : (dln2x4_16bit_pixels / dln2x4_16bit_times), (dln2x4_16bit_pixels == 0) ? 0 : (dln2x4_16bit / dln2x4_16bit_pixels));
-  fprintf(F, "drawLineNormal4x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x2_16bit, dln4x2_16bit_times, (dln4x2_16bit_times == 0) ? 0 : (dln4x2_16bit / dln4x2_16bit_times), dln4x2_16bit_pixels, (dln4x2_16bit_times == 0) ? 0 : (dln4x2_16bit_pixels / dln4x2_16bit_times), (dln4x2_16bit_pixels == 0) ? 0 : (dln4x2_16bit / dln4x2_16bit_pixels));
-  fprintf(F, "drawLineNormal4x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x4_16bit, dln4x4_16bit_times, (dln4x4_16bit_times == 0) ? 0 : (dln4x4_16bit / dln4x4_16bit_times), dln4x4_16bit_pixels, (dln4x4_16bit_times == 0) ? 0 : (dln4x4_16bit_pixels / dln4x4_16bit_times), (dln4x4_16bit_pixels == 0) ? 0 : (dln4x4_16bit / dln4x4_16bit_pixels));
-
-  fprintf(F, "drawLineNormal1x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x1_24bit, dln1x1_24bit_times, (dln1x1_24bit_times == 0) ? 0 : (dln1x1_24bit / dln1x1_24bit_times), dln1x1_24bit_pixels, (dln1x1_24bit_times == 0) ? 0 : (dln1x1_24bit_pixels / dln1x1_24bit_times), (dln1x1_24bit_pixels == 0) ? 0 : (dln1x1_24bit / dln1x1_24bit_pixels));
-  fprintf(F, "drawLineNormal1x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x2_24bit, dln1x2_24bit_times, (dln1x2_24bit_times == 0) ? 0 : (dln1x2_24bit / dln1x2_24bit_times), dln1x2_24bit_pixels, (dln1x2_24bit_times == 0) ? 0 : (dln1x2_24bit_pixels / dln1x2_24bit_times), (dln1x2_24bit_pixels == 0) ? 0 : (dln1x2_24bit / dln1x2_24bit_pixels));
-  fprintf(F, "drawLineNormal2x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x1_24bit, dln2x1_24bit_times, (dln2x1_24bit_times == 0) ? 0 : (dln2x1_24bit / dln2x1_24bit_times), dln2x1_24bit_pixels, (dln2x1_24bit_times == 0) ? 0 : (dln2x1_24bit_pixels / dln2x1_24bit_times), (dln2x1_24bit_pixels == 0) ? 0 : (dln2x1_24bit / dln2x1_24bit_pixels));
-  fprintf(F, "drawLineNormal2x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x2_24bit, dln2x2_24bit_times, (dln2x2_24bit_times == 0) ? 0 : (dln2x2_24bit / dln2x2_24bit_times), dln2x2_24bit_pixels, (dln2x2_24bit_times == 0) ? 0 : (dln2x2_24bit_pixels / dln2x2_24bit_times), (dln2x2_24bit_pixels == 0) ? 0 : (dln2x2_24bit / dln2x2_24bit_pixels));
-  fprintf(F, "drawLineNormal2x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x4_24bit, dln2x4_24bit_times, (dln2x4_24bit_times == 0) ? 0 : (dln2x4_24bit / dln2x4_24bit_times), dln2x4_24bit_pixels, (dln2x4_24bit_times == 0) ? 0 : (dln2x4_24bit_pixels / dln2x4_24bit_times), (dln2x4_24bit_pixels == 0) ? 0 : (dln2x4_24bit / dln2x4_24bit_pixels));
-  fprintf(F, "drawLineNormal4x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x2_24bit, dln4x2_24bit_times, (dln4x2_24bit_times == 0) ? 0 : (dln4x2_24bit / dln4x2_24bit_times), dln4x2_24bit_pixels, (dln4x2_24bit_times == 0) ? 0 : (dln4x2_24bit_pixels / dln4x2_24bit_times), (dln4x2_24bit_pixels == 0) ? 0 : (dln4x2_24bit / dln4x2_24bit_pixels));
-  fprintf(F, "drawLineNormal4x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x4_24bit, dln4x4_24bit_times, (dln4x4_24bit_times == 0) ? 0 : (dln4x4_24bit / dln4x4_24bit_times), dln4x4_24bit_pixels, (dln4x4_24bit_times == 0) ? 0 : (dln4x4_24bit_pixels / dln4x4_24bit_times), (dln4x4_24bit_pixels == 0) ? 0 : (dln4x4_24bit / dln4x4_24bit_pixels));
-
-  fprintf(F, "drawLineNormal1x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x1_32bit, dln1x1_32bit_times, (dln1x1_32bit_times == 0) ? 0 : (dln1x1_32bit / dln1x1_32bit_times), dln1x1_32bit_pixels, (dln1x1_32bit_times == 0) ? 0 : (dln1x1_32bit_pixels / dln1x1_32bit_times), (dln1x1_32bit_pixels == 0) ? 0 : (dln1x1_32bit / dln1x1_32bit_pixels));
-  fprintf(F, "drawLineNormal1x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln1x2_32bit, dln1x2_32bit_times, (dln1x2_32bit_times == 0) ? 0 : (dln1x2_32bit / dln1x2_32bit_times), dln1x2_32bit_pixels, (dln1x2_32bit_times == 0) ? 0 : (dln1x2_32bit_pixels / dln1x2_32bit_times), (dln1x2_32bit_pixels == 0) ? 0 : (dln1x2_32bit / dln1x2_32bit_pixels));
-  fprintf(F, "drawLineNormal2x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x1_32bit, dln2x1_32bit_times, (dln2x1_32bit_times == 0) ? 0 : (dln2x1_32bit / dln2x1_32bit_times), dln2x1_32bit_pixels, (dln2x1_32bit_times == 0) ? 0 : (dln2x1_32bit_pixels / dln2x1_32bit_times), (dln2x1_32bit_pixels == 0) ? 0 : (dln2x1_32bit / dln2x1_32bit_pixels));
-  fprintf(F, "drawLineNormal2x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x2_32bit, dln2x2_32bit_times, (dln2x2_32bit_times == 0) ? 0 : (dln2x2_32bit / dln2x2_32bit_times), dln2x2_32bit_pixels, (dln2x2_32bit_times == 0) ? 0 : (dln2x2_32bit_pixels / dln2x2_32bit_times), (dln2x2_32bit_pixels == 0) ? 0 : (dln2x2_32bit / dln2x2_32bit_pixels));
-  fprintf(F, "drawLineNormal2x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln2x4_32bit, dln2x4_32bit_times, (dln2x4_32bit_times == 0) ? 0 : (dln2x4_32bit / dln2x4_32bit_times), dln2x4_32bit_pixels, (dln2x4_32bit_times == 0) ? 0 : (dln2x4_32bit_pixels / dln2x4_32bit_times), (dln2x4_32bit_pixels == 0) ? 0 : (dln2x4_32bit / dln2x4_32bit_pixels));
-  fprintf(F, "drawLineNormal4x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x2_32bit, dln4x2_32bit_times, (dln4x2_32bit_times == 0) ? 0 : (dln4x2_32bit / dln4x2_32bit_times), dln4x2_32bit_pixels, (dln4x2_32bit_times == 0) ? 0 : (dln4x2_32bit_pixels / dln4x2_32bit_times), (dln4x2_32bit_pixels == 0) ? 0 : (dln4x2_32bit / dln4x2_32bit_pixels));
-  fprintf(F, "drawLineNormal4x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dln4x4_32bit, dln4x4_32bit_times, (dln4x4_32bit_times == 0) ? 0 : (dln4x4_32bit / dln4x4_32bit_times), dln4x4_32bit_pixels, (dln4x4_32bit_times == 0) ? 0 : (dln4x4_32bit_pixels / dln4x4_32bit_times), (dln4x4_32bit_pixels == 0) ? 0 : (dln4x4_32bit / dln4x4_32bit_pixels));
-
-  // drawing dual playfield lines
-
-  fprintf(F, "drawLineDual1x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x1_16bit, dld1x1_16bit_times, (dld1x1_16bit_times == 0) ? 0 : (dld1x1_16bit / dld1x1_16bit_times), dld1x1_16bit_pixels, (dld1x1_16bit_times == 0) ? 0 : (dld1x1_16bit_pixels / dld1x1_16bit_times), (dld1x1_16bit_pixels == 0) ? 0 : (dld1x1_16bit / dld1x1_16bit_pixels));
-  fprintf(F, "drawLineDual1x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x2_16bit, dld1x2_16bit_times, (dld1x2_16bit_times == 0) ? 0 : (dld1x2_16bit / dld1x2_16bit_times), dld1x2_16bit_pixels, (dld1x2_16bit_times == 0) ? 0 : (dld1x2_16bit_pixels / dld1x2_16bit_times), (dld1x2_16bit_pixels == 0) ? 0 : (dld1x2_16bit / dld1x2_16bit_pixels));
-  fprintf(F, "drawLineDual2x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x1_16bit, dld2x1_16bit_times, (dld2x1_16bit_times == 0) ? 0 : (dld2x1_16bit / dld2x1_16bit_times), dld2x1_16bit_pixels, (dld2x1_16bit_times == 0) ? 0 : (dld2x1_16bit_pixels / dld2x1_16bit_times), (dld2x1_16bit_pixels == 0) ? 0 : (dld2x1_16bit / dld2x1_16bit_pixels));
-  fprintf(F, "drawLineDual2x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x2_16bit, dld2x2_16bit_times, (dld2x2_16bit_times == 0) ? 0 : (dld2x2_16bit / dld2x2_16bit_times), dld2x2_16bit_pixels, (dld2x2_16bit_times == 0) ? 0 : (dld2x2_16bit_pixels / dld2x2_16bit_times), (dld2x2_16bit_pixels == 0) ? 0 : (dld2x2_16bit / dld2x2_16bit_pixels));
-  fprintf(F, "drawLineDual2x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x4_16bit, dld2x4_16bit_times, (dld2x4_16bit_times == 0) ? 0 : (dld2x4_16bit / dld2x4_16bit_times), dld2x4_16bit_pixels, (dld2x4_16bit_times == 0) ? 0 : (dld2x4_16bit_pixels / dld2x4_16bit_times), (dld2x4_16bit_pixels == 0) ? 0 : (dld2x4_16bit / dld2x4_16bit_pixels));
-  fprintf(F, "drawLineDual4x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x2_16bit, dld4x2_16bit_times, (dld4x2_16bit_times == 0) ? 0 : (dld4x2_16bit / dld4x2_16bit_times), dld4x2_16bit_pixels, (dld4x2_16bit_times == 0) ? 0 : (dld4x2_16bit_pixels / dld4x2_16bit_times), (dld4x2_16bit_pixels == 0) ? 0 : (dld4x2_16bit / dld4x2_16bit_pixels));
-  fprintf(F, "drawLineDual4x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x4_16bit, dld4x4_16bit_times, (dld4x4_16bit_times == 0) ? 0 : (dld4x4_16bit / dld4x4_16bit_times), dld4x4_16bit_pixels, (dld4x4_16bit_times == 0) ? 0 : (dld4x4_16bit_pixels / dld4x4_16bit_times), (dld4x4_16bit_pixels == 0) ? 0 : (dld4x4_16bit / dld4x4_16bit_pixels));
-
-  fprintf(F, "drawLineDual1x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x1_24bit, dld1x1_24bit_times, (dld1x1_24bit_times == 0) ? 0 : (dld1x1_24bit / dld1x1_24bit_times), dld1x1_24bit_pixels, (dld1x1_24bit_times == 0) ? 0 : (dld1x1_24bit_pixels / dld1x1_24bit_times), (dld1x1_24bit_pixels == 0) ? 0 : (dld1x1_24bit / dld1x1_24bit_pixels));
-  fprintf(F, "drawLineDual1x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x2_24bit, dld1x2_24bit_times, (dld1x2_24bit_times == 0) ? 0 : (dld1x2_24bit / dld1x2_24bit_times), dld1x2_24bit_pixels, (dld1x2_24bit_times == 0) ? 0 : (dld1x2_24bit_pixels / dld1x2_24bit_times), (dld1x2_24bit_pixels == 0) ? 0 : (dld1x2_24bit / dld1x2_24bit_pixels));
-  fprintf(F, "drawLineDual2x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x1_24bit, dld2x1_24bit_times, (dld2x1_24bit_times == 0) ? 0 : (dld2x1_24bit / dld2x1_24bit_times), dld2x1_24bit_pixels, (dld2x1_24bit_times == 0) ? 0 : (dld2x1_24bit_pixels / dld2x1_24bit_times), (dld2x1_24bit_pixels == 0) ? 0 : (dld2x1_24bit / dld2x1_24bit_pixels));
-  fprintf(F, "drawLineDual2x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x2_24bit, dld2x2_24bit_times, (dld2x2_24bit_times == 0) ? 0 : (dld2x2_24bit / dld2x2_24bit_times), dld2x2_24bit_pixels, (dld2x2_24bit_times == 0) ? 0 : (dld2x2_24bit_pixels / dld2x2_24bit_times), (dld2x2_24bit_pixels == 0) ? 0 : (dld2x2_24bit / dld2x2_24bit_pixels));
-  fprintf(F, "drawLineDual2x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x4_24bit, dld2x4_24bit_times, (dld2x4_24bit_times == 0) ? 0 : (dld2x4_24bit / dld2x4_24bit_times), dld2x4_24bit_pixels, (dld2x4_24bit_times == 0) ? 0 : (dld2x4_24bit_pixels / dld2x4_24bit_times), (dld2x4_24bit_pixels == 0) ? 0 : (dld2x4_24bit / dld2x4_24bit_pixels));
-  fprintf(F, "drawLineDual4x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x2_24bit, dld4x2_24bit_times, (dld4x2_24bit_times == 0) ? 0 : (dld4x2_24bit / dld4x2_24bit_times), dld4x2_24bit_pixels, (dld4x2_24bit_times == 0) ? 0 : (dld4x2_24bit_pixels / dld4x2_24bit_times), (dld4x2_24bit_pixels == 0) ? 0 : (dld4x2_24bit / dld4x2_24bit_pixels));
-  fprintf(F, "drawLineDual4x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x4_24bit, dld4x4_24bit_times, (dld4x4_24bit_times == 0) ? 0 : (dld4x4_24bit / dld4x4_24bit_times), dld4x4_24bit_pixels, (dld4x4_24bit_times == 0) ? 0 : (dld4x4_24bit_pixels / dld4x4_24bit_times), (dld4x4_24bit_pixels == 0) ? 0 : (dld4x4_24bit / dld4x4_24bit_pixels));
-
-  fprintf(F, "drawLineDual1x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x1_32bit, dld1x1_32bit_times, (dld1x1_32bit_times == 0) ? 0 : (dld1x1_32bit / dld1x1_32bit_times), dld1x1_32bit_pixels, (dld1x1_32bit_times == 0) ? 0 : (dld1x1_32bit_pixels / dld1x1_32bit_times), (dld1x1_32bit_pixels == 0) ? 0 : (dld1x1_32bit / dld1x1_32bit_pixels));
-  fprintf(F, "drawLineDual1x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld1x2_32bit, dld1x2_32bit_times, (dld1x2_32bit_times == 0) ? 0 : (dld1x2_32bit / dld1x2_32bit_times), dld1x2_32bit_pixels, (dld1x2_32bit_times == 0) ? 0 : (dld1x2_32bit_pixels / dld1x2_32bit_times), (dld1x2_32bit_pixels == 0) ? 0 : (dld1x2_32bit / dld1x2_32bit_pixels));
-  fprintf(F, "drawLineDual2x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x1_32bit, dld2x1_32bit_times, (dld2x1_32bit_times == 0) ? 0 : (dld2x1_32bit / dld2x1_32bit_times), dld2x1_32bit_pixels, (dld2x1_32bit_times == 0) ? 0 : (dld2x1_32bit_pixels / dld2x1_32bit_times), (dld2x1_32bit_pixels == 0) ? 0 : (dld2x1_32bit / dld2x1_32bit_pixels));
-  fprintf(F, "drawLineDual2x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x2_32bit, dld2x2_32bit_times, (dld2x2_32bit_times == 0) ? 0 : (dld2x2_32bit / dld2x2_32bit_times), dld2x2_32bit_pixels, (dld2x2_32bit_times == 0) ? 0 : (dld2x2_32bit_pixels / dld2x2_32bit_times), (dld2x2_32bit_pixels == 0) ? 0 : (dld2x2_32bit / dld2x2_32bit_pixels));
-  fprintf(F, "drawLineDual2x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld2x4_32bit, dld2x4_32bit_times, (dld2x4_32bit_times == 0) ? 0 : (dld2x4_32bit / dld2x4_32bit_times), dld2x4_32bit_pixels, (dld2x4_32bit_times == 0) ? 0 : (dld2x4_32bit_pixels / dld2x4_32bit_times), (dld2x4_32bit_pixels == 0) ? 0 : (dld2x4_32bit / dld2x4_32bit_pixels));
-  fprintf(F, "drawLineDual4x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x2_32bit, dld4x2_32bit_times, (dld4x2_32bit_times == 0) ? 0 : (dld4x2_32bit / dld4x2_32bit_times), dld4x2_32bit_pixels, (dld4x2_32bit_times == 0) ? 0 : (dld4x2_32bit_pixels / dld4x2_32bit_times), (dld4x2_32bit_pixels == 0) ? 0 : (dld4x2_32bit / dld4x2_32bit_pixels));
-  fprintf(F, "drawLineDual4x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dld4x4_32bit, dld4x4_32bit_times, (dld4x4_32bit_times == 0) ? 0 : (dld4x4_32bit / dld4x4_32bit_times), dld4x4_32bit_pixels, (dld4x4_32bit_times == 0) ? 0 : (dld4x4_32bit_pixels / dld4x4_32bit_times), (dld4x4_32bit_pixels == 0) ? 0 : (dld4x4_32bit / dld4x4_32bit_pixels));
-
-  // drawing HAM lines
-
-  fprintf(F, "drawLineHAM2x1_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x1_16bit, dlh2x1_16bit_times, (dlh2x1_16bit_times == 0) ? 0 : (dlh2x1_16bit / dlh2x1_16bit_times), dlh2x1_16bit_pixels, (dlh2x1_16bit_times == 0) ? 0 : (dlh2x1_16bit_pixels / dlh2x1_16bit_times), (dlh2x1_16bit_pixels == 0) ? 0 : (dlh2x1_16bit / dlh2x1_16bit_pixels));
-  fprintf(F, "drawLineHAM2x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x2_16bit, dlh2x2_16bit_times, (dlh2x2_16bit_times == 0) ? 0 : (dlh2x2_16bit / dlh2x2_16bit_times), dlh2x2_16bit_pixels, (dlh2x2_16bit_times == 0) ? 0 : (dlh2x2_16bit_pixels / dlh2x2_16bit_times), (dlh2x2_16bit_pixels == 0) ? 0 : (dlh2x2_16bit / dlh2x2_16bit_pixels));
-  fprintf(F, "drawLineHAM4x2_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x2_16bit, dlh4x2_16bit_times, (dlh4x2_16bit_times == 0) ? 0 : (dlh4x2_16bit / dlh4x2_16bit_times), dlh4x2_16bit_pixels, (dlh4x2_16bit_times == 0) ? 0 : (dlh4x2_16bit_pixels / dlh4x2_16bit_times), (dlh4x2_16bit_pixels == 0) ? 0 : (dlh4x2_16bit / dlh4x2_16bit_pixels));
-  fprintf(F, "drawLineHAM4x4_16bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x4_16bit, dlh4x4_16bit_times, (dlh4x4_16bit_times == 0) ? 0 : (dlh4x4_16bit / dlh4x4_16bit_times), dlh4x4_16bit_pixels, (dlh4x4_16bit_times == 0) ? 0 : (dlh4x4_16bit_pixels / dlh4x4_16bit_times), (dlh4x4_16bit_pixels == 0) ? 0 : (dlh4x4_16bit / dlh4x4_16bit_pixels));
-
-  fprintf(F, "drawLineHAM2x1_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x1_24bit, dlh2x1_24bit_times, (dlh2x1_24bit_times == 0) ? 0 : (dlh2x1_24bit / dlh2x1_24bit_times), dlh2x1_24bit_pixels, (dlh2x1_24bit_times == 0) ? 0 : (dlh2x1_24bit_pixels / dlh2x1_24bit_times), (dlh2x1_24bit_pixels == 0) ? 0 : (dlh2x1_24bit / dlh2x1_24bit_pixels));
-  fprintf(F, "drawLineHAM2x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x2_24bit, dlh2x2_24bit_times, (dlh2x2_24bit_times == 0) ? 0 : (dlh2x2_24bit / dlh2x2_24bit_times), dlh2x2_24bit_pixels, (dlh2x2_24bit_times == 0) ? 0 : (dlh2x2_24bit_pixels / dlh2x2_24bit_times), (dlh2x2_24bit_pixels == 0) ? 0 : (dlh2x2_24bit / dlh2x2_24bit_pixels));
-  fprintf(F, "drawLineHAM4x2_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x2_24bit, dlh4x2_24bit_times, (dlh4x2_24bit_times == 0) ? 0 : (dlh4x2_24bit / dlh4x2_24bit_times), dlh4x2_24bit_pixels, (dlh4x2_24bit_times == 0) ? 0 : (dlh4x2_24bit_pixels / dlh4x2_24bit_times), (dlh4x2_24bit_pixels == 0) ? 0 : (dlh4x2_24bit / dlh4x2_24bit_pixels));
-  fprintf(F, "drawLineHAM4x4_24bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x4_24bit, dlh4x4_24bit_times, (dlh4x4_24bit_times == 0) ? 0 : (dlh4x4_24bit / dlh4x4_24bit_times), dlh4x4_24bit_pixels, (dlh4x4_24bit_times == 0) ? 0 : (dlh4x4_24bit_pixels / dlh4x4_24bit_times), (dlh4x4_24bit_pixels == 0) ? 0 : (dlh4x4_24bit / dlh4x4_24bit_pixels));
-
-  fprintf(F, "drawLineHAM2x1_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x1_32bit, dlh2x1_32bit_times, (dlh2x1_32bit_times == 0) ? 0 : (dlh2x1_32bit / dlh2x1_32bit_times), dlh2x1_32bit_pixels, (dlh2x1_32bit_times == 0) ? 0 : (dlh2x1_32bit_pixels / dlh2x1_32bit_times), (dlh2x1_32bit_pixels == 0) ? 0 : (dlh2x1_32bit / dlh2x1_32bit_pixels));
-  fprintf(F, "drawLineHAM2x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh2x2_32bit, dlh2x2_32bit_times, (dlh2x2_32bit_times == 0) ? 0 : (dlh2x2_32bit / dlh2x2_32bit_times), dlh2x2_32bit_pixels, (dlh2x2_32bit_times == 0) ? 0 : (dlh2x2_32bit_pixels / dlh2x2_32bit_times), (dlh2x2_32bit_pixels == 0) ? 0 : (dlh2x2_32bit / dlh2x2_32bit_pixels));
-  fprintf(F, "drawLineHAM4x2_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x2_32bit, dlh4x2_32bit_times, (dlh4x2_32bit_times == 0) ? 0 : (dlh4x2_32bit / dlh4x2_32bit_times), dlh4x2_32bit_pixels, (dlh4x2_32bit_times == 0) ? 0 : (dlh4x2_32bit_pixels / dlh4x2_32bit_times), (dlh4x2_32bit_pixels == 0) ? 0 : (dlh4x2_32bit / dlh4x2_32bit_pixels));
-  fprintf(F, "drawLineHAM4x4_32bit\t%I64d\t%d\t%I64d\t%d\t%d\t%d\n", dlh4x4_32bit, dlh4x4_32bit_times, (dlh4x4_32bit_times == 0) ? 0 : (dlh4x4_32bit / dlh4x4_32bit_times), dlh4x4_32bit_pixels, (dlh4x4_32bit_times == 0) ? 0 : (dlh4x4_32bit_pixels / dlh4x4_32bit_times), (dlh4x4_32bit_pixels == 0) ? 0 : (dlh4x4_32bit / dlh4x4_32bit_pixels));
-
-  fclose(F);
-#endif
-}
+#include <emmintrin.h>
 
 /*============================================================================*/
 /* Dual playfield translation table                                           */
@@ -548,6 +51,21 @@ ULO draw_HAM_modify_table[4][2];
 const ULO draw_HAM_modify_table_bitindex = 0;
 const ULO draw_HAM_modify_table_holdmask = 4;
 
+/*============================================================================*/
+/* HAM pixel table, what each pixel value does to the HAM color before it     */
+/*                                                                            */
+/* A modify pixel makes (hampixel & ~clear_mask) | modify_value. A palette    */
+/* pixel replaces all of it, it has all bits in clear_mask and no value.      */
+/*============================================================================*/
+
+typedef struct
+{
+  ULO clear_mask;    // Bits of the HAM color that the pixel replaces
+  ULO modify_value;  // New bits of a modify pixel
+} draw_HAM_pixel_entry;
+
+draw_HAM_pixel_entry draw_HAM_pixel_table[256];
+
 /*============================================================================*/
 /* Calulate data needed to draw HAM                                           */
 /*============================================================================*/
@@ -578,6 +96,23 @@ void drawHAMTableInit()
   draw_HAM_modify_table[2][1] = drawMakeHoldMask(draw_buffer_info.redpos, draw_buffer_info.redsize, longdestination);
   draw_HAM_modify_table[3][0] = draw_buffer_info.greenpos + draw_buffer_info.greensize - 4;  /* Green */
   draw_HAM_modify_table[3][1] = drawMakeHoldMask(draw_buffer_info.greenpos, draw_buffer_info.greensize, longdestination);
+
+  for (ULO pixel_value = 0; pixel_value < 256; pixel_value++)
+  {
+    ULO control = (pixel_value & 0xc0) >> 6;
+    draw_HAM_pixel_entry *entry = &draw_HAM_pixel_table[pixel_value];
+
+    if (control == 0)
+    {
+      entry->clear_mask = 0xffffffff;
+      entry->modify_value = 0;
+    }
+    else
+    {
+      entry->clear_mask = ~draw_HAM_modify_table[control][1];
+      entry->modify_value = ((pixel_value & 0x3c) >> 2) << (draw_HAM_modify_table[control][0] & 0xff);
+    }
+  }
 }
 
 /*============================================================================*/
@@ -660,2959 +195,444 @@ static ULO drawMake32BitColorFrom16Bit(UWO color)
   return color32;
 }
 
-static ULL drawMake64BitColorFrom16Bit(UWO color)
-{
-  ULL color64 = ((ULL) color) | ((ULL) color) << 16 | ((ULL) color) << 32 | ((ULL) color) << 48;
-  return color64;
-}
-
 ULL drawMake64BitColorFrom32Bit(ULO color)
 {
   ULL color64 = ((ULL) color) | ((ULL) color) << 32;
   return color64;
 }
 
-static UWO drawGetColorUWO(ULO *colors, UBY color_index)
-{
-  return *((UWO *) ((UBY *) colors + color_index));
-}
-
 static ULO drawGetColorULO(ULO *colors, UBY color_index)
 {
   return *((ULO *) ((UBY *) colors + color_index));
 }
 
-static ULL drawGetColorULL(ULO *colors, UBY color_index)
-{
-  ULO pixel_color = drawGetColorULO(colors, color_index);
-  return drawMake64BitColorFrom32Bit(pixel_color);
-}
-
 static UBY drawGetDualColorIndex(UBY *dual_translate_ptr, UBY playfield1_value, UBY playfield2_value)
 {
   return *(dual_translate_ptr + ((playfield1_value << 8) + playfield2_value));
 }
 
-static UWO drawGetDualColorUWO(ULO *colors, UBY *dual_translate_ptr, UBY playfield1_value, UBY playfield2_value)
-{
-  UBY color_index = drawGetDualColorIndex(dual_translate_ptr, playfield1_value, playfield2_value);
-  return drawGetColorUWO(colors, color_index);
-}
-
 static ULO drawGetDualColorULO(ULO *colors, UBY *dual_translate_ptr, UBY playfield1_value, UBY playfield2_value)
 {
   UBY color_index = drawGetDualColorIndex(dual_translate_ptr, playfield1_value, playfield2_value);
   return drawGetColorULO(colors, color_index);
 }
 
-static ULL drawGetDualColorULL(ULO *colors, UBY *dual_translate_ptr, UBY playfield1_value, UBY playfield2_value)
-{
-  UBY color_index = drawGetDualColorIndex(dual_translate_ptr, playfield1_value, playfield2_value);
-  return drawGetColorULL(colors, color_index);
-}
-
-static ULO drawUpdateHAMPixel(ULO hampixel, UBY pixel_value)
-{
-  UBY *holdmask = ((UBY *) draw_HAM_modify_table + ((pixel_value & 0xc0) >> 3));
-  ULO bitindex = *((ULO *) (holdmask + draw_HAM_modify_table_bitindex));
-  hampixel &= *((ULO *) (holdmask + draw_HAM_modify_table_holdmask));
-  hampixel |= (((pixel_value & 0x3c) >> 2) << (bitindex & 0xff));
-  return hampixel;
-}
-
 static ULO drawMakeHAMPixel(ULO *colors, ULO hampixel, UBY pixel_value)
 {
   if ((pixel_value & 0xc0) == 0)
   {
     return drawGetColorULO(colors, pixel_value);
   }
-  return drawUpdateHAMPixel(hampixel, pixel_value);
-}
-
-static ULO drawProcessNonVisibleHAMPixels(graph_line *linedescription, LON pixel_count)
-{
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DDF_start;
-  ULO hampixel = 0;
-  while (pixel_count-- > 0) 
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-  }
-  return hampixel;
-}
-
-static void drawSetPixel1x1_16Bit(UWO *framebuffer, UWO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-}
-
-static void drawSetPixel1x2_16Bit(UWO *framebuffer, ULO nextlineoffset, UWO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset] = pixel_color;
-}
-
-static void drawSetPixel2x1_16Bit(ULO *framebuffer, ULO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-}
-
-static void drawSetPixel2x2_16Bit(ULO *framebuffer, ULO nextlineoffset, ULO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset] = pixel_color;
-}
-
-static void drawSetPixel2x4_16Bit(ULO *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-  framebuffer[nextlineoffset2] = pixel_color;
-  framebuffer[nextlineoffset3] = pixel_color;
-}
-
-static void drawSetPixel4x1_16Bit(ULL *framebuffer, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-}
-
-static void drawSetPixel4x2_16Bit(ULL *framebuffer, ULO nextlineoffset, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset] = pixel_color;
-}
-
-static void drawSetPixel4x4_16Bit(ULL *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-  framebuffer[nextlineoffset2] = pixel_color;
-  framebuffer[nextlineoffset3] = pixel_color;
+  draw_HAM_pixel_entry *entry = &draw_HAM_pixel_table[pixel_value];
+  return (hampixel & ~entry->clear_mask) | entry->modify_value;
 }
 
 /*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* single pixels                                                                */
-/* single lines                                                                 */
+/* Host pixel formats                                                           */
 /*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
+/* The colors in a line description are already in the host format. In 15/16  */
+/* bit modes a color holds the pixel twice, in the low and in the high word.    */
+/* SetPixels() writes XScale host pixels of one color, MergeHAMSprites() draws  */
+/* the sprites on top of a HAM line.                                            */
 /*==============================================================================*/
 
-static void drawLineNormal1x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
+struct draw_pixel_format_16bit
 {
-#ifdef DRAW_TSC_PROFILE
-  dln1x1_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x1_16bit_tmp);
-#endif
-
-  UWO *framebuffer = (UWO *) draw_buffer_info.current_ptr;
-  UWO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
+  enum { bytes_per_pixel = 2, depth = 16 };
 
-  while (framebuffer != framebuffer_end)
+  static ULO MakeHAMColor(ULO hampixel)
   {
-    UWO pixel_color = drawGetColorUWO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x1_16Bit(framebuffer++, pixel_color);
+    return drawMake32BitColorFrom16Bit((UWO) hampixel);
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  static __m128i MakeHAMColors(__m128i hampixels)
+  {
+    return _mm_or_si128(_mm_and_si128(hampixels, _mm_set1_epi32(0xffff)), _mm_slli_epi32(hampixels, 16));
+  }
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x1_16bit_tmp, &dln1x1_16bit, &dln1x1_16bit_times);
-#endif
-}
+  template <ULO XScale> static void SetPixels(UBY *framebuffer, ULO pixel_color)
+  {
+    if (XScale == 1)
+    {
+      *((UWO *) framebuffer) = (UWO) pixel_color;
+    }
+    else
+    {
+      for (ULO i = 0; i < XScale/2; i++)
+      {
+        ((ULO *) framebuffer)[i] = pixel_color;
+      }
+    }
+  }
 
-/*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* single pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
-/*==============================================================================*/
+  template <ULO XScale, ULO YScale> static void MergeHAMSprites(UBY *framebuffer, graph_line *linedescription, ULO nextlineoffset)
+  {
+    if (XScale == 2 && YScale == 1) line_exact_sprites->MergeHAM2x1x16((ULO *) framebuffer, linedescription);
+    else if (XScale == 2 && YScale == 2) line_exact_sprites->MergeHAM2x2x16((ULO *) framebuffer, linedescription, nextlineoffset/4);
+    else if (XScale == 4 && YScale == 2) line_exact_sprites->MergeHAM4x2x16((ULL *) framebuffer, linedescription, nextlineoffset/8);
+    else if (XScale == 4 && YScale == 4) line_exact_sprites->MergeHAM4x4x16((ULL *) framebuffer, linedescription, nextlineoffset/8, (nextlineoffset/8)*2, (nextlineoffset/8)*3);
+  }
+};
 
-static void drawLineNormal1x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+struct draw_pixel_format_24bit
 {
-#ifdef DRAW_TSC_PROFILE
-  dln1x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x2_16bit_tmp);
-#endif
+  enum { bytes_per_pixel = 3, depth = 24 };
 
-  UWO *framebuffer = (UWO *) draw_buffer_info.current_ptr;
-  UWO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 2;
-
-  while (framebuffer != framebuffer_end)
+  static ULO MakeHAMColor(ULO hampixel)
   {
-    UWO pixel_color = drawGetColorUWO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
+    return hampixel;
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  static __m128i MakeHAMColors(__m128i hampixels)
+  {
+    return hampixels;
+  }
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x2_16bit_tmp, &dln1x2_16bit, &dln1x2_16bit_times);
-#endif
-}
+  // Writes four bytes for each pixel, the next pixel overwrites the extra byte
+  template <ULO XScale> static void SetPixels(UBY *framebuffer, ULO pixel_color)
+  {
+    for (ULO i = 0; i < XScale; i++)
+    {
+      *((ULO *) (framebuffer + i*3)) = pixel_color;
+    }
+  }
 
-/*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
-/*==============================================================================*/
+  template <ULO XScale, ULO YScale> static void MergeHAMSprites(UBY *framebuffer, graph_line *linedescription, ULO nextlineoffset)
+  {
+    if (XScale == 2 && YScale == 1) line_exact_sprites->MergeHAM2x1x24(framebuffer, linedescription);
+    else if (XScale == 2 && YScale == 2) line_exact_sprites->MergeHAM2x2x24(framebuffer, linedescription, nextlineoffset);
+    else if (XScale == 4 && YScale == 2) line_exact_sprites->MergeHAM4x2x24(framebuffer, linedescription, nextlineoffset);
+    else if (XScale == 4 && YScale == 4) line_exact_sprites->MergeHAM4x4x24(framebuffer, linedescription, nextlineoffset, nextlineoffset*2, nextlineoffset*3);
+  }
+};
 
-static void drawLineNormal2x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
+struct draw_pixel_format_32bit
 {
-#ifdef DRAW_TSC_PROFILE
-  dln2x1_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x1_16bit_tmp);
-#endif
+  enum { bytes_per_pixel = 4, depth = 32 };
 
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
+  static ULO MakeHAMColor(ULO hampixel)
+  {
+    return hampixel;
+  }
 
-  while (framebuffer != framebuffer_end)
+  static __m128i MakeHAMColors(__m128i hampixels)
   {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x1_16Bit(framebuffer++, pixel_color);
+    return hampixels;
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  template <ULO XScale> static void SetPixels(UBY *framebuffer, ULO pixel_color)
+  {
+    for (ULO i = 0; i < XScale; i++)
+    {
+      ((ULO *) framebuffer)[i] = pixel_color;
+    }
+  }
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x1_16bit_tmp, &dln2x1_16bit, &dln2x1_16bit_times);
-#endif
-}
+  template <ULO XScale, ULO YScale> static void MergeHAMSprites(UBY *framebuffer, graph_line *linedescription, ULO nextlineoffset)
+  {
+    if (XScale == 2 && YScale == 1) line_exact_sprites->MergeHAM2x1x32((ULL *) framebuffer, linedescription);
+    else if (XScale == 2 && YScale == 2) line_exact_sprites->MergeHAM2x2x32((ULL *) framebuffer, linedescription, nextlineoffset/8);
+    else if (XScale == 4 && YScale == 2) line_exact_sprites->MergeHAM4x2x32((ULL *) framebuffer, linedescription, nextlineoffset/8);
+    else if (XScale == 4 && YScale == 4) line_exact_sprites->MergeHAM4x4x32((ULL *) framebuffer, linedescription, nextlineoffset/8, (nextlineoffset/8)*2, (nextlineoffset/8)*3);
+  }
+};
 
 /*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
+/* Pixel sources, Next() returns the host color of the next pixel on the line   */
 /*==============================================================================*/
 
-static void drawLineNormal2x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x2_16bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 4;
+static bool draw_sse2; /* The host CPU has SSE2, set by drawModeFunctionsInitialize() */
 
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
+struct draw_source_background
+{
+  ULO color;
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  draw_source_background(ULO bgcolor) : color(bgcolor) {}
+  ULO Next() { return color; }
+};
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x2_16bit_tmp, &dln2x2_16bit, &dln2x2_16bit_times);
-#endif
-}
+struct draw_source_normal
+{
+  ULO *colors;
+  UBY *source_ptr;
 
-/*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
-/*==============================================================================*/
+  draw_source_normal(graph_line *linedescription)
+    : colors(linedescription->colors), source_ptr(linedescription->line1 + linedescription->DIW_first_draw) {}
+  ULO Next() { return drawGetColorULO(colors, *source_ptr++); }
+};
 
-static void drawLineNormal2x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
+struct draw_source_dual
 {
-#ifdef DRAW_TSC_PROFILE
-  dln2x4_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x4_16bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 4;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  ULO *colors;
+  UBY *dual_translate_ptr;
+  UBY *source_line1_ptr;
+  UBY *source_line2_ptr;
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x4_16bit_tmp, &dln2x4_16bit, &dln2x4_16bit_times);
-#endif
-}
+  draw_source_dual(graph_line *linedescription)
+    : colors(linedescription->colors),
+      dual_translate_ptr(drawGetDualTranslatePtr(linedescription)),
+      source_line1_ptr(linedescription->line1 + linedescription->DIW_first_draw),
+      source_line2_ptr(linedescription->line2 + linedescription->DIW_first_draw) {}
+  ULO Next() { return drawGetDualColorULO(colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++); }
+};
 
 /*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
+/* HAM pixel source                                                             */
 /*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
+/* A pixel changes the HAM color before it with (hampixel & ~clear_mask) |      */
+/* value. Two such changes make one, their clear masks or'ed and the first      */
+/* value cleared by the second mask, so four pixels are resolved with a prefix  */
+/* scan in an SSE2 register instead of one after the other. The color before    */
+/* the four is applied last and the fourth color is carried on. The palette is  */
+/* only read when one of the four pixels is a palette pixel.                    */
 /*==============================================================================*/
 
-static void drawLineNormal4x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <int Bytes> static __inline void drawHAMScanStep(__m128i &clear_masks, __m128i &values)
 {
-#ifdef DRAW_TSC_PROFILE
-  dln4x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x2_16bit_tmp);
-#endif
+  values = _mm_or_si128(_mm_andnot_si128(clear_masks, _mm_slli_si128(values, Bytes)), values);
+  clear_masks = _mm_or_si128(clear_masks, _mm_slli_si128(clear_masks, Bytes));
+}
 
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
+static __inline __m128i drawMakeFourHAMPixels(ULO *colors, UBY *source, ULO &hampixel)
+{
+  // Table entries of the four pixels, then one register of clear masks and one of modify values
+  __m128i entries01 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *) &draw_HAM_pixel_table[source[0]]), _mm_loadl_epi64((__m128i *) &draw_HAM_pixel_table[source[1]]));
+  __m128i entries23 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *) &draw_HAM_pixel_table[source[2]]), _mm_loadl_epi64((__m128i *) &draw_HAM_pixel_table[source[3]]));
+  entries01 = _mm_shuffle_epi32(entries01, _MM_SHUFFLE(3, 1, 2, 0));
+  entries23 = _mm_shuffle_epi32(entries23, _MM_SHUFFLE(3, 1, 2, 0));
+  __m128i clear_masks = _mm_unpacklo_epi64(entries01, entries23);
+  __m128i values = _mm_unpackhi_epi64(entries01, entries23);
 
-  while (framebuffer != framebuffer_end)
+  // A palette pixel has both control bits clear
+  ULO pixels = *((ULO *) source);
+  if (((pixels | (pixels << 1)) & 0x80808080) != 0x80808080)
   {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel4x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
+    __m128i palette_masks = _mm_cmpeq_epi32(clear_masks, _mm_set1_epi32(-1));
+    __m128i palette_colors = _mm_setr_epi32(drawGetColorULO(colors, source[0] & 0x3f), drawGetColorULO(colors, source[1] & 0x3f),
+                                            drawGetColorULO(colors, source[2] & 0x3f), drawGetColorULO(colors, source[3] & 0x3f));
+    values = _mm_or_si128(values, _mm_and_si128(palette_colors, palette_masks));
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  drawHAMScanStep<4>(clear_masks, values);
+  drawHAMScanStep<8>(clear_masks, values);
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x2_16bit_tmp, &dln4x2_16bit, &dln4x2_16bit_times);
-#endif
+  __m128i hampixels = _mm_or_si128(_mm_andnot_si128(clear_masks, _mm_set1_epi32(hampixel)), values);
+  hampixel = (ULO) _mm_cvtsi128_si32(_mm_shuffle_epi32(hampixels, _MM_SHUFFLE(3, 3, 3, 3)));
+  return hampixels;
 }
 
-/*==============================================================================*/
-/* general function for drawing one line using normal pixels                    */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* pixel format: 15/16 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineNormal4x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat> struct draw_source_HAM
 {
-#ifdef DRAW_TSC_PROFILE
-  dln4x4_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x4_16bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1 *2;
-  ULO nextlineoffset3 = nextlineoffset1 *3;
-
-  while (framebuffer != framebuffer_end)
+  ULO *colors;
+  UBY *source_line_ptr;
+  ULO hampixel;
+
+  draw_source_HAM(graph_line *linedescription, UBY *first_pixel)
+    : colors(linedescription->colors), source_line_ptr(first_pixel), hampixel(0) {}
+  ULO Next()
   {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel4x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
+    hampixel = drawMakeHAMPixel(colors, hampixel, *source_line_ptr++);
+    return TPixelFormat::MakeHAMColor(hampixel);
+  }
+  __m128i NextFour()
+  {
+    __m128i hampixels = drawMakeFourHAMPixels(colors, source_line_ptr, hampixel);
+    source_line_ptr += 4;
+    return TPixelFormat::MakeHAMColors(hampixels);
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x4_16bit_tmp, &dln4x4_16bit, &dln4x4_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
-/*==============================================================================*/
-
-static void drawLineDual1x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld1x1_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x1_16bit_tmp);
-#endif
-
-  UWO *framebuffer = (UWO *)draw_buffer_info.current_ptr;
-  UWO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
+  // Pixels between DDF_start and DIW_first_draw are not drawn, but their colors are held
+  void Skip(ULO pixel_count)
   {
-    UWO pixel_color = drawGetDualColorUWO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x1_16Bit(framebuffer++, pixel_color);
+    for (; draw_sse2 && pixel_count >= 4; pixel_count -= 4)
+    {
+      drawMakeFourHAMPixels(colors, source_line_ptr, hampixel);
+      source_line_ptr += 4;
+    }
+    for (; pixel_count > 0; pixel_count--)
+    {
+      hampixel = drawMakeHAMPixel(colors, hampixel, *source_line_ptr++);
+    }
   }
+};
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+// Four colors at a time for the SSE2 stores, the HAM source makes them together
+template <class TSource> static __inline __m128i drawSourceNextFour(TSource &source)
+{
+  ULO color0 = source.Next();
+  ULO color1 = source.Next();
+  ULO color2 = source.Next();
+  ULO color3 = source.Next();
+  return _mm_setr_epi32(color0, color1, color2, color3);
+}
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x1_16bit_tmp, &dld1x1_16bit, &dld1x1_16bit_times);
-#endif
+template <class TPixelFormat> static __inline __m128i drawSourceNextFour(draw_source_HAM<TPixelFormat> &source)
+{
+  return source.NextFour();
 }
 
 /*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* double lines                                                                 */
+/* Expands a line of pixels to XScale x YScale host pixels each                 */
 /*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
+/* When one Amiga pixel covers whole 32-bit words in the host buffer, four      */
+/* colors are looked up and stored with SSE2, the words of each pixel made by   */
+/* shuffling. That covers 15/16 bit with 2x and 4x, and 32 bit with all scales. */
+/* Other formats, and all formats when the host CPU has no SSE2, are stored    */
+/* one pixel at a time.                                                         */
 /*==============================================================================*/
 
-static void drawLineDual1x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale> struct draw_sse2_words_per_pixel
 {
-#ifdef DRAW_TSC_PROFILE
-  dld1x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x2_16bit_tmp);
-#endif
-
-  UWO *framebuffer = (UWO *)draw_buffer_info.current_ptr;
-  UWO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset1 = nextlineoffset / 2;
-
-  while (framebuffer != framebuffer_end)
+  enum
   {
-    UWO pixel_color = drawGetDualColorUWO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x2_16bit_tmp, &dld1x2_16bit, &dld1x2_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
-/*==============================================================================*/
+    bytes = TPixelFormat::bytes_per_pixel*XScale,
+    value = (TPixelFormat::bytes_per_pixel != 3 && (bytes == 4 || bytes == 8 || bytes == 16)) ? bytes/4 : 0
+  };
+};
 
-static void drawLineDual2x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <ULO WordsPerPixel> static __inline void drawStoreFourPixelsSSE2(UBY *framebuffer, __m128i colors)
 {
-  #ifdef DRAW_TSC_PROFILE
-  dld2x1_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x1_16bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *) draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-
-  while (framebuffer != framebuffer_end)
+  if (WordsPerPixel == 1)
   {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x1_16Bit(framebuffer++, pixel_color);
+    _mm_storeu_si128((__m128i *) framebuffer, colors);
+  }
+  else if (WordsPerPixel == 2)
+  {
+    _mm_storeu_si128((__m128i *) framebuffer, _mm_unpacklo_epi32(colors, colors));
+    _mm_storeu_si128((__m128i *) (framebuffer + 16), _mm_unpackhi_epi32(colors, colors));
+  }
+  else if (WordsPerPixel == 4)
+  {
+    _mm_storeu_si128((__m128i *) framebuffer, _mm_shuffle_epi32(colors, _MM_SHUFFLE(0, 0, 0, 0)));
+    _mm_storeu_si128((__m128i *) (framebuffer + 16), _mm_shuffle_epi32(colors, _MM_SHUFFLE(1, 1, 1, 1)));
+    _mm_storeu_si128((__m128i *) (framebuffer + 32), _mm_shuffle_epi32(colors, _MM_SHUFFLE(2, 2, 2, 2)));
+    _mm_storeu_si128((__m128i *) (framebuffer + 48), _mm_shuffle_epi32(colors, _MM_SHUFFLE(3, 3, 3, 3)));
   }
-
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x1_16bit_tmp, &dld2x1_16bit, &dld2x1_16bit_times);
-#endif
 }
 
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
-/*==============================================================================*/
-
-static void drawLineDual2x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale, class TSource>
+static __inline UBY *drawLineExpand(UBY *framebuffer, ULO pixel_count, TSource source, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  dld2x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x2_16bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset1 = nextlineoffset / 4;
-
-  while (framebuffer != framebuffer_end)
+  const ULO words_per_pixel = draw_sse2_words_per_pixel<TPixelFormat, XScale>::value;
+  const ULO bytes_per_pixel = TPixelFormat::bytes_per_pixel*XScale;
+  ULO i = 0;
+
+  if (words_per_pixel != 0 && draw_sse2)
   {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
+    for (; i + 4 <= pixel_count; i += 4)
+    {
+      __m128i colors = drawSourceNextFour(source);
+
+      for (ULO line = 0; line < YScale; line++)
+      {
+        drawStoreFourPixelsSSE2<words_per_pixel>(framebuffer + line*nextlineoffset, colors);
+      }
+      framebuffer += 4*bytes_per_pixel;
+    }
   }
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+  for (; i < pixel_count; i++)
+  {
+    ULO pixel_color = source.Next();
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x2_16bit_tmp, &dld2x2_16bit, &dld2x2_16bit_times);
-#endif
+    for (ULO line = 0; line < YScale; line++)
+    {
+      TPixelFormat::template SetPixels<XScale>(framebuffer + line*nextlineoffset, pixel_color);
+    }
+    framebuffer += bytes_per_pixel;
+  }
+  return framebuffer;
 }
 
 /*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* quad lines                                                                   */
+/* Line renderers, one instance for each pixel format and scale                 */
 /*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
+/* XScale is the number of host pixels for each Amiga pixel on a line, YScale   */
+/* the number of host lines. nextlineoffset is the distance in bytes from one   */
+/* host line to the next.                                                       */
 /*==============================================================================*/
 
-static void drawLineDual2x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x4_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x4_16bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset1 = nextlineoffset / 4;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
+/*==============================================================================*/
+/* Draw one line segment using background color                                 */
+/*==============================================================================*/
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x4_16bit_tmp, &dld2x4_16bit, &dld2x4_16bit_times);
-#endif
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineSegmentBG(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
+{
+  draw_buffer_current_ptr = drawLineExpand<TPixelFormat, XScale, YScale>(draw_buffer_current_ptr, pixelcount, draw_source_background(bgcolor), nextlineoffset);
 }
 
 /*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
+/* Draw one line using normal pixels                                            */
 /*==============================================================================*/
 
-static void drawLineDual4x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineNormal(graph_line *linedescription, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  dld4x2_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x2_16bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *) draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x2_16Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
+  ProfilerScope scope(PROFILER_DRAW_NORMAL);
+  scope.AddUnits(linedescription->DIW_pixel_count);
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x2_16bit_tmp, &dld4x2_16bit, &dld4x2_16bit_times);
-#endif
+  draw_buffer_current_ptr = drawLineExpand<TPixelFormat, XScale, YScale>(draw_buffer_current_ptr, linedescription->DIW_pixel_count, draw_source_normal(linedescription), nextlineoffset);
 }
 
 /*==============================================================================*/
 /* Draw one line mixing two playfields                                          */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
 /*==============================================================================*/
 
-static void drawLineDual4x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineDual(graph_line *linedescription, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  dld4x4_16bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x4_16bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-  }
+  ProfilerScope scope(PROFILER_DRAW_DUAL);
+  scope.AddUnits(linedescription->DIW_pixel_count);
 
-  draw_buffer_info.current_ptr = (UBY *)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x4_16bit_tmp, &dld4x4_16bit, &dld4x4_16bit_times);
-#endif
+  draw_buffer_current_ptr = drawLineExpand<TPixelFormat, XScale, YScale>(draw_buffer_current_ptr, linedescription->DIW_pixel_count, draw_source_dual(linedescription), nextlineoffset);
 }
 
 /*==============================================================================*/
 /* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
 /*==============================================================================*/
 
-static void drawLineHAM2x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineHAM(graph_line *linedescription, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x1_16bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x1_16bit_tmp);
-#endif
-
-  ULO hampixel = 0;  
+  ProfilerScope scope(PROFILER_DRAW_HAM);
   LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULO *framebuffer = (ULO*)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x1_16Bit(framebuffer++, drawMake32BitColorFrom16Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM2x1x16((ULO*)draw_buffer_current_ptr_local, linedescription);
+  ULO skipped_pixel_count = (non_visible_pixel_count > 0) ? non_visible_pixel_count : 0;
+  scope.AddUnits(linedescription->DIW_pixel_count + skipped_pixel_count);
+  draw_source_HAM<TPixelFormat> source(linedescription, linedescription->line1 + linedescription->DIW_first_draw - skipped_pixel_count);
+  source.Skip(skipped_pixel_count);
 
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
+  UBY *draw_buffer_current_ptr_local = draw_buffer_current_ptr;
+  draw_buffer_current_ptr = drawLineExpand<TPixelFormat, XScale, YScale>(draw_buffer_current_ptr, linedescription->DIW_pixel_count, source, nextlineoffset);
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x1_16bit_tmp, &dlh2x1_16bit, &dlh2x1_16bit_times);
-#endif
+  // Sprites are drawn on top of the finished line, in their own pass
+  TPixelFormat::template MergeHAMSprites<XScale, YScale>(draw_buffer_current_ptr_local, linedescription, nextlineoffset);
 }
 
 /*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
+/* Draw one bitplane line                                                       */
 /*==============================================================================*/
 
-static void drawLineHAM2x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineBPL(graph_line *linedescription, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x2_16bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x2_16bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULO *framebuffer = (ULO*)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 4;
-  
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x2_16Bit(framebuffer++, nextlineoffset1, drawMake32BitColorFrom16Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM2x2x16((ULO*)draw_buffer_current_ptr_local, linedescription, nextlineoffset1);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x2_16bit_tmp, &dlh2x2_16bit, &dlh2x2_16bit_times);
-#endif
+  drawLineSegmentBG<TPixelFormat, XScale, YScale>(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
+  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
+  drawLineSegmentBG<TPixelFormat, XScale, YScale>(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
 }
 
 /*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
+/* Draw one background line                                                     */
 /*==============================================================================*/
 
-static void drawLineHAM4x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
+template <class TPixelFormat, ULO XScale, ULO YScale>
+static void drawLineBG(graph_line *linedescription, ULO nextlineoffset)
 {
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x2_16bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x2_16bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x2_16Bit(framebuffer++, nextlineoffset1, drawMake64BitColorFrom16Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM4x2x16((ULL*)draw_buffer_current_ptr_local, linedescription, nextlineoffset1);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
+  ProfilerScope scope(PROFILER_DRAW_BG);
+  scope.AddUnits(drawGetInternalClip().GetWidth());
 
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x2_16bit_tmp, &dlh4x2_16bit, &dlh4x2_16bit_times);
-#endif
+  drawLineSegmentBG<TPixelFormat, XScale, YScale>(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
 }
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     15/16 bit RGB                                              */
-/*==============================================================================*/
-
-static void drawLineHAM4x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x4_16bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x4_16bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;  
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, drawMake64BitColorFrom16Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM4x4x16((ULL*)draw_buffer_current_ptr_local, linedescription, nextlineoffset1, nextlineoffset2, nextlineoffset3);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x4_16bit_tmp, &dlh4x4_16bit, &dlh4x4_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x1_16Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + pixelcount;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x1_16Bit(framebuffer++, bgcolor);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x2_16Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + pixelcount;
-  ULO nextlineoffset1 = nextlineoffset / 4;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x2_16Bit(framebuffer++, nextlineoffset1, bgcolor);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x2_16Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x2_16Bit(framebuffer++, nextlineoffset1, bgcolor64);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x4_16Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x4_16Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, bgcolor64);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x1_16Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x1_16Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x2_16Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x2_16Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x2_16Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x2_16Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x4_16Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x4_16Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x1_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x1_16bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x1_16bit_tmp);
-#endif
-
-  drawLineSegmentBG2x1_16Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x1_16bit_tmp, &dlsbg2x1_16bit, &dlsbg2x1_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x2_16bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x2_16bit_tmp);
-#endif
-
-  drawLineSegmentBG2x2_16Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x2_16bit_tmp, &dlsbg2x2_16bit, &dlsbg2x2_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x2_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x2_16bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x2_16bit_tmp);
-#endif
-
-  drawLineSegmentBG4x2_16Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x2_16bit_tmp, &dlsbg4x2_16bit, &dlsbg4x2_16bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    16 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x4_16Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x4_16bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x4_16bit_tmp);
-#endif
-
-  drawLineSegmentBG4x4_16Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x4_16bit_tmp, &dlsbg4x4_16bit, &dlsbg4x4_16bit_times);
-#endif
-}
-
-/* 24 Bit */
-
-static void drawSetPixel1x1_24Bit(UBY *framebuffer, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-}
-
-static void drawSetPixel1x2_24Bit(UBY *framebuffer, ULO nextlineoffset, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset)) = pixel_color;
-}
-
-static void drawSetPixel2x1_24Bit(UBY *framebuffer, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + 3)) = pixel_color;
-}
-
-static void drawSetPixel2x2_24Bit(UBY *framebuffer, ULO nextlineoffset, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset + 3)) = pixel_color;
-}
-
-static void drawSetPixel2x4_24Bit(UBY *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1 + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2 + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3 + 3)) = pixel_color;
-}
-
-static void drawSetPixel4x2_24Bit(UBY *framebuffer, ULO nextlineoffset, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + 3)) = pixel_color;
-  *((ULO*)(framebuffer + 6)) = pixel_color;
-  *((ULO*)(framebuffer + 9)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset + 6)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset + 9)) = pixel_color;
-}
-
-static void drawSetPixel4x4_24Bit(UBY *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULO pixel_color)
-{
-  *((ULO*)framebuffer) = pixel_color;
-  *((ULO*)(framebuffer + 3)) = pixel_color;
-  *((ULO*)(framebuffer + 6)) = pixel_color;
-  *((ULO*)(framebuffer + 9)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1 + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1 + 6)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset1 + 9)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2 + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2 + 6)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset2 + 9)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3 + 3)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3 + 6)) = pixel_color;
-  *((ULO*)(framebuffer + nextlineoffset3 + 9)) = pixel_color;
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* single pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal1x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln1x1_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x1_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*3;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x1_24Bit(framebuffer, pixel_color);
-    framebuffer += 3;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x1_24bit_tmp, &dln1x1_24bit, &dln1x1_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* single pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal1x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln1x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*3;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 3;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x2_24bit_tmp, &dln1x2_24bit, &dln1x2_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x1_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x1_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x1_24Bit(framebuffer, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x1_24bit_tmp, &dln2x1_24bit, &dln2x1_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x2_24bit_tmp, &dln2x2_24bit, &dln2x2_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x4_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x4_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel2x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x4_24bit_tmp, &dln2x4_24bit, &dln2x4_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal4x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln4x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel4x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x2_24bit_tmp, &dln4x2_24bit, &dln4x2_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal4x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln4x4_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x4_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel4x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x4_24bit_tmp, &dln4x4_24bit, &dln4x4_24bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual1x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld1x1_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x1_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*3;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x1_24Bit(framebuffer, pixel_color);
-    framebuffer += 3;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x1_24bit_tmp, &dld1x1_24bit, &dld1x1_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual1x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld1x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*3;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 3;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x2_24bit_tmp, &dld1x2_24bit, &dld1x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x1_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x1_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x1_24Bit(framebuffer, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x1_24bit_tmp, &dld2x1_24bit, &dld2x1_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x2_24bit_tmp, &dld2x2_24bit, &dld2x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x4_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x4_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x4_24bit_tmp, &dld2x4_24bit, &dld2x4_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual4x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld4x2_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x2_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x2_24Bit(framebuffer, nextlineoffset, pixel_color);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x2_24bit_tmp, &dld4x2_24bit, &dld4x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual4x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld4x4_24bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x4_24bit_tmp);
-#endif
-
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-  
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x4_24bit_tmp, &dld4x4_24bit, &dld4x4_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM2x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x1_24bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x1_24bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x1_24Bit(framebuffer, hampixel);
-    framebuffer += 6;
-  }
-
-  line_exact_sprites->MergeHAM2x1x24(draw_buffer_current_ptr_local, linedescription);
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x1_24bit_tmp, &dlh2x1_24bit, &dlh2x1_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM2x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x2_24bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x2_24bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*6;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x2_24Bit(framebuffer, nextlineoffset, hampixel);
-    framebuffer += 6;
-  }
-
-  line_exact_sprites->MergeHAM2x2x24(draw_buffer_current_ptr_local, linedescription, nextlineoffset);
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x2_24bit_tmp, &dlh2x2_24bit, &dlh2x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM4x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x2_24bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x2_24bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x2_24Bit(framebuffer, nextlineoffset, hampixel);
-    framebuffer += 12;
-  }
-
-  line_exact_sprites->MergeHAM4x2x24(draw_buffer_current_ptr_local, linedescription, nextlineoffset);
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x2_24bit_tmp, &dlh4x2_24bit, &dlh4x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     24 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM4x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x4_24bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x4_24bit_tmp);
-#endif	
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*12;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, hampixel);
-    framebuffer += 12;
-  }
-
-  line_exact_sprites->MergeHAM4x4x24(draw_buffer_current_ptr_local, linedescription, nextlineoffset, nextlineoffset2, nextlineoffset3);
-
-  draw_buffer_info.current_ptr = framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x4_24bit_tmp, &dlh4x4_24bit, &dlh4x4_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x1_24Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + pixelcount*6;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x1_24Bit(framebuffer, bgcolor);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x2_24Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + pixelcount*6;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x2_24Bit(framebuffer, nextlineoffset, bgcolor);
-    framebuffer += 6;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x2_24Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + pixelcount*12;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x2_24Bit(framebuffer, nextlineoffset, bgcolor);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x4_24Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  UBY *framebuffer = draw_buffer_info.current_ptr;
-  UBY *framebuffer_end = framebuffer + pixelcount*12;
-  ULO nextlineoffset2 = nextlineoffset*2;
-  ULO nextlineoffset3 = nextlineoffset*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x4_24Bit(framebuffer, nextlineoffset, nextlineoffset2, nextlineoffset3, bgcolor);
-    framebuffer += 12;
-  }
-
-  draw_buffer_info.current_ptr = framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x1_24Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x1_24Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x2_24Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x2_24Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x2_24Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x2_24Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x4_24Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x4_24Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x1_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x1_24bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x1_24bit_tmp);
-#endif
-
-  drawLineSegmentBG2x1_24Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x1_24bit_tmp, &dlsbg2x1_24bit, &dlsbg2x1_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x2_24bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x2_24bit_tmp);
-#endif
-
-  drawLineSegmentBG2x2_24Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x2_24bit_tmp, &dlsbg2x2_24bit, &dlsbg2x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x2_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x2_24bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x2_24bit_tmp);
-#endif
-
-  drawLineSegmentBG4x2_24Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x2_24bit_tmp, &dlsbg4x2_24bit, &dlsbg4x2_24bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    24 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x4_24Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x4_24bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x4_24bit_tmp);
-#endif
-
-  drawLineSegmentBG4x4_24Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x4_24bit_tmp, &dlsbg4x4_24bit, &dlsbg4x4_24bit_times);
-#endif
-}
-
-/* 32-Bit */
-
-static void drawSetPixel1x1_32Bit(ULO *framebuffer, ULO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-}
-
-static void drawSetPixel1x2_32Bit(ULO *framebuffer, ULO nextlineoffset1, ULO pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-}
-
-static void drawSetPixel2x1_32Bit(ULL *framebuffer, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-}
-
-static void drawSetPixel2x2_32Bit(ULL *framebuffer, ULO nextlineoffset1, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-}
-
-static void drawSetPixel2x4_32Bit(ULL *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-  framebuffer[nextlineoffset2] = pixel_color;
-  framebuffer[nextlineoffset3] = pixel_color;
-}
-
-static void drawSetPixel4x2_32Bit(ULL *framebuffer, ULO nextlineoffset1, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[1] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-  framebuffer[nextlineoffset1 + 1] = pixel_color;
-}
-
-static void drawSetPixel4x4_32Bit(ULL *framebuffer, ULO nextlineoffset1, ULO nextlineoffset2, ULO nextlineoffset3, ULL pixel_color)
-{
-  framebuffer[0] = pixel_color;
-  framebuffer[1] = pixel_color;
-  framebuffer[nextlineoffset1] = pixel_color;
-  framebuffer[nextlineoffset1 + 1] = pixel_color;
-  framebuffer[nextlineoffset2] = pixel_color;
-  framebuffer[nextlineoffset2 + 1] = pixel_color;
-  framebuffer[nextlineoffset3] = pixel_color;
-  framebuffer[nextlineoffset3 + 1] = pixel_color;
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* single pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal1x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln1x1_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x1_32bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x1_32Bit(framebuffer++, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x1_32bit_tmp, &dln1x1_32bit, &dln1x1_32bit_times);
-#endif	
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* single pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal1x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln1x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln1x2_32bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 4;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetColorULO(linedescription->colors, *source_ptr++);
-    drawSetPixel1x2_32Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln1x2_32bit_tmp, &dln1x2_32bit, &dln1x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x1_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x1_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel2x1_32Bit(framebuffer++, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x1_32bit_tmp, &dln2x1_32bit, &dln2x1_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x2_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel2x2_32Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x2_32bit_tmp, &dln2x2_32bit, &dln2x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal2x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln2x4_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln2x4_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel2x4_32Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln2x4_32bit_tmp, &dln2x4_32bit, &dln2x4_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal4x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln4x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x2_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*2;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel4x2_32Bit(framebuffer, nextlineoffset1, pixel_color);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x2_32bit_tmp, &dln4x2_32bit, &dln4x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line using normal pixels                                            */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineNormal4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dln4x4_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dln4x4_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*2;
-  UBY *source_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetColorULL(linedescription->colors, *source_ptr++);
-    drawSetPixel4x4_32Bit(framebuffer, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dln4x4_32bit_tmp, &dln4x4_32bit, &dln4x4_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual1x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld1x1_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x1_32bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x1_32Bit(framebuffer++, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x1_32bit_tmp, &dld1x1_32bit, &dld1x1_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* single pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual1x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld1x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld1x2_32bit_tmp);
-#endif
-
-  ULO *framebuffer = (ULO *)draw_buffer_info.current_ptr;
-  ULO *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 4;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULO pixel_color = drawGetDualColorULO(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel1x2_32Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld1x2_32bit_tmp, &dld1x2_32bit, &dld1x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x1_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x1_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x1_32Bit(framebuffer++, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x1_32bit_tmp, &dld2x1_32bit, &dld2x1_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x2_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x2_32Bit(framebuffer++, nextlineoffset1, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x2_32bit_tmp, &dld2x2_32bit, &dld2x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* double pixels                                                                */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual2x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld2x4_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld2x4_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel2x4_32Bit(framebuffer++, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld2x4_32bit_tmp, &dld2x4_32bit, &dld2x4_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual4x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld4x2_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x2_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*2;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x2_32Bit(framebuffer, nextlineoffset1, pixel_color);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x2_32bit_tmp, &dld4x2_32bit, &dld4x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line mixing two playfields                                          */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineDual4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dld4x4_32bit_pixels += linedescription->DIW_pixel_count;
-  drawTscBefore(&dld4x4_32bit_tmp);
-#endif
-
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + linedescription->DIW_pixel_count*2;
-  UBY *dual_translate_ptr = drawGetDualTranslatePtr(linedescription);
-  UBY *source_line1_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  UBY *source_line2_ptr = linedescription->line2 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    ULL pixel_color = drawGetDualColorULL(linedescription->colors, dual_translate_ptr, *source_line1_ptr++, *source_line2_ptr++);
-    drawSetPixel4x4_32Bit(framebuffer, nextlineoffset1, nextlineoffset2, nextlineoffset3, pixel_color);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dld4x4_32bit_tmp, &dld4x4_32bit, &dld4x4_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* single lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM2x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x1_32bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x1_32bit_tmp);
-#endif
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = (ULL*)draw_buffer_info.current_ptr + linedescription->DIW_pixel_count;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x1_32Bit(framebuffer++, drawMake64BitColorFrom32Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM2x1x32((ULL*)draw_buffer_current_ptr_local, linedescription);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x1_32bit_tmp, &dlh2x1_32bit, &dlh2x1_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* double pixels                                                                */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM2x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh2x2_32bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh2x2_32bit_tmp);
-#endif
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = (ULL*)draw_buffer_info.current_ptr + linedescription->DIW_pixel_count;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel2x2_32Bit(framebuffer++, nextlineoffset1, drawMake64BitColorFrom32Bit(hampixel));
-  }
-
-  line_exact_sprites->MergeHAM2x2x32(reinterpret_cast<ULL*>(draw_buffer_current_ptr_local), linedescription, nextlineoffset1);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh2x2_32bit_tmp, &dlh2x2_32bit, &dlh2x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* double lines                                                                 */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM4x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x2_32bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x2_32bit_tmp);
-#endif
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = (ULL*)draw_buffer_info.current_ptr + linedescription->DIW_pixel_count * 2;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x2_32Bit(framebuffer, nextlineoffset1, drawMake64BitColorFrom32Bit(hampixel));
-    framebuffer += 2;
-  }
-
-  line_exact_sprites->MergeHAM4x2x32(reinterpret_cast<ULL*>(draw_buffer_current_ptr_local), linedescription, nextlineoffset1);
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x2_32bit_tmp, &dlh4x2_32bit, &dlh4x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line of HAM data                                                    */
-/* quad pixels                                                                  */
-/* quad lines                                                                   */
-/*                                                                              */
-/* Pixel format:     32 bit RGB                                                 */
-/*==============================================================================*/
-
-static void drawLineHAM4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  LON tscnonvisible = linedescription->DIW_first_draw - linedescription->DDF_start;
-  dlh4x4_32bit_pixels += linedescription->DIW_pixel_count + ((tscnonvisible > 0) ? tscnonvisible : 0);
-  drawTscBefore(&dlh4x4_32bit_tmp);
-#endif
-
-  ULO hampixel = 0;
-  LON non_visible_pixel_count = linedescription->DIW_first_draw - linedescription->DDF_start;
-  if (non_visible_pixel_count > 0)
-  {
-    hampixel = drawProcessNonVisibleHAMPixels(linedescription, non_visible_pixel_count);
-  }
-
-  UBY *draw_buffer_current_ptr_local = draw_buffer_info.current_ptr;
-  ULL *framebuffer = (ULL*)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = (ULL*)draw_buffer_info.current_ptr + linedescription->DIW_pixel_count * 2;
-  UBY *source_line_ptr = linedescription->line1 + linedescription->DIW_first_draw;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-
-  while (framebuffer != framebuffer_end)
-  {
-    hampixel = drawMakeHAMPixel(linedescription->colors, hampixel, *source_line_ptr++);
-    drawSetPixel4x4_32Bit(framebuffer, nextlineoffset1, nextlineoffset2, nextlineoffset3, drawMake64BitColorFrom32Bit(hampixel));
-    framebuffer += 2;
-  }
-
-  line_exact_sprites->MergeHAM4x4x32(reinterpret_cast<ULL*>(draw_buffer_current_ptr_local), linedescription, nextlineoffset1, nextlineoffset2, nextlineoffset3);
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlh4x4_32bit_tmp, &dlh4x4_32bit, &dlh4x4_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x1_32Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x1_32Bit(framebuffer++, bgcolor64);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG2x2_32Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel2x2_32Bit(framebuffer++, nextlineoffset1, bgcolor64);
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x2_32Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount*2;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x2_32Bit(framebuffer, nextlineoffset1, bgcolor64);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one line segment using background color                                 */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-static void drawLineSegmentBG4x4_32Bit(ULO pixelcount, ULO bgcolor, ULO nextlineoffset)
-{
-  ULL *framebuffer = (ULL *)draw_buffer_info.current_ptr;
-  ULL *framebuffer_end = framebuffer + pixelcount*2;
-  ULO nextlineoffset1 = nextlineoffset / 8;
-  ULO nextlineoffset2 = nextlineoffset1*2;
-  ULO nextlineoffset3 = nextlineoffset1*3;
-  ULL bgcolor64 = drawMake64BitColorFrom32Bit(bgcolor);
-  
-  while (framebuffer != framebuffer_end)
-  {
-    drawSetPixel4x4_32Bit(framebuffer, nextlineoffset1, nextlineoffset2, nextlineoffset3, bgcolor64);
-    framebuffer += 2;
-  }
-
-  draw_buffer_info.current_ptr = (UBY*)framebuffer;
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x1_32Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x1_32Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL2x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG2x2_32Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG2x2_32Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x2_32Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x2_32Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one bitplane line                                                       */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBPL4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-  drawLineSegmentBG4x4_32Bit(linedescription->BG_pad_front, linedescription->colors[0], nextlineoffset);
-  ((draw_line_func) (linedescription->draw_line_BPL_res_routine))(linedescription, nextlineoffset);
-  drawLineSegmentBG4x4_32Bit(linedescription->BG_pad_back, linedescription->colors[0], nextlineoffset);
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  1x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x1_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x1_32bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x1_32bit_tmp);
-#endif
-
-  drawLineSegmentBG2x1_32Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x1_32bit_tmp, &dlsbg2x1_32bit, &dlsbg2x1_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    2x                                                          */
-/* Vertical Scale:  2x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG2x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg2x2_32bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg2x2_32bit_tmp);
-#endif
-
-  drawLineSegmentBG2x2_32Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg2x2_32bit_tmp, &dlsbg2x2_32bit, &dlsbg2x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  2x (scanlines or in interlace)                              */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x2_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x2_32bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x2_32bit_tmp);
-#endif
-
-  drawLineSegmentBG4x2_32Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x2_32bit_tmp, &dlsbg4x2_32bit, &dlsbg4x2_32bit_times);
-#endif
-}
-
-/*==============================================================================*/
-/* Draw one background line                                                     */
-/*                                                                              */
-/* Display size:    4x                                                          */
-/* Vertical Scale:  4x (solid and not in interlace)                             */
-/* Pixel format:    32 bit RGB                                                  */
-/*==============================================================================*/
-
-void drawLineBG4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
-{
-#ifdef DRAW_TSC_PROFILE
-  dlsbg4x4_32bit_pixels += drawGetClipWidth();
-  drawTscBefore(&dlsbg4x4_32bit_tmp);
-#endif
-
-  drawLineSegmentBG4x4_32Bit(drawGetInternalClip().GetWidth(), linedescription->colors[0], nextlineoffset);
-
-#ifdef DRAW_TSC_PROFILE
-  drawTscAfter(&dlsbg4x4_32bit_tmp, &dlsbg4x4_32bit, &dlsbg4x4_32bit_times);
-#endif
-}
-
 /*============================================================================*/
 /* Lookup tables that holds all the drawing routines for various Amiga and    */
 /* host screen modes [color depth (3)][sizes (4)]                             */
@@ -3620,51 +640,51 @@ void drawLineBG4x4_32Bit(graph_line *linedescription, ULO nextlineoffset)
 
 draw_line_func draw_line_BPL_manage_funcs[3][4] = 
 {
-  {drawLineBPL2x1_16Bit, drawLineBPL2x2_16Bit, drawLineBPL4x2_16Bit, drawLineBPL4x4_16Bit},
-  {drawLineBPL2x1_24Bit, drawLineBPL2x2_24Bit, drawLineBPL4x2_24Bit, drawLineBPL4x4_24Bit},
-  {drawLineBPL2x1_32Bit, drawLineBPL2x2_32Bit, drawLineBPL4x2_32Bit, drawLineBPL4x4_32Bit}
+  {drawLineBPL<draw_pixel_format_16bit, 2, 1>, drawLineBPL<draw_pixel_format_16bit, 2, 2>, drawLineBPL<draw_pixel_format_16bit, 4, 2>, drawLineBPL<draw_pixel_format_16bit, 4, 4>},
+  {drawLineBPL<draw_pixel_format_24bit, 2, 1>, drawLineBPL<draw_pixel_format_24bit, 2, 2>, drawLineBPL<draw_pixel_format_24bit, 4, 2>, drawLineBPL<draw_pixel_format_24bit, 4, 4>},
+  {drawLineBPL<draw_pixel_format_32bit, 2, 1>, drawLineBPL<draw_pixel_format_32bit, 2, 2>, drawLineBPL<draw_pixel_format_32bit, 4, 2>, drawLineBPL<draw_pixel_format_32bit, 4, 4>}
 };
 
 draw_line_func draw_line_BG_funcs[3][4] = 
 {
-  {drawLineBG2x1_16Bit, drawLineBG2x2_16Bit, drawLineBG4x2_16Bit, drawLineBG4x4_16Bit},
-  {drawLineBG2x1_24Bit, drawLineBG2x2_24Bit, drawLineBG4x2_24Bit, drawLineBG4x4_24Bit},
-  {drawLineBG2x1_32Bit, drawLineBG2x2_32Bit, drawLineBG4x2_32Bit, drawLineBG4x4_32Bit}
+  {drawLineBG<draw_pixel_format_16bit, 2, 1>, drawLineBG<draw_pixel_format_16bit, 2, 2>, drawLineBG<draw_pixel_format_16bit, 4, 2>, drawLineBG<draw_pixel_format_16bit, 4, 4>},
+  {drawLineBG<draw_pixel_format_24bit, 2, 1>, drawLineBG<draw_pixel_format_24bit, 2, 2>, drawLineBG<draw_pixel_format_24bit, 4, 2>, drawLineBG<draw_pixel_format_24bit, 4, 4>},
+  {drawLineBG<draw_pixel_format_32bit, 2, 1>, drawLineBG<draw_pixel_format_32bit, 2, 2>, drawLineBG<draw_pixel_format_32bit, 4, 2>, drawLineBG<draw_pixel_format_32bit, 4, 4>}
 };
 
 draw_line_func draw_line_lores_funcs[3][4] = 
 {
-  {drawLineNormal2x1_16Bit, drawLineNormal2x2_16Bit, drawLineNormal4x2_16Bit, drawLineNormal4x4_16Bit},
-  {drawLineNormal2x1_24Bit, drawLineNormal2x2_24Bit, drawLineNormal4x2_24Bit, drawLineNormal4x4_24Bit},
-  {drawLineNormal2x1_32Bit, drawLineNormal2x2_32Bit, drawLineNormal4x2_32Bit, drawLineNormal4x4_32Bit}
+  {drawLineNormal<draw_pixel_format_16bit, 2, 1>, drawLineNormal<draw_pixel_format_16bit, 2, 2>, drawLineNormal<draw_pixel_format_16bit, 4, 2>, drawLineNormal<draw_pixel_format_16bit, 4, 4>},
+  {drawLineNormal<draw_pixel_format_24bit, 2, 1>, drawLineNormal<draw_pixel_format_24bit, 2, 2>, drawLineNormal<draw_pixel_format_24bit, 4, 2>, drawLineNormal<draw_pixel_format_24bit, 4, 4>},
+  {drawLineNormal<draw_pixel_format_32bit, 2, 1>, drawLineNormal<draw_pixel_format_32bit, 2, 2>, drawLineNormal<draw_pixel_format_32bit, 4, 2>, drawLineNormal<draw_pixel_format_32bit, 4, 4>}
 };
 
 draw_line_func draw_line_hires_funcs[3][4] = 
 {
-  {drawLineNormal1x1_16Bit, drawLineNormal1x2_16Bit, drawLineNormal2x2_16Bit, drawLineNormal2x4_16Bit},
-  {drawLineNormal1x1_24Bit, drawLineNormal1x2_24Bit, drawLineNormal2x2_24Bit, drawLineNormal2x4_24Bit},
-  {drawLineNormal1x1_32Bit, drawLineNormal1x2_32Bit, drawLineNormal2x2_32Bit, drawLineNormal2x4_32Bit}
+  {drawLineNormal<draw_pixel_format_16bit, 1, 1>, drawLineNormal<draw_pixel_format_16bit, 1, 2>, drawLineNormal<draw_pixel_format_16bit, 2, 2>, drawLineNormal<draw_pixel_format_16bit, 2, 4>},
+  {drawLineNormal<draw_pixel_format_24bit, 1, 1>, drawLineNormal<draw_pixel_format_24bit, 1, 2>, drawLineNormal<draw_pixel_format_24bit, 2, 2>, drawLineNormal<draw_pixel_format_24bit, 2, 4>},
+  {drawLineNormal<draw_pixel_format_32bit, 1, 1>, drawLineNormal<draw_pixel_format_32bit, 1, 2>, drawLineNormal<draw_pixel_format_32bit, 2, 2>, drawLineNormal<draw_pixel_format_32bit, 2, 4>}
 };
 
 draw_line_func draw_line_dual_lores_funcs[3][4] = 
 {
-  {drawLineDual2x1_16Bit, drawLineDual2x2_16Bit, drawLineDual4x2_16Bit, drawLineDual4x4_16Bit},
-  {drawLineDual2x1_24Bit, drawLineDual2x2_24Bit, drawLineDual4x2_24Bit, drawLineDual4x4_24Bit},
-  {drawLineDual2x1_32Bit, drawLineDual2x2_32Bit, drawLineDual4x2_32Bit, drawLineDual4x4_32Bit}
+  {drawLineDual<draw_pixel_format_16bit, 2, 1>, drawLineDual<draw_pixel_format_16bit, 2, 2>, drawLineDual<draw_pixel_format_16bit, 4, 2>, drawLineDual<draw_pixel_format_16bit, 4, 4>},
+  {drawLineDual<draw_pixel_format_24bit, 2, 1>, drawLineDual<draw_pixel_format_24bit, 2, 2>, drawLineDual<draw_pixel_format_24bit, 4, 2>, drawLineDual<draw_pixel_format_24bit, 4, 4>},
+  {drawLineDual<draw_pixel_format_32bit, 2, 1>, drawLineDual<draw_pixel_format_32bit, 2, 2>, drawLineDual<draw_pixel_format_32bit, 4, 2>, drawLineDual<draw_pixel_format_32bit, 4, 4>}
 };
 
 draw_line_func draw_line_dual_hires_funcs[3][4] = 
 {
-  {drawLineDual1x1_16Bit, drawLineDual1x2_16Bit, drawLineDual2x2_16Bit, drawLineDual2x4_16Bit},
-  {drawLineDual1x1_24Bit, drawLineDual1x2_24Bit, drawLineDual2x2_24Bit, drawLineDual2x4_24Bit},
-  {drawLineDual1x1_32Bit, drawLineDual1x2_32Bit, drawLineDual2x2_32Bit, drawLineDual2x4_32Bit}
+  {drawLineDual<draw_pixel_format_16bit, 1, 1>, drawLineDual<draw_pixel_format_16bit, 1, 2>, drawLineDual<draw_pixel_format_16bit, 2, 2>, drawLineDual<draw_pixel_format_16bit, 2, 4>},
+  {drawLineDual<draw_pixel_format_24bit, 1, 1>, drawLineDual<draw_pixel_format_24bit, 1, 2>, drawLineDual<draw_pixel_format_24bit, 2, 2>, drawLineDual<draw_pixel_format_24bit, 2, 4>},
+  {drawLineDual<draw_pixel_format_32bit, 1, 1>, drawLineDual<draw_pixel_format_32bit, 1, 2>, drawLineDual<draw_pixel_format_32bit, 2, 2>, drawLineDual<draw_pixel_format_32bit, 2, 4>}
 };
 
 draw_line_func draw_line_HAM_lores_funcs[3][4] = 
 {
-  {drawLineHAM2x1_16Bit, drawLineHAM2x2_16Bit, drawLineHAM4x2_16Bit, drawLineHAM4x4_16Bit},
-  {drawLineHAM2x1_24Bit, drawLineHAM2x2_24Bit, drawLineHAM4x2_24Bit, drawLineHAM4x4_24Bit},
-  {drawLineHAM2x1_32Bit, drawLineHAM2x2_32Bit, drawLineHAM4x2_32Bit, drawLineHAM4x4_32Bit}
+  {drawLineHAM<draw_pixel_format_16bit, 2, 1>, drawLineHAM<draw_pixel_format_16bit, 2, 2>, drawLineHAM<draw_pixel_format_16bit, 4, 2>, drawLineHAM<draw_pixel_format_16bit, 4, 4>},
+  {drawLineHAM<draw_pixel_format_24bit, 2, 1>, drawLineHAM<draw_pixel_format_24bit, 2, 2>, drawLineHAM<draw_pixel_format_24bit, 4, 2>, drawLineHAM<draw_pixel_format_24bit, 4, 4>},
+  {drawLineHAM<draw_pixel_format_32bit, 2, 1>, drawLineHAM<draw_pixel_format_32bit, 2, 2>, drawLineHAM<draw_pixel_format_32bit, 4, 2>, drawLineHAM<draw_pixel_format_32bit, 4, 4>}
 };
 
 static ULO drawGetColorDepthIndex()
@@ -3720,6 +740,7 @@ void drawModeFunctionsInitialize()
   ULO colordepth_index = drawGetColorDepthIndex();
   ULO scale_index = drawGetScaleIndex();
 
+  draw_sse2 = (fellowCPUHasSSE2() == TRUE);
   draw_line_BPL_manage_routine = draw_line_BPL_manage_funcs[colordepth_index][scale_index];
   draw_line_routine = draw_line_BG_routine = draw_line_BG_funcs[colordepth_index][scale_index];
   draw_line_BPL_res_routine = draw_line_lores_routine = draw_line_lores_funcs[colordepth_index][scale_index];
@@ -24,7 +24,7 @@
 #include "CIA.H"
 #include "CpuModule.h"
 #include "CpuIntegration.h"
-#include "UART.h"
+#include "uart.h"
 
 
 #include "fileops.h"
@@ -60,7 +60,7 @@ ULO interrupt_pending_chip_interrupt_number;
 static unsigned int interrupt_cpu_level[16] = {1,1,1,2, 3,3,3,4, 4,4,4,5, 5,6,6,7};
 
 
-STR *interruptGetInterruptName(ULO interrupt_number)
+const STR *interruptGetInterruptName(ULO interrupt_number)
 {
   switch (interrupt_number)
   {
@@ -287,6 +287,24 @@ void interruptIoHandlersInstall(void)
   memorySetIoWriteStub(0x09c, wintreq);
 }
 
+void interruptSaveState(savestate *S)
+{
+  savestateChunkBegin(S, SAVESTATE_INTERRUPT, SAVESTATE_INTERRUPT_VERSION);
+  savestateWriteValue(S, intena);
+  savestateWriteValue(S, intreq);
+  savestateWriteValue(S, interrupt_pending_cpu_level);
+  savestateWriteValue(S, interrupt_pending_chip_interrupt_number);
+  savestateChunkEnd(S);
+}
+
+void interruptLoadState(savestate *S)
+{
+  savestateReadValue(S, intena);
+  savestateReadValue(S, intreq);
+  savestateReadValue(S, interrupt_pending_cpu_level);
+  savestateReadValue(S, interrupt_pending_chip_interrupt_number);
+}
+
 /* Fellow standard module events */
 
 void interruptSoftReset(void)
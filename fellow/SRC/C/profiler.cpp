@@ -0,0 +1,294 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/* Hot path profiler                                                       */
+/*                                                                         */
+/* The timers are in profiler.h. Here the counter blocks of the threads    */
+/* are kept, and at the end of each frame they are summed and the change   */
+/* since the previous frame is written to profile.csv or profile.json.     */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdio.h>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "defs.h"
+#include "fellow.h"
+#include "bus.h"
+#include "fileops.h"
+#include "profiler.h"
+
+std::atomic<bool> profiler_enabled;
+FELLOW_THREAD_LOCAL profiler_counter *profiler_thread_counters;
+
+static PROFILER_REPORT profiler_report_format;
+static FILE *profiler_report_file;
+static ULL profiler_report_frames;
+
+static const char *profiler_counter_names[PROFILER_COUNTER_COUNT] =
+{
+  "frame",
+  "bus.copper", "bus.cia", "bus.blitter", "bus.interrupt", "bus.eol", "bus.eof",
+  "eol.graph", "eol.sprite", "eol.cia", "eol.floppy", "eol.sound", "eol.kbd", "eol.uart",
+  "eof.draw", "eof.kbd", "eof.copper", "eof.cia", "eof.sprite", "eof.blitter", "eof.uart", "eof.graph", "eof.interlace", "eof.cycleexact", "eof.rewind",
+  "cpu.0_bit_imm", "cpu.1_move_b", "cpu.2_move_l", "cpu.3_move_w", "cpu.4_misc", "cpu.5_addq_subq_scc_dbcc", "cpu.6_bcc_bsr", "cpu.7_moveq",
+  "cpu.8_or_div_sbcd", "cpu.9_sub", "cpu.a_line_a", "cpu.b_cmp_eor", "cpu.c_and_mul_abcd_exg", "cpu.d_add", "cpu.e_shift_rotate", "cpu.f_line_f",
+  "cpu.interrupt",
+  "draw.bg", "draw.normal", "draw.dual", "draw.ham"
+};
+
+/*============================================================================*/
+/* Counter blocks, one for each thread that has counted something             */
+/* A thread that ends adds its counts to profiler_retired_counters so that    */
+/* the totals never go down.                                                  */
+/*============================================================================*/
+
+static std::mutex profiler_threads_mutex;
+static std::vector<profiler_counter *> profiler_threads;
+static profiler_counter profiler_retired_counters[PROFILER_COUNTER_COUNT];
+
+class ProfilerThread
+{
+public:
+  profiler_counter *Counters;
+
+  ProfilerThread()
+  {
+    Counters = new profiler_counter[PROFILER_COUNTER_COUNT];
+    for (ULO i = 0; i < PROFILER_COUNTER_COUNT; i++)
+    {
+      Counters[i].calls.store(0, std::memory_order_relaxed);
+      Counters[i].ticks.store(0, std::memory_order_relaxed);
+      Counters[i].units.store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(profiler_threads_mutex);
+    profiler_threads.push_back(Counters);
+  }
+
+  ~ProfilerThread()
+  {
+    std::lock_guard<std::mutex> lock(profiler_threads_mutex);
+    for (ULO i = 0; i < PROFILER_COUNTER_COUNT; i++)
+    {
+      profilerCounterAdd(profiler_retired_counters[i].calls, Counters[i].calls.load(std::memory_order_relaxed));
+      profilerCounterAdd(profiler_retired_counters[i].ticks, Counters[i].ticks.load(std::memory_order_relaxed));
+      profilerCounterAdd(profiler_retired_counters[i].units, Counters[i].units.load(std::memory_order_relaxed));
+    }
+    profiler_threads.erase(std::find(profiler_threads.begin(), profiler_threads.end(), Counters));
+    profiler_thread_counters = nullptr;
+    delete[] Counters;
+  }
+};
+
+// FELLOW_THREAD_LOCAL has no destructors, the block of a thread is retired
+// by the destructor of a C++ thread_local object
+profiler_counter *profilerRegisterThread(void)
+{
+  static thread_local ProfilerThread thread;
+  profiler_thread_counters = thread.Counters;
+  return thread.Counters;
+}
+
+typedef struct profiler_totals_
+{
+  ULL calls[PROFILER_COUNTER_COUNT];
+  ULL ticks[PROFILER_COUNTER_COUNT];
+  ULL units[PROFILER_COUNTER_COUNT];
+} profiler_totals;
+
+// The totals at the previous report, each report has the change from these
+static profiler_totals profiler_last_totals;
+
+static void profilerGetTotals(profiler_totals *totals)
+{
+  std::lock_guard<std::mutex> lock(profiler_threads_mutex);
+  for (ULO i = 0; i < PROFILER_COUNTER_COUNT; i++)
+  {
+    totals->calls[i] = profiler_retired_counters[i].calls.load(std::memory_order_relaxed);
+    totals->ticks[i] = profiler_retired_counters[i].ticks.load(std::memory_order_relaxed);
+    totals->units[i] = profiler_retired_counters[i].units.load(std::memory_order_relaxed);
+    for (profiler_counter *counters : profiler_threads)
+    {
+      totals->calls[i] += counters[i].calls.load(std::memory_order_relaxed);
+      totals->ticks[i] += counters[i].ticks.load(std::memory_order_relaxed);
+      totals->units[i] += counters[i].units.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/*============================================================================*/
+/* Tick rate                                                                  */
+/* The time stamp counter is measured against steady_clock from the opening   */
+/* of the report, the estimate gets better as the report grows.               */
+/*============================================================================*/
+
+static ULL profiler_calibration_ticks;
+static std::chrono::steady_clock::time_point profiler_calibration_time;
+
+static void profilerCalibrationStart(void)
+{
+  profiler_calibration_time = std::chrono::steady_clock::now();
+  profiler_calibration_ticks = profilerGetTicks();
+}
+
+static double profilerGetTicksPerUs(ULL ticks)
+{
+#ifdef PROFILER_USE_TSC
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - profiler_calibration_time).count();
+  return (us > 0.0) ? (((double) (ticks - profiler_calibration_ticks))/us) : 0.0;
+#else
+  return 1000.0;
+#endif
+}
+
+/*============================================================================*/
+/* Report                                                                     */
+/* CSV has one row for each counter that was called in the frame, JSON is an  */
+/* array with one object for each frame.                                      */
+/*============================================================================*/
+
+static ULL profiler_frame_start;
+
+static void profilerReportOpen(void)
+{
+  char filename[MAX_PATH];
+
+  fileopsGetGenericFileName(filename, "WinFellow", (profiler_report_format == PROFILER_REPORT_JSON) ? "profile.json" : "profile.csv");
+  profiler_report_file = fopen(filename, "w");
+  if (profiler_report_file == NULL)
+  {
+    fellowAddLog("profiler: Unable to open %s, profiling is turned off\n", filename);
+    profiler_enabled.store(false, std::memory_order_relaxed);
+    return;
+  }
+  fellowAddLog("profiler: Writing the profile to %s\n", filename);
+
+  if (profiler_report_format == PROFILER_REPORT_JSON)
+  {
+    fprintf(profiler_report_file, "[\n");
+  }
+  else
+  {
+    fprintf(profiler_report_file, "frame,counter,calls,ticks,us,units\n");
+  }
+  profiler_report_frames = 0;
+  profilerGetTotals(&profiler_last_totals);
+  profilerCalibrationStart();
+  profiler_frame_start = profilerGetTicks();
+}
+
+static void profilerReportClose(void)
+{
+  if (profiler_report_format == PROFILER_REPORT_JSON)
+  {
+    fprintf(profiler_report_file, "\n]\n");
+  }
+  fclose(profiler_report_file);
+  profiler_report_file = NULL;
+  fellowAddLog("profiler: %llu frames in the profile\n", profiler_report_frames);
+}
+
+static void profilerReportFrame(ULL frame, ULL now)
+{
+  profiler_totals totals;
+  double ticks_per_us = profilerGetTicksPerUs(now);
+  bool first = true;
+
+  profilerGetTotals(&totals);
+  if (profiler_report_format == PROFILER_REPORT_JSON)
+  {
+    fprintf(profiler_report_file, "%s  {\"frame\": %llu, \"counters\": {", (profiler_report_frames == 0) ? "" : ",\n", frame);
+  }
+  for (ULO i = 0; i < PROFILER_COUNTER_COUNT; i++)
+  {
+    ULL calls = totals.calls[i] - profiler_last_totals.calls[i];
+    ULL ticks = totals.ticks[i] - profiler_last_totals.ticks[i];
+    ULL units = totals.units[i] - profiler_last_totals.units[i];
+    double us = (ticks_per_us > 0.0) ? (((double) ticks)/ticks_per_us) : 0.0;
+
+    if (calls == 0)
+    {
+      continue;
+    }
+    if (profiler_report_format == PROFILER_REPORT_JSON)
+    {
+      fprintf(profiler_report_file, "%s\n    \"%s\": {\"calls\": %llu, \"ticks\": %llu, \"us\": %.1f, \"units\": %llu}", (first) ? "" : ",", profiler_counter_names[i], calls, ticks, us, units);
+    }
+    else
+    {
+      fprintf(profiler_report_file, "%llu,%s,%llu,%llu,%.1f,%llu\n", frame, profiler_counter_names[i], calls, ticks, us, units);
+    }
+    first = false;
+  }
+  if (profiler_report_format == PROFILER_REPORT_JSON)
+  {
+    fprintf(profiler_report_file, "}}");
+  }
+  profiler_last_totals = totals;
+  profiler_report_frames++;
+}
+
+/*============================================================================*/
+/* Called by the bus at the end of each frame, opens and closes the report    */
+/* when the profiler has been turned on or off.                               */
+/* Draw threads that are still working on the previous frame count their     */
+/* work in whichever frame is reported next.                                  */
+/*============================================================================*/
+
+void profilerEndOfFrame(void)
+{
+  if (!profilerGetEnabled())
+  {
+    if (profiler_report_file != NULL)
+    {
+      profilerReportClose();
+    }
+    return;
+  }
+  if (profiler_report_file == NULL)
+  {
+    // The first frame in the report starts now
+    profilerReportOpen();
+    return;
+  }
+  ULL now = profilerAdd(PROFILER_FRAME, profiler_frame_start, busGetCyclesInThisFrame());
+  profilerReportFrame(busGetRasterFrameCount(), now);
+  profiler_frame_start = now;
+}
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+void profilerSetEnabled(bool enabled)
+{
+  if (enabled != profilerGetEnabled())
+  {
+    fellowAddLog("profiler: profiling %s\n", (enabled) ? "on" : "off");
+  }
+  profiler_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void profilerSetReportFormat(PROFILER_REPORT format)
+{
+  profiler_report_format = format;
+}
+
+PROFILER_REPORT profilerGetReportFormat(void)
+{
+  return profiler_report_format;
+}
+
+/*============================================================================*/
+/* Fellow module functions                                                    */
+/*============================================================================*/
+
+void profilerEmulationStop(void)
+{
+  if (profiler_report_file != NULL)
+  {
+    profilerReportClose();
+  }
+}
@@ -0,0 +1,430 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/* Rewind                                                                  */
+/*                                                                         */
+/* The snapshots are kept in a ring, a snapshot that is pushed out leaves  */
+/* the snapshots after it without a keyframe until the next keyframe is    */
+/* pushed out too. The ring has room for one keyframe interval more than   */
+/* the configured seconds so that those are always restorable.            */
+/*                                                                         */
+/* The pages written between snapshots are marked by the memory module,    */
+/* see memoryGetRamDirtyPages(). It only marks them while rewind is on.    */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "fmem.h"
+#include "bus.h"
+#include "timer.h"
+#include "savestate.h"
+#include "rewind.h"
+
+typedef struct
+{
+  ULL frame_no;
+  BOOLE keyframe;
+
+  // Module state, chunks from fellowSaveStateModules()
+  UBY *state;
+  ULO state_size;
+
+  // Pages of RAM, the RAM and page number of each page and its contents
+  ULO page_count;
+  ULO page_capacity;
+  ULO *page_numbers;
+  UBY *pages;
+} rewind_snapshot;
+
+#define REWIND_PAGE_NUMBER(ram, page) ((((ULO) (ram)) << 24) | (page))
+#define REWIND_PAGE_RAM(number) ((MEMORY_RAM) ((number) >> 24))
+#define REWIND_PAGE_INDEX(number) ((number) & 0xffffff)
+
+static ULO rewind_seconds;
+static rewind_snapshot *rewind_snapshots;
+static ULO rewind_capacity;
+static ULO rewind_first;
+static ULO rewind_count;
+static ULO rewind_snapshots_since_keyframe;
+
+static BOOLE rewind_restore_requested;
+static ULO rewind_restore_frames;
+
+// Statistics, logged when emulation stops
+static ULL rewind_statistics_snapshots;
+static ULL rewind_statistics_time;
+static ULL rewind_statistics_time_max;
+static ULL rewind_statistics_pages;
+
+static rewind_snapshot *rewindGetSnapshot(ULO index)
+{
+  return rewind_snapshots + ((rewind_first + index) % rewind_capacity);
+}
+
+/*============================================================================*/
+/* History                                                                    */
+/*============================================================================*/
+
+/* The first snapshot after the history is cleared is a keyframe, memory */
+/* can start or stop marking pages then.                                 */
+static void rewindClear(void)
+{
+  rewind_first = 0;
+  rewind_count = 0;
+  rewind_snapshots_since_keyframe = 0;
+  rewind_restore_requested = FALSE;
+  memorySetDirtyPagesEnabled(rewind_capacity != 0 && fellowStateIsSupported());
+}
+
+static void rewindFree(void)
+{
+  for (ULO i = 0; i < rewind_capacity; i++)
+  {
+    free(rewind_snapshots[i].state);
+    free(rewind_snapshots[i].page_numbers);
+    free(rewind_snapshots[i].pages);
+  }
+  free(rewind_snapshots);
+  rewind_snapshots = NULL;
+  rewind_capacity = 0;
+  rewindClear();
+}
+
+static void rewindClearDirtyPages(void)
+{
+  for (ULO ram = 0; ram < MEMORY_RAM_COUNT; ram++)
+  {
+    memset(memoryGetRamDirtyPages((MEMORY_RAM) ram), 0, memoryGetRamSize((MEMORY_RAM) ram) >> MEMORY_PAGE_SHIFT);
+  }
+}
+
+/*============================================================================*/
+/* Snapshots                                                                  */
+/* The page buffers of a slot in the ring are kept when the slot is reused.   */
+/* They are shrunk when they are more than twice as large as the snapshot     */
+/* needs, so a slot that no longer holds a keyframe does not keep a buffer    */
+/* the size of all RAM.                                                       */
+/*============================================================================*/
+
+static void rewindFreePages(rewind_snapshot *snapshot)
+{
+  free(snapshot->page_numbers);
+  free(snapshot->pages);
+  snapshot->page_numbers = NULL;
+  snapshot->pages = NULL;
+  snapshot->page_count = 0;
+  snapshot->page_capacity = 0;
+}
+
+/* Returns FALSE when there is not enough memory, the old buffers are kept then */
+static BOOLE rewindResizePages(rewind_snapshot *snapshot, ULO page_capacity)
+{
+  ULO *new_page_numbers;
+  UBY *new_pages;
+
+  if (page_capacity == 0)
+  {
+    rewindFreePages(snapshot);
+    return TRUE;
+  }
+  new_page_numbers = (ULO *) realloc(snapshot->page_numbers, page_capacity*sizeof(ULO));
+  if (new_page_numbers == NULL)
+  {
+    return FALSE;
+  }
+  snapshot->page_numbers = new_page_numbers;
+  new_pages = (UBY *) realloc(snapshot->pages, (size_t) page_capacity << MEMORY_PAGE_SHIFT);
+  if (new_pages == NULL)
+  {
+    // Both buffers still have room for the smaller of the two capacities
+    if (page_capacity < snapshot->page_capacity)
+    {
+      snapshot->page_capacity = page_capacity;
+    }
+    return FALSE;
+  }
+  snapshot->pages = new_pages;
+  snapshot->page_capacity = page_capacity;
+  return TRUE;
+}
+
+static ULO rewindCountPages(BOOLE keyframe)
+{
+  ULO count = 0;
+
+  for (ULO ram = 0; ram < MEMORY_RAM_COUNT; ram++)
+  {
+    ULO pages = memoryGetRamSize((MEMORY_RAM) ram) >> MEMORY_PAGE_SHIFT;
+    UBY *dirty = memoryGetRamDirtyPages((MEMORY_RAM) ram);
+
+    if (keyframe)
+    {
+      count += pages;
+      continue;
+    }
+    for (ULO page = 0; page < pages; page++)
+    {
+      count += dirty[page];
+    }
+  }
+  return count;
+}
+
+static void rewindCopyPages(rewind_snapshot *snapshot)
+{
+  ULO count = 0;
+
+  for (ULO ram = 0; ram < MEMORY_RAM_COUNT; ram++)
+  {
+    ULO pages = memoryGetRamSize((MEMORY_RAM) ram) >> MEMORY_PAGE_SHIFT;
+    UBY *dirty = memoryGetRamDirtyPages((MEMORY_RAM) ram);
+    UBY *memory = memoryGetRam((MEMORY_RAM) ram);
+
+    for (ULO page = 0; page < pages; page++)
+    {
+      if (snapshot->keyframe || dirty[page])
+      {
+	snapshot->page_numbers[count] = REWIND_PAGE_NUMBER(ram, page);
+	memcpy(snapshot->pages + ((size_t) count << MEMORY_PAGE_SHIFT), memory + (page << MEMORY_PAGE_SHIFT), MEMORY_PAGE_SIZE);
+	count++;
+      }
+    }
+    memset(dirty, 0, pages);
+  }
+}
+
+static void rewindTakeSnapshot(void)
+{
+  ULL start = timerGetTimeUs();
+  rewind_snapshot *snapshot;
+  savestate *S;
+
+  if (rewind_count == rewind_capacity)
+  {
+    rewind_first = (rewind_first + 1) % rewind_capacity;
+    rewind_count--;
+  }
+  snapshot = rewindGetSnapshot(rewind_count);
+  snapshot->frame_no = busGetRasterFrameCount();
+  snapshot->keyframe = (rewind_count == 0) || (rewind_snapshots_since_keyframe + 1 >= REWIND_SNAPSHOTS_PER_KEYFRAME);
+  snapshot->page_count = rewindCountPages(snapshot->keyframe);
+  if (snapshot->page_count > snapshot->page_capacity)
+  {
+    if (!rewindResizePages(snapshot, snapshot->page_count))
+    {
+      fellowAddLog("rewind: Out of memory for the pages of a snapshot, rewind is turned off\n");
+      rewindFree();
+      rewind_seconds = 0;
+      return;
+    }
+  }
+  else if (snapshot->page_count < snapshot->page_capacity/2)
+  {
+    // A smaller buffer is not needed, the larger one still works if it fails
+    rewindResizePages(snapshot, snapshot->page_count);
+  }
+  rewindCopyPages(snapshot);
+
+  free(snapshot->state);
+  S = savestateOpenMemoryWrite();
+  fellowSaveStateModules(S);
+  snapshot->state = (UBY *) savestateCloseMemory(S, &snapshot->state_size);
+  if (snapshot->state == NULL)
+  {
+    fellowAddLog("rewind: Unable to take a snapshot, the history is cleared\n");
+    rewindClear();
+    return;
+  }
+
+  rewind_snapshots_since_keyframe = (snapshot->keyframe) ? 0 : (rewind_snapshots_since_keyframe + 1);
+  rewind_count++;
+
+  ULL time = timerGetTimeUs() - start;
+  rewind_statistics_snapshots++;
+  rewind_statistics_time += time;
+  if (time > rewind_statistics_time_max) rewind_statistics_time_max = time;
+  rewind_statistics_pages += snapshot->page_count;
+}
+
+/*============================================================================*/
+/* Restore                                                                    */
+/* Goes back to the last snapshot at least frames before the present frame,   */
+/* or to the oldest that can be restored. The snapshots after it are dropped. */
+/* Returns the number of frames gone back, 0 when there was nothing to go     */
+/* back to.                                                                   */
+/*============================================================================*/
+
+ULO rewindRestore(ULO frames)
+{
+  ULL now = busGetRasterFrameCount();
+  ULO keyframe = rewind_count;
+  ULO target = rewind_count;
+  savestate *S;
+  BOOLE result;
+
+  for (ULO i = 0; i < rewind_count; i++)
+  {
+    rewind_snapshot *snapshot = rewindGetSnapshot(i);
+
+    if (snapshot->keyframe)
+    {
+      if (keyframe == rewind_count || snapshot->frame_no + frames <= now)
+      {
+	keyframe = i;
+      }
+    }
+    if (keyframe != rewind_count && (target == rewind_count || snapshot->frame_no + frames <= now))
+    {
+      target = i;
+    }
+  }
+  if (target == rewind_count)
+  {
+    return 0;
+  }
+
+  for (ULO i = keyframe; i <= target; i++)
+  {
+    rewind_snapshot *snapshot = rewindGetSnapshot(i);
+
+    for (ULO page = 0; page < snapshot->page_count; page++)
+    {
+      ULO number = snapshot->page_numbers[page];
+      UBY *memory = memoryGetRam(REWIND_PAGE_RAM(number));
+
+      memcpy(memory + (REWIND_PAGE_INDEX(number) << MEMORY_PAGE_SHIFT), snapshot->pages + ((size_t) page << MEMORY_PAGE_SHIFT), MEMORY_PAGE_SIZE);
+    }
+  }
+  rewindClearDirtyPages();
+
+  // The snapshots after the target are dropped, with the keyframes among them
+  for (ULO i = target + 1; i < rewind_count; i++)
+  {
+    rewindFreePages(rewindGetSnapshot(i));
+  }
+
+  S = savestateOpenMemoryRead(rewindGetSnapshot(target)->state, rewindGetSnapshot(target)->state_size);
+  fellowLoadStateChunks(S);
+  result = savestateClose(S);
+
+  rewind_count = target + 1;
+  rewind_snapshots_since_keyframe = target - keyframe;
+  rewind_restore_requested = FALSE;
+  if (!result)
+  {
+    fellowAddLog("rewind: Unable to restore a snapshot, the history is cleared and the machine is reset\n");
+    rewindClear();
+    fellowSetPreStartReset(TRUE);
+    fellowRequestEmulationStop();
+    return 0;
+  }
+  return (ULO) (now - busGetRasterFrameCount());
+}
+
+/* Rewinds at the end of the frame, for requests made while emulation runs */
+void rewindRequestRestore(ULO frames)
+{
+  if (rewind_capacity != 0)
+  {
+    rewind_restore_requested = TRUE;
+    rewind_restore_frames = frames;
+  }
+}
+
+/*============================================================================*/
+/* Called by the bus at the very end of each frame                            */
+/*============================================================================*/
+
+void rewindEndOfFrame(void)
+{
+  if (rewind_capacity == 0 || !fellowStateIsSupported())
+  {
+    return;
+  }
+  if (rewind_restore_requested)
+  {
+    ULO frames = rewindRestore(rewind_restore_frames);
+    fellowAddLog("rewind: Went back %u frames\n", frames);
+    return;
+  }
+  if ((busGetRasterFrameCount() % REWIND_FRAMES_PER_SNAPSHOT) == 0)
+  {
+    rewindTakeSnapshot();
+  }
+}
+
+/*============================================================================*/
+/* Configuration                                                              */
+/*============================================================================*/
+
+void rewindSetSeconds(ULO seconds)
+{
+  ULO capacity = (seconds == 0) ? 0 : ((seconds*50 + REWIND_FRAMES_PER_SNAPSHOT - 1)/REWIND_FRAMES_PER_SNAPSHOT + REWIND_SNAPSHOTS_PER_KEYFRAME);
+
+  rewind_seconds = seconds;
+  if (capacity != rewind_capacity)
+  {
+    rewindFree();
+    if (capacity != 0)
+    {
+      rewind_snapshots = (rewind_snapshot *) calloc(capacity, sizeof(rewind_snapshot));
+      if (rewind_snapshots == NULL)
+      {
+	fellowAddLog("rewind: Out of memory for %u snapshots, rewind is turned off\n", capacity);
+	rewind_seconds = 0;
+	return;
+      }
+      rewind_capacity = capacity;
+      rewindClear();
+    }
+  }
+}
+
+ULO rewindGetSeconds(void)
+{
+  return rewind_seconds;
+}
+
+/*============================================================================*/
+/* Fellow module functions                                                    */
+/*============================================================================*/
+
+/* Memory may be mapped differently after a reset, the history is dropped */
+void rewindHardReset(void)
+{
+  rewindClear();
+}
+
+void rewindEmulationStop(void)
+{
+  if (rewind_statistics_snapshots != 0)
+  {
+    ULL bytes = 0;
+    ULL buffer_bytes = 0;
+
+    for (ULO i = 0; i < rewind_count; i++)
+    {
+      bytes += ((ULL) rewindGetSnapshot(i)->page_count << MEMORY_PAGE_SHIFT) + rewindGetSnapshot(i)->state_size;
+    }
+    for (ULO i = 0; i < rewind_capacity; i++)
+    {
+      buffer_bytes += (ULL) rewind_snapshots[i].page_capacity << MEMORY_PAGE_SHIFT;
+    }
+    fellowAddLog("rewind: %llu snapshots, %llu us on average, %llu us at most, %llu pages on average, %u snapshots holding %llu KB, %llu KB of page buffers\n",
+      rewind_statistics_snapshots, rewind_statistics_time/rewind_statistics_snapshots, rewind_statistics_time_max,
+      rewind_statistics_pages/rewind_statistics_snapshots, rewind_count, bytes >> 10, buffer_bytes >> 10);
+  }
+  rewind_statistics_snapshots = 0;
+  rewind_statistics_time = 0;
+  rewind_statistics_time_max = 0;
+  rewind_statistics_pages = 0;
+}
+
+void rewindShutdown(void)
+{
+  rewindFree();
+}
@@ -0,0 +1,396 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/* State files                                                             */
+/*                                                                         */
+/* The file format is in savestate.h. The file is compressed as it is      */
+/* written and uncompressed as it is read, through the zlib gz functions.  */
+/* A chunk is collected in memory until it ends so that its length can be  */
+/* written before it. Memory is written with savestateWriteChunk() and     */
+/* read with savestateRead(), straight from and into the memory arrays.    */
+/*                                                                         */
+/* A state can also be kept in a buffer in memory, uncompressed. Rewind    */
+/* keeps the module state of its snapshots like that.                      */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "zlib.h"
+#include "savestate.h"
+
+/* The last chunk in a file, a file without it has been cut short */
+#define SAVESTATE_END SAVESTATE_ID('E', 'N', 'D', ' ')
+
+/* Level 1 deflate, memory is mostly runs and repeated code and data */
+#define SAVESTATE_GZIP_MODE_WRITE "wb1"
+#define SAVESTATE_GZIP_BUFFER_SIZE 0x40000
+
+struct savestate_
+{
+  gzFile file;
+  BOOLE writing;
+  BOOLE failed;
+
+  // The buffer of a state in memory, file is NULL then
+  UBY *buffer;
+  ULO buffer_size;
+  ULO buffer_capacity;
+  ULO buffer_position;
+  BOOLE buffer_owned;
+
+  // The chunk being written
+  UBY *chunk_data;
+  ULO chunk_size;
+  ULO chunk_capacity;
+  ULO chunk_id;
+  ULO chunk_version;
+  BOOLE chunk_open;
+
+  // The chunk being read, chunk_left is the part not read yet
+  ULO chunk_left;
+  ULO chunk_length;
+};
+
+void savestateFail(savestate *S, const STR *reason)
+{
+  if (!S->failed)
+  {
+    fellowAddLog("savestate: %s\n", reason);
+    S->failed = TRUE;
+  }
+}
+
+BOOLE savestateFailed(savestate *S)
+{
+  return S->failed;
+}
+
+/* Makes room for size more bytes after used bytes in a buffer, the state */
+/* fails and the buffer is kept as it is when there is not enough memory.  */
+static BOOLE savestateGrow(savestate *S, UBY **buffer, ULO *capacity, ULO used, ULO size)
+{
+  if (used + size > *capacity)
+  {
+    ULO new_capacity = (*capacity == 0) ? 4096 : *capacity;
+    UBY *new_buffer;
+    while (used + size > new_capacity)
+    {
+      new_capacity *= 2;
+    }
+    new_buffer = (UBY *) realloc(*buffer, new_capacity);
+    if (new_buffer == NULL)
+    {
+      savestateFail(S, "Out of memory");
+      return FALSE;
+    }
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+  }
+  return TRUE;
+}
+
+static void savestateOutput(savestate *S, const void *data, ULO size)
+{
+  if (S->failed || size == 0)
+  {
+    return;
+  }
+  if (S->file == NULL)
+  {
+    if (!savestateGrow(S, &S->buffer, &S->buffer_capacity, S->buffer_size, size))
+    {
+      return;
+    }
+    memcpy(S->buffer + S->buffer_size, data, size);
+    S->buffer_size += size;
+  }
+  else if (gzwrite(S->file, data, size) != (int) size)
+  {
+    savestateFail(S, "Unable to write the state file");
+  }
+}
+
+static BOOLE savestateInput(savestate *S, void *data, ULO size)
+{
+  if (S->failed)
+  {
+    return FALSE;
+  }
+  if (size == 0)
+  {
+    return TRUE;
+  }
+  if (S->file == NULL)
+  {
+    if (size > S->buffer_size - S->buffer_position)
+    {
+      savestateFail(S, "The state ends too early");
+      return FALSE;
+    }
+    memcpy(data, S->buffer + S->buffer_position, size);
+    S->buffer_position += size;
+  }
+  else if (gzread(S->file, data, size) != (int) size)
+  {
+    savestateFail(S, "The state file ends too early");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/* Moves past size bytes of input */
+static BOOLE savestateSkip(savestate *S, ULO size)
+{
+  if (S->file == NULL)
+  {
+    if (size > S->buffer_size - S->buffer_position)
+    {
+      savestateFail(S, "The state ends too early");
+      return FALSE;
+    }
+    S->buffer_position += size;
+  }
+  else if (gzseek(S->file, size, SEEK_CUR) == -1)
+  {
+    savestateFail(S, "The state file ends too early");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+static void savestateOutputHeader(savestate *S, ULO id, ULO version, ULO size)
+{
+  ULO header[3] = {id, version, size};
+  savestateOutput(S, header, sizeof(header));
+}
+
+static savestate *savestateOpen(const STR *filename, const STR *mode, BOOLE writing)
+{
+  gzFile file = gzopen(filename, mode);
+  savestate *S;
+
+  if (file == NULL)
+  {
+    fellowAddLog("savestate: Unable to open %s\n", filename);
+    return NULL;
+  }
+  gzbuffer(file, SAVESTATE_GZIP_BUFFER_SIZE);
+  S = (savestate *) malloc(sizeof(savestate));
+  memset(S, 0, sizeof(savestate));
+  S->file = file;
+  S->writing = writing;
+  return S;
+}
+
+savestate *savestateOpenWrite(const STR *filename)
+{
+  savestate *S = savestateOpen(filename, SAVESTATE_GZIP_MODE_WRITE, TRUE);
+  ULO header[2] = {SAVESTATE_MAGIC, SAVESTATE_FORMAT_VERSION};
+
+  if (S != NULL)
+  {
+    savestateOutput(S, header, sizeof(header));
+  }
+  return S;
+}
+
+savestate *savestateOpenRead(const STR *filename)
+{
+  savestate *S = savestateOpen(filename, "rb", FALSE);
+  ULO header[2] = {0, 0};
+
+  if (S == NULL)
+  {
+    return NULL;
+  }
+  if (!savestateInput(S, header, sizeof(header)) || header[0] != SAVESTATE_MAGIC)
+  {
+    fellowAddLog("savestate: %s is not a state file\n", filename);
+    savestateClose(S);
+    return NULL;
+  }
+  if (header[1] > SAVESTATE_FORMAT_VERSION)
+  {
+    fellowAddLog("savestate: %s is a version %u state file, this version of Fellow reads version %u\n", filename, header[1], SAVESTATE_FORMAT_VERSION);
+    savestateClose(S);
+    return NULL;
+  }
+  return S;
+}
+
+/* A state in memory has no header, it is never kept beyond the session */
+savestate *savestateOpenMemoryWrite(void)
+{
+  savestate *S = (savestate *) malloc(sizeof(savestate));
+
+  memset(S, 0, sizeof(savestate));
+  S->writing = TRUE;
+  S->buffer_owned = TRUE;
+  return S;
+}
+
+/* The buffer is not copied, it must be kept until the state is closed */
+savestate *savestateOpenMemoryRead(const void *data, ULO size)
+{
+  savestate *S = (savestate *) malloc(sizeof(savestate));
+
+  memset(S, 0, sizeof(savestate));
+  S->buffer = (UBY *) data;
+  S->buffer_size = size;
+  return S;
+}
+
+static void savestateEnd(savestate *S)
+{
+  if (S->writing)
+  {
+    if (S->chunk_open)
+    {
+      savestateChunkEnd(S);
+    }
+    savestateOutputHeader(S, SAVESTATE_END, 1, 0);
+  }
+}
+
+static BOOLE savestateFree(savestate *S)
+{
+  BOOLE result = !S->failed;
+
+  if (S->buffer_owned)
+  {
+    free(S->buffer);
+  }
+  free(S->chunk_data);
+  free(S);
+  return result;
+}
+
+/* Returns FALSE if anything went wrong while the file was open */
+BOOLE savestateClose(savestate *S)
+{
+  savestateEnd(S);
+  if (S->file != NULL && gzclose(S->file) != Z_OK)
+  {
+    savestateFail(S, "Unable to close the state file");
+  }
+  return savestateFree(S);
+}
+
+/* Closes a state written to memory and hands the buffer to the caller, */
+/* who frees it. Returns NULL if anything went wrong.                   */
+void *savestateCloseMemory(savestate *S, ULO *size)
+{
+  void *data = NULL;
+
+  savestateEnd(S);
+  if (!S->failed)
+  {
+    data = S->buffer;
+    *size = S->buffer_size;
+    S->buffer_owned = FALSE;
+  }
+  savestateFree(S);
+  return data;
+}
+
+/*============================================================================*/
+/* Writing                                                                    */
+/*============================================================================*/
+
+void savestateChunkBegin(savestate *S, ULO id, ULO version)
+{
+  S->chunk_id = id;
+  S->chunk_version = version;
+  S->chunk_size = 0;
+  S->chunk_open = TRUE;
+}
+
+void savestateWrite(savestate *S, const void *data, ULO size)
+{
+  if (S->failed || !savestateGrow(S, &S->chunk_data, &S->chunk_capacity, S->chunk_size, size))
+  {
+    return;
+  }
+  memcpy(S->chunk_data + S->chunk_size, data, size);
+  S->chunk_size += size;
+}
+
+void savestateChunkEnd(savestate *S)
+{
+  savestateOutputHeader(S, S->chunk_id, S->chunk_version, S->chunk_size);
+  savestateOutput(S, S->chunk_data, S->chunk_size);
+  S->chunk_open = FALSE;
+}
+
+/* Writes a chunk that is one block of memory */
+void savestateWriteChunk(savestate *S, ULO id, ULO version, const void *data, ULO size)
+{
+  savestateOutputHeader(S, id, version, size);
+  savestateOutput(S, data, size);
+}
+
+/*============================================================================*/
+/* Reading                                                                    */
+/*============================================================================*/
+
+/* Moves to the next chunk, returns FALSE at the end of the file or when the */
+/* file could not be read.                                                   */
+BOOLE savestateChunkNext(savestate *S)
+{
+  ULO header[3];
+
+  if (S->failed)
+  {
+    return FALSE;
+  }
+  if (S->chunk_left != 0 && !savestateSkip(S, S->chunk_left))
+  {
+    return FALSE;
+  }
+  S->chunk_left = 0;
+  if (!savestateInput(S, header, sizeof(header)))
+  {
+    return FALSE;
+  }
+  S->chunk_id = header[0];
+  S->chunk_version = header[1];
+  S->chunk_length = header[2];
+  S->chunk_left = header[2];
+  return S->chunk_id != SAVESTATE_END;
+}
+
+ULO savestateGetChunkId(savestate *S)
+{
+  return S->chunk_id;
+}
+
+ULO savestateGetChunkVersion(savestate *S)
+{
+  return S->chunk_version;
+}
+
+ULO savestateGetChunkSize(savestate *S)
+{
+  return S->chunk_length;
+}
+
+/* A read past the end of the chunk fails and gives zeros */
+void savestateRead(savestate *S, void *data, ULO size)
+{
+  ULO available = (size <= S->chunk_left) ? size : S->chunk_left;
+
+  if (!savestateInput(S, data, available))
+  {
+    available = 0;
+  }
+  S->chunk_left -= available;
+  if (available < size)
+  {
+    memset(((UBY *) data) + available, 0, size - available);
+    savestateFail(S, "A chunk in the state file is shorter than expected");
+  }
+}
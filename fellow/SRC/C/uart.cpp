@@ -121,34 +121,36 @@ void UART::ClearState()
   _receiveDoneTime = BUS_CYCLE_DISABLE;
 }
 
-void UART::LoadState(FILE *F)
-{
-  fread(&_serper, sizeof(_serper), 1, F);
-  fread(&_transmitBuffer, sizeof(_transmitBuffer), 1, F);
-  fread(&_transmitShiftRegister, sizeof(_transmitShiftRegister), 1, F);
-  fread(&_transmitDoneTime, sizeof(_transmitDoneTime), 1, F);
-  fread(&_transmitBufferEmpty, sizeof(_transmitBufferEmpty), 1, F);
-  fread(&_transmitShiftRegisterEmpty, sizeof(_transmitShiftRegisterEmpty), 1, F);
-  fread(&_receiveBuffer, sizeof(_receiveBuffer), 1, F);
-  fread(&_receiveShiftRegister, sizeof(_receiveShiftRegister), 1, F);
-  fread(&_receiveDoneTime, sizeof(_receiveDoneTime), 1, F);
-  fread(&_receiveBufferFull, sizeof(_receiveBufferFull), 1, F);
-  fread(&_receiveBufferOverrun, sizeof(_receiveBufferOverrun), 1, F);
-}
-
-void UART::SaveState(FILE *F)
-{
-  fwrite(&_serper, sizeof(_serper), 1, F);
-  fwrite(&_transmitBuffer, sizeof(_transmitBuffer), 1, F);
-  fwrite(&_transmitShiftRegister, sizeof(_transmitShiftRegister), 1, F);
-  fwrite(&_transmitDoneTime, sizeof(_transmitDoneTime), 1, F);
-  fwrite(&_transmitBufferEmpty, sizeof(_transmitBufferEmpty), 1, F);
-  fwrite(&_transmitShiftRegisterEmpty, sizeof(_transmitShiftRegisterEmpty), 1, F);
-  fwrite(&_receiveBuffer, sizeof(_receiveBuffer), 1, F);
-  fwrite(&_receiveShiftRegister, sizeof(_receiveShiftRegister), 1, F);
-  fwrite(&_receiveDoneTime, sizeof(_receiveDoneTime), 1, F);
-  fwrite(&_receiveBufferFull, sizeof(_receiveBufferFull), 1, F);
-  fwrite(&_receiveBufferOverrun, sizeof(_receiveBufferOverrun), 1, F);
+void UART::LoadState(savestate *S)
+{
+  savestateReadValue(S, _serper);
+  savestateReadValue(S, _transmitBuffer);
+  savestateReadValue(S, _transmitShiftRegister);
+  savestateReadValue(S, _transmitDoneTime);
+  savestateReadValue(S, _transmitBufferEmpty);
+  savestateReadValue(S, _transmitShiftRegisterEmpty);
+  savestateReadValue(S, _receiveBuffer);
+  savestateReadValue(S, _receiveShiftRegister);
+  savestateReadValue(S, _receiveDoneTime);
+  savestateReadValue(S, _receiveBufferFull);
+  savestateReadValue(S, _receiveBufferOverrun);
+}
+
+void UART::SaveState(savestate *S)
+{
+  savestateChunkBegin(S, SAVESTATE_UART, SAVESTATE_UART_VERSION);
+  savestateWriteValue(S, _serper);
+  savestateWriteValue(S, _transmitBuffer);
+  savestateWriteValue(S, _transmitShiftRegister);
+  savestateWriteValue(S, _transmitDoneTime);
+  savestateWriteValue(S, _transmitBufferEmpty);
+  savestateWriteValue(S, _transmitShiftRegisterEmpty);
+  savestateWriteValue(S, _receiveBuffer);
+  savestateWriteValue(S, _receiveShiftRegister);
+  savestateWriteValue(S, _receiveDoneTime);
+  savestateWriteValue(S, _receiveBufferFull);
+  savestateWriteValue(S, _receiveBufferOverrun);
+  savestateChunkEnd(S);
 }
 
 bool UART::Is8BitMode()
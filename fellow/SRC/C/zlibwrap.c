@@ -79,7 +79,7 @@ BOOLE gzPack(const char *src, const char *dest)
     length = fread(buffer, 1, sizeof(buffer), input);
     if(ferror(input)) return FALSE;
     if(length == 0) break;
-    if(gzwrite(output, buffer, (unsigned)length) != length) return FALSE;
+    if(gzwrite(output, buffer, (unsigned)length) != (int)length) return FALSE;
   }
 
   if(fclose(input)) return FALSE;
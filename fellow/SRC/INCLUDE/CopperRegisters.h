@@ -2,6 +2,7 @@
 #define COPPERREGISTERS_H
 
 #include "DEFS.H"
+#include "savestate.h"
 
 class CopperRegisters
 {
@@ -17,8 +18,8 @@ public:
   void InstallIOHandlers();
 
   void ClearState();
-  void LoadState(FILE *F);
-  void SaveState(FILE *F);
+  void LoadState(savestate *S);
+  void SaveState(savestate *S);
 };
 
 extern CopperRegisters copper_registers;
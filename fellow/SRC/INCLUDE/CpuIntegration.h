@@ -1,6 +1,8 @@
 #ifndef CpuIntegration_H
 #define CpuIntegration_H
 
+#include "savestate.h"
+
 typedef enum {
   M68000  = 0,
   M68010  = 1,
@@ -13,6 +15,7 @@ typedef enum {
 extern void cpuIntegrationCalculateMultiplier(void);
 
 extern void cpuIntegrationExecuteInstructionEventHandler68000Fast(void);
+extern void cpuIntegrationExecuteInstructionsUntil68000Fast(ULO deadline);
 extern void cpuIntegrationExecuteInstructionEventHandler68000General(void);
 extern void cpuIntegrationExecuteInstructionEventHandler68020(void);
 extern ULO cpuIntegrationDisOpcode(ULO disasm_pc, STR *saddress, STR *sdata, STR *sinstruction, STR *soperands);
@@ -33,8 +36,8 @@ extern ULO cpuIntegrationGetChipSlowdown(void);
 extern jmp_buf cpu_integration_exception_buffer;
 
 // Fellow limecycle events
-extern void cpuIntegrationSaveState(FILE *F);
-extern void cpuIntegrationLoadState(FILE *F);
+extern void cpuIntegrationSaveState(savestate *S);
+extern void cpuIntegrationLoadState(savestate *S);
 extern void cpuIntegrationEmulationStart(void);
 extern void cpuIntegrationEmulationStop(void);
 extern void cpuIntegrationHardReset(void);
@@ -1,6 +1,8 @@
 #ifndef CpuModule_H
 #define CpuModule_H
 
+#include "savestate.h"
+
 // This header file defines the internal interfaces of the CPU module.
 
 #ifdef _DEBUG
@@ -72,8 +74,8 @@ extern ULO cpuGetIrqLevel(void);
 extern ULO cpuExecuteInstruction(void);
 extern ULO cpuDisOpcode(ULO disasm_pc, STR *saddress, STR *sdata, STR *sinstruction, STR *soperands);
 
-extern void cpuSaveState(FILE *F);
-extern void cpuLoadState(FILE *F);
+extern void cpuSaveState(savestate *S);
+extern void cpuLoadState(savestate *S);
 extern void cpuHardReset(void);
 extern void cpuStartup(void);
 
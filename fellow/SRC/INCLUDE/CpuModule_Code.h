@@ -155,7 +155,7 @@ static void ADD_D078(ULO*opc_data)
 }
 static void ADD_D079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	dst = cpuAddW(dst, src);
 	cpuSetDRegWord(opc_data[1], dst);
@@ -251,7 +251,7 @@ static void ADD_D0B8(ULO*opc_data)
 }
 static void ADD_D0B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	dst = cpuAddL(dst, src);
 	cpuSetDReg(opc_data[1], dst);
@@ -402,9 +402,9 @@ static void ADD_D179(ULO*opc_data)
 {
 	UWO src = cpuGetDRegWord(opc_data[1]);
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAddW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void ADD_D190(ULO*opc_data)
@@ -465,9 +465,9 @@ static void ADD_D1B9(ULO*opc_data)
 {
 	ULO src = cpuGetDReg(opc_data[1]);
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuAddL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void ADDA_D0C0(ULO*opc_data)
@@ -536,7 +536,7 @@ static void ADDA_D0F8(ULO*opc_data)
 }
 static void ADDA_D0F9(ULO*opc_data)
 {
-	ULO src = (ULO)(LON)(WOR)memoryReadWord(cpuEA71());
+	ULO src = (ULO)(LON)(WOR)memoryReadWordAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	dst = cpuAddaL(dst, src);
 	cpuSetAReg(opc_data[1], dst);
@@ -632,7 +632,7 @@ static void ADDA_D1F8(ULO*opc_data)
 }
 static void ADDA_D1F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	dst = cpuAddaL(dst, src);
 	cpuSetAReg(opc_data[1], dst);
@@ -799,9 +799,9 @@ static void ADDI_0679(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAddW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void ADDI_0680(ULO*opc_data)
@@ -870,9 +870,9 @@ static void ADDI_06B9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuAddL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(36);
 }
 static void ADDQ_5000(ULO*opc_data)
@@ -1012,9 +1012,9 @@ static void ADDQ_5079(ULO*opc_data)
 {
 	UWO src = (UWO)opc_data[1];
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAddW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void ADDQ_5080(ULO*opc_data)
@@ -1083,9 +1083,9 @@ static void ADDQ_50B9(ULO*opc_data)
 {
 	ULO src = opc_data[1];
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuAddL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void ADDQ_5048(ULO*opc_data)
@@ -1250,7 +1250,7 @@ static void AND_C078(ULO*opc_data)
 }
 static void AND_C079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	dst = cpuAndW(dst, src);
 	cpuSetDRegWord(opc_data[1], dst);
@@ -1338,7 +1338,7 @@ static void AND_C0B8(ULO*opc_data)
 }
 static void AND_C0B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	dst = cpuAndL(dst, src);
 	cpuSetDReg(opc_data[1], dst);
@@ -1489,9 +1489,9 @@ static void AND_C179(ULO*opc_data)
 {
 	UWO src = cpuGetDRegWord(opc_data[1]);
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAndW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void AND_C190(ULO*opc_data)
@@ -1552,9 +1552,9 @@ static void AND_C1B9(ULO*opc_data)
 {
 	ULO src = cpuGetDReg(opc_data[1]);
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuAndL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void ANDI_0200(ULO*opc_data)
@@ -1694,9 +1694,9 @@ static void ANDI_0279(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAndW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void ANDI_0280(ULO*opc_data)
@@ -1765,9 +1765,9 @@ static void ANDI_02B9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuAndL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(36);
 }
 static void ANDI_023C(ULO*opc_data)
@@ -1917,9 +1917,9 @@ static void EOR_B179(ULO*opc_data)
 {
 	UWO src = cpuGetDRegWord(opc_data[1]);
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuEorW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(16);
 }
 static void EOR_B180(ULO*opc_data)
@@ -1988,9 +1988,9 @@ static void EOR_B1B9(ULO*opc_data)
 {
 	ULO src = cpuGetDReg(opc_data[1]);
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuEorL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void EORI_0A00(ULO*opc_data)
@@ -2130,9 +2130,9 @@ static void EORI_0A79(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuEorW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void EORI_0A80(ULO*opc_data)
@@ -2201,9 +2201,9 @@ static void EORI_0AB9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuEorL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(36);
 }
 static void EORI_0A3C(ULO*opc_data)
@@ -2362,7 +2362,7 @@ static void OR_8078(ULO*opc_data)
 }
 static void OR_8079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	dst = cpuOrW(dst, src);
 	cpuSetDRegWord(opc_data[1], dst);
@@ -2450,7 +2450,7 @@ static void OR_80B8(ULO*opc_data)
 }
 static void OR_80B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	dst = cpuOrL(dst, src);
 	cpuSetDReg(opc_data[1], dst);
@@ -2601,9 +2601,9 @@ static void OR_8179(ULO*opc_data)
 {
 	UWO src = cpuGetDRegWord(opc_data[1]);
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuOrW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void OR_8190(ULO*opc_data)
@@ -2664,9 +2664,9 @@ static void OR_81B9(ULO*opc_data)
 {
 	ULO src = cpuGetDReg(opc_data[1]);
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuOrL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void ORI_0000(ULO*opc_data)
@@ -2806,9 +2806,9 @@ static void ORI_0079(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuOrW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void ORI_0080(ULO*opc_data)
@@ -2877,9 +2877,9 @@ static void ORI_00B9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuOrL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(36);
 }
 static void ORI_003C(ULO*opc_data)
@@ -3046,7 +3046,7 @@ static void SUB_9078(ULO*opc_data)
 }
 static void SUB_9079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	dst = cpuSubW(dst, src);
 	cpuSetDRegWord(opc_data[1], dst);
@@ -3142,7 +3142,7 @@ static void SUB_90B8(ULO*opc_data)
 }
 static void SUB_90B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	dst = cpuSubL(dst, src);
 	cpuSetDReg(opc_data[1], dst);
@@ -3293,9 +3293,9 @@ static void SUB_9179(ULO*opc_data)
 {
 	UWO src = cpuGetDRegWord(opc_data[1]);
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuSubW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void SUB_9190(ULO*opc_data)
@@ -3356,9 +3356,9 @@ static void SUB_91B9(ULO*opc_data)
 {
 	ULO src = cpuGetDReg(opc_data[1]);
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuSubL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void SUBA_90C0(ULO*opc_data)
@@ -3427,7 +3427,7 @@ static void SUBA_90F8(ULO*opc_data)
 }
 static void SUBA_90F9(ULO*opc_data)
 {
-	ULO src = (ULO)(LON)(WOR)memoryReadWord(cpuEA71());
+	ULO src = (ULO)(LON)(WOR)memoryReadWordAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	dst = cpuSubaW(dst, src);
 	cpuSetAReg(opc_data[1], dst);
@@ -3523,7 +3523,7 @@ static void SUBA_91F8(ULO*opc_data)
 }
 static void SUBA_91F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	dst = cpuSubaL(dst, src);
 	cpuSetAReg(opc_data[1], dst);
@@ -3690,9 +3690,9 @@ static void SUBI_0479(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuSubW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(24);
 }
 static void SUBI_0480(ULO*opc_data)
@@ -3761,9 +3761,9 @@ static void SUBI_04B9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuSubL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(36);
 }
 static void SUBQ_5100(ULO*opc_data)
@@ -3903,9 +3903,9 @@ static void SUBQ_5179(ULO*opc_data)
 {
 	UWO src = (UWO)opc_data[1];
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuSubW(dst, src);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void SUBQ_5180(ULO*opc_data)
@@ -3974,9 +3974,9 @@ static void SUBQ_51B9(ULO*opc_data)
 {
 	ULO src = opc_data[1];
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuSubL(dst, src);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void SUBQ_5148(ULO*opc_data)
@@ -4046,7 +4046,7 @@ static void CHK_41B8(ULO*opc_data)
 }
 static void CHK_41B9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	cpuChkW(dst, src);
 	cpuSetInstructionTime(22);
@@ -4123,7 +4123,7 @@ static void CHK_4138(ULO*opc_data)
 }
 static void CHK_4139(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	cpuChkL(dst, src);
 	cpuSetInstructionTime(26);
@@ -4284,7 +4284,7 @@ static void CMP_B078(ULO*opc_data)
 }
 static void CMP_B079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	cpuCmpW(dst, src);
 	cpuSetInstructionTime(16);
@@ -4368,7 +4368,7 @@ static void CMP_B0B8(ULO*opc_data)
 }
 static void CMP_B0B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	cpuCmpL(dst, src);
 	cpuSetInstructionTime(22);
@@ -4452,7 +4452,7 @@ static void CMPA_B0F8(ULO*opc_data)
 }
 static void CMPA_B0F9(ULO*opc_data)
 {
-	ULO src = (ULO)(LON)(WOR)memoryReadWord(cpuEA71());
+	ULO src = (ULO)(LON)(WOR)memoryReadWordAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	cpuCmpL(dst, src);
 	cpuSetInstructionTime(18);
@@ -4536,7 +4536,7 @@ static void CMPA_B1F8(ULO*opc_data)
 }
 static void CMPA_B1F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dst = cpuGetAReg(opc_data[1]);
 	cpuCmpL(dst, src);
 	cpuSetInstructionTime(22);
@@ -4684,7 +4684,7 @@ static void CMPI_0C79(ULO*opc_data)
 {
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	cpuCmpW(dst, src);
 	cpuSetInstructionTime(20);
 }
@@ -4747,7 +4747,7 @@ static void CMPI_0CB9(ULO*opc_data)
 {
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	cpuCmpL(dst, src);
 	cpuSetInstructionTime(28);
 }
@@ -5483,7 +5483,7 @@ static void MULS_C1F8(ULO*opc_data)
 }
 static void MULS_C1F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	ULO res = cpuMulsW(dst, src, 12);
 	cpuSetDReg(opc_data[1], res);
@@ -5560,7 +5560,7 @@ static void MULU_C0F8(ULO*opc_data)
 }
 static void MULU_C0F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	UWO dst = cpuGetDRegWord(opc_data[1]);
 	ULO res = cpuMuluW(dst, src, 12);
 	cpuSetDReg(opc_data[1], res);
@@ -5630,7 +5630,7 @@ static void DIVS_81F8(ULO*opc_data)
 }
 static void DIVS_81F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	cpuDivsW(dst, src, opc_data[1], opc_data[2]);
 }
@@ -5697,7 +5697,7 @@ static void DIVL_4C78(ULO*opc_data)
 static void DIVL_4C79(ULO*opc_data)
 {
 	UWO ext = cpuGetNextWord();
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	cpuDivL(src, ext, opc_data[2]);
 }
 static void DIVL_4C7A(ULO*opc_data)
@@ -5762,7 +5762,7 @@ static void DIVU_80F8(ULO*opc_data)
 }
 static void DIVU_80F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dst = cpuGetDReg(opc_data[1]);
 	cpuDivuW(dst, src, opc_data[1], opc_data[2]);
 }
@@ -6071,7 +6071,7 @@ static void CLR_4279(ULO*opc_data)
 	UWO dst = 0;
 	ULO dstea = cpuEA71();
 	cpuClr();
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void CLR_4280(ULO*opc_data)
@@ -6134,7 +6134,7 @@ static void CLR_42B9(ULO*opc_data)
 	ULO dst = 0;
 	ULO dstea = cpuEA71();
 	cpuClr();
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void BFCHG_EAD0(ULO*opc_data)
@@ -6510,7 +6510,7 @@ static void MULL_4C38(ULO*opc_data)
 static void MULL_4C39(ULO*opc_data)
 {
 	UWO ext = cpuGetNextWord();
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	cpuMulL(src, ext);
 }
 static void MULL_4C3A(ULO*opc_data)
@@ -6612,7 +6612,7 @@ static void MOVES_0E78(ULO*opc_data)
 static void MOVES_0E79(ULO*opc_data)
 {
 	UWO ext = cpuGetNextWord();
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	cpuMoveSW(src, ext);
 }
 static void MOVES_0E90(ULO*opc_data)
@@ -6654,7 +6654,7 @@ static void MOVES_0EB8(ULO*opc_data)
 static void MOVES_0EB9(ULO*opc_data)
 {
 	UWO ext = cpuGetNextWord();
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	cpuMoveSL(src, ext);
 }
 static void NBCD_4800(ULO*opc_data)
@@ -6841,9 +6841,9 @@ static void NEG_4478(ULO*opc_data)
 static void NEG_4479(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuNegW(dst);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void NEG_4480(ULO*opc_data)
@@ -6904,9 +6904,9 @@ static void NEG_44B8(ULO*opc_data)
 static void NEG_44B9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuNegL(dst);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void NEGX_4000(ULO*opc_data)
@@ -7030,9 +7030,9 @@ static void NEGX_4078(ULO*opc_data)
 static void NEGX_4079(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuNegxW(dst);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void NEGX_4080(ULO*opc_data)
@@ -7093,9 +7093,9 @@ static void NEGX_40B8(ULO*opc_data)
 static void NEGX_40B9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuNegxL(dst);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void NOT_4600(ULO*opc_data)
@@ -7219,9 +7219,9 @@ static void NOT_4678(ULO*opc_data)
 static void NOT_4679(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuNotW(dst);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void NOT_4680(ULO*opc_data)
@@ -7282,9 +7282,9 @@ static void NOT_46B8(ULO*opc_data)
 static void NOT_46B9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	dst = cpuNotL(dst);
-	memoryWriteLong(dst, dstea);
+	memoryWriteLongAbsolute(dst, dstea);
 	cpuSetInstructionTime(28);
 }
 static void TAS_4AC0(ULO*opc_data)
@@ -7456,7 +7456,7 @@ static void TST_4A78(ULO*opc_data)
 static void TST_4A79(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	cpuTestW(dst);
 	cpuSetInstructionTime(16);
 }
@@ -7511,7 +7511,7 @@ static void TST_4AB8(ULO*opc_data)
 static void TST_4AB9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	ULO dst = memoryReadLong(dstea);
+	ULO dst = memoryReadLongAbsolute(dstea);
 	cpuTestL(dst);
 	cpuSetInstructionTime(20);
 }
@@ -7757,7 +7757,7 @@ static void MOVETOSR_46F8(ULO*opc_data)
 }
 static void MOVETOSR_46F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	cpuMoveToSr(src);
 	cpuSetInstructionTime(24);
 }
@@ -7823,7 +7823,7 @@ static void MOVETOCCR_44F8(ULO*opc_data)
 }
 static void MOVETOCCR_44F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	cpuMoveToCcr(src);
 	cpuSetInstructionTime(24);
 }
@@ -7959,7 +7959,7 @@ static void MOVEFROMCCR_42F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
 	UWO dst = cpuMoveFromCcr();
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVEFROMSR_40C0(ULO*opc_data)
@@ -8014,7 +8014,7 @@ static void MOVEFROMSR_40F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
 	UWO dst = cpuMoveFromSr();
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 	cpuSetInstructionTime(20);
 }
 static void CAS_0AD0(ULO*opc_data)
@@ -9161,7 +9161,7 @@ static void MOVE_3038(ULO*opc_data)
 }
 static void MOVE_3039(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	cpuMoveW(src);
 	cpuSetDRegWord(opc_data[1], src);
 	cpuSetInstructionTime(16);
@@ -9253,7 +9253,7 @@ static void MOVE_30B8(ULO*opc_data)
 }
 static void MOVE_30B9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA02(opc_data[1]);
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9349,7 +9349,7 @@ static void MOVE_30F8(ULO*opc_data)
 }
 static void MOVE_30F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA03(opc_data[1], 2);
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9445,7 +9445,7 @@ static void MOVE_3138(ULO*opc_data)
 }
 static void MOVE_3139(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA04(opc_data[1], 2);
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9541,7 +9541,7 @@ static void MOVE_3178(ULO*opc_data)
 }
 static void MOVE_3179(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA05(opc_data[1]);
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9637,7 +9637,7 @@ static void MOVE_31B8(ULO*opc_data)
 }
 static void MOVE_31B9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA06(opc_data[1]);
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9733,7 +9733,7 @@ static void MOVE_31F8(ULO*opc_data)
 }
 static void MOVE_31F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA70();
 	cpuMoveW(src);
 	memoryWriteWord(src, dstea);
@@ -9768,7 +9768,7 @@ static void MOVE_33C0(ULO*opc_data)
 	UWO src = cpuGetDRegWord(opc_data[0]);
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(16);
 }
 static void MOVE_33C8(ULO*opc_data)
@@ -9776,7 +9776,7 @@ static void MOVE_33C8(ULO*opc_data)
 	UWO src = cpuGetARegWord(opc_data[0]);
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(16);
 }
 static void MOVE_33D0(ULO*opc_data)
@@ -9784,7 +9784,7 @@ static void MOVE_33D0(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA02(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVE_33D8(ULO*opc_data)
@@ -9792,7 +9792,7 @@ static void MOVE_33D8(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA03(opc_data[0],2));
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVE_33E0(ULO*opc_data)
@@ -9800,7 +9800,7 @@ static void MOVE_33E0(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA04(opc_data[0],2));
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(22);
 }
 static void MOVE_33E8(ULO*opc_data)
@@ -9808,7 +9808,7 @@ static void MOVE_33E8(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA05(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(24);
 }
 static void MOVE_33F0(ULO*opc_data)
@@ -9816,7 +9816,7 @@ static void MOVE_33F0(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA06(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(26);
 }
 static void MOVE_33F8(ULO*opc_data)
@@ -9824,15 +9824,15 @@ static void MOVE_33F8(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA70());
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(24);
 }
 static void MOVE_33F9(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(28);
 }
 static void MOVE_33FA(ULO*opc_data)
@@ -9840,7 +9840,7 @@ static void MOVE_33FA(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA72());
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(24);
 }
 static void MOVE_33FB(ULO*opc_data)
@@ -9848,7 +9848,7 @@ static void MOVE_33FB(ULO*opc_data)
 	UWO src = memoryReadWord(cpuEA73());
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(26);
 }
 static void MOVE_33FC(ULO*opc_data)
@@ -9856,7 +9856,7 @@ static void MOVE_33FC(ULO*opc_data)
 	UWO src = cpuGetNextWord();
 	ULO dstea = cpuEA71();
 	cpuMoveW(src);
-	memoryWriteWord(src, dstea);
+	memoryWriteWordAbsolute(src, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVE_2000(ULO*opc_data)
@@ -9917,7 +9917,7 @@ static void MOVE_2038(ULO*opc_data)
 }
 static void MOVE_2039(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	cpuMoveL(src);
 	cpuSetDReg(opc_data[1], src);
 	cpuSetInstructionTime(20);
@@ -10009,7 +10009,7 @@ static void MOVE_20B8(ULO*opc_data)
 }
 static void MOVE_20B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA02(opc_data[1]);
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10105,7 +10105,7 @@ static void MOVE_20F8(ULO*opc_data)
 }
 static void MOVE_20F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA03(opc_data[1], 4);
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10201,7 +10201,7 @@ static void MOVE_2138(ULO*opc_data)
 }
 static void MOVE_2139(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA04(opc_data[1], 4);
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10297,7 +10297,7 @@ static void MOVE_2178(ULO*opc_data)
 }
 static void MOVE_2179(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA05(opc_data[1]);
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10393,7 +10393,7 @@ static void MOVE_21B8(ULO*opc_data)
 }
 static void MOVE_21B9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA06(opc_data[1]);
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10489,7 +10489,7 @@ static void MOVE_21F8(ULO*opc_data)
 }
 static void MOVE_21F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA70();
 	cpuMoveL(src);
 	memoryWriteLong(src, dstea);
@@ -10524,7 +10524,7 @@ static void MOVE_23C0(ULO*opc_data)
 	ULO src = cpuGetDReg(opc_data[0]);
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVE_23C8(ULO*opc_data)
@@ -10532,7 +10532,7 @@ static void MOVE_23C8(ULO*opc_data)
 	ULO src = cpuGetAReg(opc_data[0]);
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(20);
 }
 static void MOVE_23D0(ULO*opc_data)
@@ -10540,7 +10540,7 @@ static void MOVE_23D0(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA02(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(28);
 }
 static void MOVE_23D8(ULO*opc_data)
@@ -10548,7 +10548,7 @@ static void MOVE_23D8(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA03(opc_data[0],4));
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(28);
 }
 static void MOVE_23E0(ULO*opc_data)
@@ -10556,7 +10556,7 @@ static void MOVE_23E0(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA04(opc_data[0],4));
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(30);
 }
 static void MOVE_23E8(ULO*opc_data)
@@ -10564,7 +10564,7 @@ static void MOVE_23E8(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA05(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(32);
 }
 static void MOVE_23F0(ULO*opc_data)
@@ -10572,7 +10572,7 @@ static void MOVE_23F0(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA06(opc_data[0]));
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(34);
 }
 static void MOVE_23F8(ULO*opc_data)
@@ -10580,15 +10580,15 @@ static void MOVE_23F8(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA70());
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(32);
 }
 static void MOVE_23F9(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(36);
 }
 static void MOVE_23FA(ULO*opc_data)
@@ -10596,7 +10596,7 @@ static void MOVE_23FA(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA72());
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(32);
 }
 static void MOVE_23FB(ULO*opc_data)
@@ -10604,7 +10604,7 @@ static void MOVE_23FB(ULO*opc_data)
 	ULO src = memoryReadLong(cpuEA73());
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(34);
 }
 static void MOVE_23FC(ULO*opc_data)
@@ -10612,7 +10612,7 @@ static void MOVE_23FC(ULO*opc_data)
 	ULO src = cpuGetNextLong();
 	ULO dstea = cpuEA71();
 	cpuMoveL(src);
-	memoryWriteLong(src, dstea);
+	memoryWriteLongAbsolute(src, dstea);
 	cpuSetInstructionTime(28);
 }
 static void MOVEA_3040(ULO*opc_data)
@@ -10665,7 +10665,7 @@ static void MOVEA_3078(ULO*opc_data)
 }
 static void MOVEA_3079(ULO*opc_data)
 {
-	UWO src = memoryReadWord(cpuEA71());
+	UWO src = memoryReadWordAbsolute(cpuEA71());
 	cpuSetAReg(opc_data[1], (ULO)(LON)(WOR)src);
 	cpuSetInstructionTime(16);
 }
@@ -10737,7 +10737,7 @@ static void MOVEA_2078(ULO*opc_data)
 }
 static void MOVEA_2079(ULO*opc_data)
 {
-	ULO src = memoryReadLong(cpuEA71());
+	ULO src = memoryReadLongAbsolute(cpuEA71());
 	cpuSetAReg(opc_data[1], src);
 	cpuSetInstructionTime(20);
 }
@@ -11552,9 +11552,9 @@ static void LSL_E3F8(ULO*opc_data)
 static void LSL_E3F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuLslW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void LSR_E008(ULO*opc_data)
 {
@@ -11637,9 +11637,9 @@ static void LSR_E2F8(ULO*opc_data)
 static void LSR_E2F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuLsrW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ASL_E100(ULO*opc_data)
 {
@@ -11722,9 +11722,9 @@ static void ASL_E1F8(ULO*opc_data)
 static void ASL_E1F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAslW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ASR_E000(ULO*opc_data)
 {
@@ -11807,9 +11807,9 @@ static void ASR_E0F8(ULO*opc_data)
 static void ASR_E0F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuAsrW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ROL_E118(ULO*opc_data)
 {
@@ -11892,9 +11892,9 @@ static void ROL_E7F8(ULO*opc_data)
 static void ROL_E7F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuRolW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ROR_E018(ULO*opc_data)
 {
@@ -11977,9 +11977,9 @@ static void ROR_E6F8(ULO*opc_data)
 static void ROR_E6F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuRorW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ROXL_E110(ULO*opc_data)
 {
@@ -12062,9 +12062,9 @@ static void ROXL_E5F8(ULO*opc_data)
 static void ROXL_E5F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuRoxlW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void ROXR_E010(ULO*opc_data)
 {
@@ -12147,9 +12147,9 @@ static void ROXR_E4F8(ULO*opc_data)
 static void ROXR_E4F9(ULO*opc_data)
 {
 	ULO dstea = cpuEA71();
-	UWO dst = memoryReadWord(dstea);
+	UWO dst = memoryReadWordAbsolute(dstea);
 	dst = cpuRoxrW(dst, 1, opc_data[2]);
-	memoryWriteWord(dst, dstea);
+	memoryWriteWordAbsolute(dst, dstea);
 }
 static void MOVEP_0188(ULO*opc_data)
 {
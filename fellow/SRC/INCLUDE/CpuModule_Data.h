@@ -69645,4 +69645,17 @@ UBY cpu_opcode_model_mask[65536] = {
 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
 };
 
+#ifdef CPU_INSTRUCTION_FUSION
+typedef struct cpu_fusion_data_struct
+{
+	UWO first_opcode;
+	UWO second_opcode;
+	cpuInstructionFunction instruction_func;
+} cpuFusionData;
+
+cpuFusionData cpu_fusion_data[1] = {
+{0x0000,0x0000,NULL}
+};
+#endif
+
 #endif
@@ -13,6 +13,7 @@ extern void cpuStackFrameInit(void);
 extern ULO cpu_sr;  // Not static because the flags calculation uses it extensively
 extern BOOLE cpuGetFlagSupervisor(void);
 extern BOOLE cpuGetFlagMaster(void);
+extern ULO cpuGetFlagsTrace(void);
 extern void cpuSetUspDirect(ULO usp);
 extern ULO cpuGetUspDirect(void);
 extern ULO cpuGetUspAutoMap(void);
@@ -61,6 +62,14 @@ extern UWO cpuGetCurrentOpcode(void);
 
 extern void cpuProfileWrite(void);
 
+#ifdef CPU_INSTRUCTION_PAIR_PROFILE
+extern void cpuPairProfileWrite(void);
+#endif
+
+#ifdef CPU_OPCODE_HISTOGRAM
+extern void cpuOpcodeHistogramWrite(void);
+#endif
+
 extern void cpuSetModelMask(UBY model_mask);
 extern UBY cpuGetModelMask(void);
 extern void cpuSetDRegWord(ULO regno, UWO val);
@@ -83,6 +92,7 @@ extern void cpuClearPrefetch(void);
 extern void cpuValidateReadPointer(void);
 
 extern void cpuInitializeFromNewPC(ULO new_pc);
+extern UWO cpuGetPrefetchWord(void);
 
 // Effective address
 extern ULO cpuEA02(ULO regno);
@@ -96,6 +106,23 @@ extern ULO cpuEA72(void);
 extern ULO cpuEA73(void);
 
 // Flags
+#ifdef CPU_LAZY_FLAGS
+typedef enum
+{
+  CPU_LAZY_FLAGS_NONE = 0,
+  CPU_LAZY_FLAGS_ADD = 1,
+  CPU_LAZY_FLAGS_SUB = 2,
+  CPU_LAZY_FLAGS_CMP = 3,
+  CPU_LAZY_FLAGS_NZ00 = 4
+} cpu_lazy_flags_operation;
+
+extern cpu_lazy_flags_operation cpu_lazy_flags_op; // Not static, it is checked before every use of the flags
+extern ULO cpu_lazy_flags_msb;
+extern ULO cpu_lazy_flags_res;
+extern void cpuSetLazyFlags(cpu_lazy_flags_operation op, ULO msb, ULO res, ULO dst, ULO src);
+extern void cpuMaterializeLazyFlags(void);
+#endif
+
 extern void cpuSetFlagsAdd(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm);
 extern void cpuSetFlagsSub(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm);
 extern void cpuSetFlagsCmp(BOOLE z, BOOLE rm, BOOLE dm, BOOLE sm);
@@ -181,18 +208,64 @@ extern void cpuCallResetExceptionFunc(void);
 extern void cpuFrame1(UWO vector_offset, ULO pc);
 
 // Private help functions
-static ULO cpuSignExtByteToLong(UBY v) {return (ULO)(LON)(BYT) v;}
-static UWO cpuSignExtByteToWord(UBY v) {return (UWO)(WOR)(BYT) v;}
-static ULO cpuSignExtWordToLong(UWO v) {return (ULO)(LON)(WOR) v;}
-static ULO cpuJoinWordToLong(UWO upper, UWO lower) {return (((ULO)upper) << 16) | ((ULO)lower);}
-static ULO cpuJoinByteToLong(UBY upper, UBY midh, UBY midl, UBY lower) {return (((ULO)upper) << 24) | (((ULO)midh) << 16) | (((ULO)midl) << 8) | ((ULO)lower);}
-static UWO cpuJoinByteToWord(UBY upper, UBY lower) {return (((UWO)upper) << 8) | ((UWO)lower);}
-static BOOLE cpuMsbB(UBY v) {return v>>7;}
-static BOOLE cpuMsbW(UWO v) {return v>>15;}
-static BOOLE cpuMsbL(ULO v) {return v>>31;}
-static BOOLE cpuIsZeroB(UBY v) {return v == 0;}
-static BOOLE cpuIsZeroW(UWO v) {return v == 0;}
-static BOOLE cpuIsZeroL(ULO v) {return v == 0;}
+static __inline ULO cpuSignExtByteToLong(UBY v) {return (ULO)(LON)(BYT) v;}
+static __inline UWO cpuSignExtByteToWord(UBY v) {return (UWO)(WOR)(BYT) v;}
+static __inline ULO cpuSignExtWordToLong(UWO v) {return (ULO)(LON)(WOR) v;}
+static __inline ULO cpuJoinWordToLong(UWO upper, UWO lower) {return (((ULO)upper) << 16) | ((ULO)lower);}
+static __inline ULO cpuJoinByteToLong(UBY upper, UBY midh, UBY midl, UBY lower) {return (((ULO)upper) << 24) | (((ULO)midh) << 16) | (((ULO)midl) << 8) | ((ULO)lower);}
+static __inline UWO cpuJoinByteToWord(UBY upper, UBY lower) {return (((UWO)upper) << 8) | ((UWO)lower);}
+static __inline BOOLE cpuMsbB(UBY v) {return v>>7;}
+static __inline BOOLE cpuMsbW(UWO v) {return v>>15;}
+static __inline BOOLE cpuMsbL(ULO v) {return v>>31;}
+static __inline BOOLE cpuIsZeroB(UBY v) {return v == 0;}
+static __inline BOOLE cpuIsZeroW(UWO v) {return v == 0;}
+static __inline BOOLE cpuIsZeroL(ULO v) {return v == 0;}
+
+/// Bring cpu_sr up to date with a recorded lazy flags operation
+static __inline void cpuResolveLazyFlags(void)
+{
+#ifdef CPU_LAZY_FLAGS
+  if (cpu_lazy_flags_op != CPU_LAZY_FLAGS_NONE) cpuMaterializeLazyFlags();
+#endif
+}
+
+/// Forget a recorded lazy flags operation, cpu_sr is about to be replaced
+static __inline void cpuDiscardLazyFlags(void)
+{
+#ifdef CPU_LAZY_FLAGS
+  cpu_lazy_flags_op = CPU_LAZY_FLAGS_NONE;
+#endif
+}
+
+/// Set the flags of an add from the operands, msb is the sign bit of the operation size
+static __inline void cpuSetFlagsAddOperands(ULO res, ULO dst, ULO src, ULO msb)
+{
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_ADD, msb, res, dst, src);
+#else
+  cpuSetFlagsAdd(res == 0, !!(res & msb), !!(dst & msb), !!(src & msb));
+#endif
+}
+
+/// Set the flags of a sub from the operands, msb is the sign bit of the operation size
+static __inline void cpuSetFlagsSubOperands(ULO res, ULO dst, ULO src, ULO msb)
+{
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_SUB, msb, res, dst, src);
+#else
+  cpuSetFlagsSub(res == 0, !!(res & msb), !!(dst & msb), !!(src & msb));
+#endif
+}
+
+/// Set the flags of a cmp from the operands, msb is the sign bit of the operation size
+static __inline void cpuSetFlagsCmpOperands(ULO res, ULO dst, ULO src, ULO msb)
+{
+#ifdef CPU_LAZY_FLAGS
+  cpuSetLazyFlags(CPU_LAZY_FLAGS_CMP, msb, res, dst, src);
+#else
+  cpuSetFlagsCmp(res == 0, !!(res & msb), !!(dst & msb), !!(src & msb));
+#endif
+}
 
 
 #endif
\ No newline at end of file
@@ -101,8 +101,11 @@ private:
     spr_merge_list_master merge_list_master[8];
   } sprite_ham_slot;
 
-  sprite_ham_slot sprite_ham_slots[313];
+  // Two halves, the present thread can still be drawing the previous frame
+  sprite_ham_slot sprite_ham_slots[2*313];
+  ULO sprite_ham_slot_first;
   ULO sprite_ham_slot_next;
+  bool ham_sse2; // The host CPU has SSE2
 
   ULO sprite_write_buffer[128][2];
   ULO sprite_write_next;
@@ -119,6 +122,7 @@ private:
   void MergeListClear(spr_merge_list_master* l);
 
   void MergeHAM(graph_line *linedescription);
+  ULO MergeHAMOpaquePixels(spr_merge_list_item &item, ULO first_pixel, ULO pixel_count);
   void BuildItem(spr_action_list_item ** item);
 
   void Log();
@@ -180,6 +184,9 @@ public:
   virtual void EmulationStart();
   virtual void EmulationStop();
 
+  virtual void SaveState(savestate *S);
+  virtual void LoadState(savestate *S);
+
   LineExactSprites();
   virtual ~LineExactSprites();
 
@@ -2,6 +2,7 @@
 #define SPRITEREGISTERS_H
 
 #include "DEFS.H"
+#include "savestate.h"
 
 extern void wsprxpth(UWO data, ULO address);
 extern void wsprxptl(UWO data, ULO address);
@@ -22,8 +23,8 @@ public:
   void InstallIOHandlers();
 
   void ClearState();
-  void LoadState(FILE *F);
-  void SaveState(FILE *F);
+  void LoadState(savestate *S);
+  void SaveState(savestate *S);
 };
 
 extern SpriteRegisters sprite_registers;
@@ -3,7 +3,6 @@
 
 void drawDualTranslationInitialize(void);
 void drawHAMTableInit();
-void drawWriteProfilingResultsToFile(void);
 void drawModeFunctionsInitialize();
 
 #endif
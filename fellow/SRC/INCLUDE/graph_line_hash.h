@@ -0,0 +1,64 @@
+#ifndef GRAPH_LINE_HASH_H
+#define GRAPH_LINE_HASH_H
+
+#include <string.h>
+
+/*===========================================================================*/
+/* 64-bit hash of the decoded pixels of a line                               */
+/*                                                                           */
+/* Multiply and xor-shift over 8 bytes at a time. Four independent lanes     */
+/* keep the multiplier busy, they are combined at the end. The seed takes    */
+/* the position and length of the pixels so that lines with the same pixels  */
+/* in a different place hash differently.                                    */
+/*===========================================================================*/
+
+#define GRAPH_LINE_HASH_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+static __inline ULL graphLineHashMix(ULL hash, ULL data)
+{
+  hash = (hash ^ data)*GRAPH_LINE_HASH_MULTIPLIER;
+  return hash ^ (hash >> 29);
+}
+
+static __inline ULL graphLineHashSeed(ULO first_pixel, ULO pixel_count, ULO flags)
+{
+  return graphLineHashMix(GRAPH_LINE_HASH_MULTIPLIER, (((ULL) flags) << 48) | (((ULL) first_pixel) << 24) | pixel_count);
+}
+
+static __inline ULL graphLineHash(ULL seed, const UBY *pixels, ULO pixel_count)
+{
+  ULL lane0 = seed;
+  ULL lane1 = seed + 1;
+  ULL lane2 = seed + 2;
+  ULL lane3 = seed + 3;
+  ULO i = 0;
+
+  for (; i + 32 <= pixel_count; i += 32)
+  {
+    ULL data[4];
+    memcpy(data, pixels + i, 32);
+    lane0 = graphLineHashMix(lane0, data[0]);
+    lane1 = graphLineHashMix(lane1, data[1]);
+    lane2 = graphLineHashMix(lane2, data[2]);
+    lane3 = graphLineHashMix(lane3, data[3]);
+  }
+  for (; i + 8 <= pixel_count; i += 8)
+  {
+    ULL data;
+    memcpy(&data, pixels + i, 8);
+    lane0 = graphLineHashMix(lane0, data);
+  }
+
+  ULL tail = 0;
+  for (ULO shift = 0; i < pixel_count; i++, shift += 8)
+  {
+    tail |= ((ULL) pixels[i]) << shift;
+  }
+  lane0 = graphLineHashMix(lane0, tail);
+
+  ULL hash = graphLineHashMix(lane0, lane1);
+  hash = graphLineHashMix(hash, lane2);
+  return graphLineHashMix(hash, lane3);
+}
+
+#endif
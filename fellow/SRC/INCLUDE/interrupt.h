@@ -1,15 +1,20 @@
 #ifndef INTERRUPT_H
 #define INTERRUPT_H
 
+#include "savestate.h"
+
 extern UWO intena;
 
 void interruptHandleEvent(void);
 void interruptRaisePending(void);
-STR *interruptGetInterruptName(ULO interrupt_number);
+const STR *interruptGetInterruptName(ULO interrupt_number);
 BOOLE interruptIsRequested(UWO bitmask);
 
 // Fellow standard module events
 
+void interruptSaveState(savestate *S);
+void interruptLoadState(savestate *S);
+
 void interruptSoftReset(void);
 void interruptHardReset(void);
 void interruptEmulationStart(void);
@@ -0,0 +1,189 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include "DEFS.H"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PROFILER_USE_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/*===========================================================================*/
+/* Hot path profiler                                                         */
+/*                                                                           */
+/* Timers add host ticks to counters for the bus event handlers, the end of  */
+/* line and end of frame work, the 68000 opcode groups and the line          */
+/* renderers. Ticks are the time stamp counter on x86 and x64, steady_clock  */
+/* nanoseconds elsewhere. Each thread counts in a block of its own, the      */
+/* blocks are summed at the end of each frame and written to the report.     */
+/*                                                                           */
+/* The profiler is turned on and off at runtime, a timer costs a test of     */
+/* profiler_enabled when it is off.                                          */
+/*===========================================================================*/
+
+typedef enum {
+  PROFILER_FRAME = 0,
+
+  PROFILER_BUS_COPPER,
+  PROFILER_BUS_CIA,
+  PROFILER_BUS_BLITTER,
+  PROFILER_BUS_INTERRUPT,
+  PROFILER_BUS_EOL,
+  PROFILER_BUS_EOF,
+
+  PROFILER_EOL_GRAPH,
+  PROFILER_EOL_SPRITE,
+  PROFILER_EOL_CIA,
+  PROFILER_EOL_FLOPPY,
+  PROFILER_EOL_SOUND,
+  PROFILER_EOL_KBD,
+  PROFILER_EOL_UART,
+
+  PROFILER_EOF_DRAW,
+  PROFILER_EOF_KBD,
+  PROFILER_EOF_COPPER,
+  PROFILER_EOF_CIA,
+  PROFILER_EOF_SPRITE,
+  PROFILER_EOF_BLITTER,
+  PROFILER_EOF_UART,
+  PROFILER_EOF_GRAPH,
+  PROFILER_EOF_INTERLACE,
+  PROFILER_EOF_CYCLEEXACT,
+  PROFILER_EOF_REWIND,
+
+  // One counter for each value of the top four bits of the opcode
+  PROFILER_CPU_LINE0,
+  PROFILER_CPU_LINEF = PROFILER_CPU_LINE0 + 15,
+  PROFILER_CPU_INTERRUPT,
+
+  PROFILER_DRAW_BG,
+  PROFILER_DRAW_NORMAL,
+  PROFILER_DRAW_DUAL,
+  PROFILER_DRAW_HAM,
+
+  PROFILER_COUNTER_COUNT
+} PROFILER_COUNTER;
+
+typedef enum {
+  PROFILER_REPORT_CSV = 0,
+  PROFILER_REPORT_JSON = 1
+} PROFILER_REPORT;
+
+/* Only the thread that owns a block writes to it, the report reads it from */
+/* the emulation thread. Relaxed loads and stores are enough for that and   */
+/* compile to plain moves.                                                   */
+
+typedef struct profiler_counter_
+{
+  std::atomic<ULL> calls;
+  std::atomic<ULL> ticks;
+  std::atomic<ULL> units;
+} profiler_counter;
+
+extern std::atomic<bool> profiler_enabled;
+extern FELLOW_THREAD_LOCAL profiler_counter *profiler_thread_counters;
+
+extern profiler_counter *profilerRegisterThread(void);
+
+static __inline bool profilerGetEnabled(void)
+{
+  return profiler_enabled.load(std::memory_order_relaxed);
+}
+
+static __inline ULL profilerGetTicks(void)
+{
+#ifdef PROFILER_USE_TSC
+  return __rdtsc();
+#else
+  return (ULL) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static __inline void profilerCounterAdd(std::atomic<ULL> &value, ULL amount)
+{
+  value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/* Counts one call that started at start, units is what the call worked on, */
+/* pixels for the renderers and 68000 cycles for the opcode groups.         */
+static __inline ULL profilerAdd(PROFILER_COUNTER id, ULL start, ULL units)
+{
+  ULL now = profilerGetTicks();
+  profiler_counter *counters = profiler_thread_counters;
+  if (counters == nullptr)
+  {
+    counters = profilerRegisterThread();
+  }
+  profilerCounterAdd(counters[id].calls, 1);
+  profilerCounterAdd(counters[id].ticks, now - start);
+  profilerCounterAdd(counters[id].units, units);
+  return now;
+}
+
+/*===========================================================================*/
+/* Times the enclosing block                                                 */
+/*===========================================================================*/
+
+class ProfilerScope
+{
+private:
+  PROFILER_COUNTER _id;
+  ULL _start;
+  ULL _units;
+  bool _active;
+
+public:
+  void AddUnits(ULL units) { _units += units; }
+
+  ProfilerScope(PROFILER_COUNTER id) : _id(id), _start(0), _units(0), _active(profilerGetEnabled())
+  {
+    if (_active) _start = profilerGetTicks();
+  }
+
+  ~ProfilerScope()
+  {
+    if (_active) profilerAdd(_id, _start, _units);
+  }
+};
+
+/*===========================================================================*/
+/* Times a run of tasks, Lap() counts the time since the previous lap        */
+/*===========================================================================*/
+
+class ProfilerLaps
+{
+private:
+  ULL _start;
+  bool _active;
+
+public:
+  void Lap(PROFILER_COUNTER id)
+  {
+    if (_active) _start = profilerAdd(id, _start, 0);
+  }
+
+  ProfilerLaps() : _start(0), _active(profilerGetEnabled())
+  {
+    if (_active) _start = profilerGetTicks();
+  }
+};
+
+/* The counter for the opcode group of a 68000 opcode */
+#define PROFILER_CPU_COUNTER(opcode) ((PROFILER_COUNTER) (PROFILER_CPU_LINE0 + ((opcode) >> 12)))
+
+extern void profilerSetEnabled(bool enabled);
+extern void profilerSetReportFormat(PROFILER_REPORT format);
+extern PROFILER_REPORT profilerGetReportFormat(void);
+extern void profilerEndOfFrame(void);
+
+/* Standard Fellow Module functions */
+
+extern void profilerEmulationStop(void);
+
+#endif
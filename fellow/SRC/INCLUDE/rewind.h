@@ -0,0 +1,38 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "DEFS.H"
+
+/*===========================================================================*/
+/* Rewind                                                                    */
+/*                                                                           */
+/* The last seconds of emulation are kept in memory as a ring of snapshots,  */
+/* one every REWIND_FRAMES_PER_SNAPSHOT frames. A snapshot is the module     */
+/* state, as in a state file, and the pages of RAM written since the         */
+/* snapshot before it. Every REWIND_SNAPSHOTS_PER_KEYFRAME snapshots all of  */
+/* RAM is kept instead, a keyframe. A snapshot is restored by copying the    */
+/* pages of the keyframe before it and of the snapshots in between.          */
+/*                                                                           */
+/* Snapshots are taken and restored at the end of a frame, after the bus     */
+/* end of frame work, where the state is the same as when emulation stops.   */
+/*===========================================================================*/
+
+#define REWIND_FRAMES_PER_SNAPSHOT 5
+#define REWIND_SNAPSHOTS_PER_KEYFRAME 50
+
+/* How far one rewind request goes back, one second at 50 Hz */
+#define REWIND_STEP_FRAMES 50
+
+extern void rewindSetSeconds(ULO seconds);
+extern ULO rewindGetSeconds(void);
+extern void rewindRequestRestore(ULO frames);
+extern ULO rewindRestore(ULO frames);
+extern void rewindEndOfFrame(void);
+
+/* Standard Fellow Module functions */
+
+extern void rewindHardReset(void);
+extern void rewindEmulationStop(void);
+extern void rewindShutdown(void);
+
+#endif
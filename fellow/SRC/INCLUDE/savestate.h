@@ -0,0 +1,99 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include "DEFS.H"
+
+/*===========================================================================*/
+/* State files                                                               */
+/*                                                                           */
+/* A state file is a gzip stream that holds a header and a list of chunks.   */
+/* The header is SAVESTATE_MAGIC and SAVESTATE_FORMAT_VERSION, a chunk is    */
+/* its id, its version and its length in bytes followed by the data. Each    */
+/* module writes its own chunks and reads them back when the loader finds    */
+/* one of its ids. A reader skips chunks it does not know and the rest of a  */
+/* chunk it did not read.                                                    */
+/*                                                                           */
+/* The version of a chunk goes up when its layout changes, a module is only  */
+/* given chunks with a version it knows.                                     */
+/*                                                                           */
+/* The state is complete at the end of a frame, where emulation stops when   */
+/* asked to. The work in progress within a line is not saved.                */
+/*                                                                           */
+/* A state in memory is the same list of chunks without the header, and is   */
+/* not compressed.                                                           */
+/*===========================================================================*/
+
+#define SAVESTATE_ID(a, b, c, d) (((ULO) (a)) | (((ULO) (b)) << 8) | (((ULO) (c)) << 16) | (((ULO) (d)) << 24))
+
+#define SAVESTATE_MAGIC SAVESTATE_ID('F', 'S', 'T', 'A')
+#define SAVESTATE_FORMAT_VERSION 1
+
+/* Chunk ids and the present version of each chunk */
+
+#define SAVESTATE_MEMORY         SAVESTATE_ID('M', 'E', 'M', ' ')
+#define SAVESTATE_MEMORY_VERSION 1
+#define SAVESTATE_CHIP           SAVESTATE_ID('C', 'H', 'I', 'P')
+#define SAVESTATE_CHIP_VERSION   1
+#define SAVESTATE_SLOW           SAVESTATE_ID('S', 'L', 'O', 'W')
+#define SAVESTATE_SLOW_VERSION   1
+#define SAVESTATE_FAST           SAVESTATE_ID('F', 'A', 'S', 'T')
+#define SAVESTATE_FAST_VERSION   1
+#define SAVESTATE_CPU            SAVESTATE_ID('C', 'P', 'U', ' ')
+#define SAVESTATE_CPU_VERSION    2
+#define SAVESTATE_BUS            SAVESTATE_ID('B', 'U', 'S', ' ')
+#define SAVESTATE_BUS_VERSION    1
+#define SAVESTATE_INTERRUPT      SAVESTATE_ID('I', 'N', 'T', ' ')
+#define SAVESTATE_INTERRUPT_VERSION 1
+#define SAVESTATE_COPPER         SAVESTATE_ID('C', 'O', 'P', ' ')
+#define SAVESTATE_COPPER_VERSION 1
+#define SAVESTATE_BLITTER        SAVESTATE_ID('B', 'L', 'I', 'T')
+#define SAVESTATE_BLITTER_VERSION 1
+#define SAVESTATE_CIA            SAVESTATE_ID('C', 'I', 'A', ' ')
+#define SAVESTATE_CIA_VERSION    1
+#define SAVESTATE_GRAPHICS       SAVESTATE_ID('G', 'R', 'P', 'H')
+#define SAVESTATE_GRAPHICS_VERSION 1
+#define SAVESTATE_SPRITE         SAVESTATE_ID('S', 'P', 'R', ' ')
+#define SAVESTATE_SPRITE_VERSION 1
+#define SAVESTATE_SOUND          SAVESTATE_ID('S', 'N', 'D', ' ')
+#define SAVESTATE_SOUND_VERSION  1
+#define SAVESTATE_FLOPPY         SAVESTATE_ID('F', 'L', 'O', 'P')
+#define SAVESTATE_FLOPPY_VERSION 1
+#define SAVESTATE_UART           SAVESTATE_ID('U', 'A', 'R', 'T')
+#define SAVESTATE_UART_VERSION   1
+
+typedef struct savestate_ savestate;
+
+/* Files */
+
+extern savestate *savestateOpenWrite(const STR *filename);
+extern savestate *savestateOpenRead(const STR *filename);
+extern BOOLE savestateClose(savestate *S);
+extern BOOLE savestateFailed(savestate *S);
+extern void savestateFail(savestate *S, const STR *reason);
+
+/* Memory, savestateCloseMemory() returns the buffer, which is freed with free() */
+
+extern savestate *savestateOpenMemoryWrite(void);
+extern savestate *savestateOpenMemoryRead(const void *data, ULO size);
+extern void *savestateCloseMemory(savestate *S, ULO *size);
+
+/* Writing, savestateWrite() adds to the chunk that was begun */
+
+extern void savestateChunkBegin(savestate *S, ULO id, ULO version);
+extern void savestateChunkEnd(savestate *S);
+extern void savestateWrite(savestate *S, const void *data, ULO size);
+extern void savestateWriteChunk(savestate *S, ULO id, ULO version, const void *data, ULO size);
+
+/* Reading, savestateRead() reads from the chunk found by savestateChunkNext() */
+
+extern BOOLE savestateChunkNext(savestate *S);
+extern ULO savestateGetChunkId(savestate *S);
+extern ULO savestateGetChunkVersion(savestate *S);
+extern ULO savestateGetChunkSize(savestate *S);
+extern void savestateRead(savestate *S, void *data, ULO size);
+
+/* Writes and reads one variable */
+#define savestateWriteValue(S, value) savestateWrite(S, &(value), sizeof(value))
+#define savestateReadValue(S, value) savestateRead(S, &(value), sizeof(value))
+
+#endif
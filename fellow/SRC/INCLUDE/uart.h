@@ -2,6 +2,7 @@
 #define UART_H
 
 #include "DEFS.H"
+#include "savestate.h"
 #include <string>
 
 class UART
@@ -27,8 +28,6 @@ private:
   void InstallIOHandlers();
 
   void ClearState();
-  void LoadState(FILE *F);
-  void SaveState(FILE *F);  
 
   void OpenOutputFile();
   void CloseOutputFile();
@@ -51,6 +50,9 @@ public:
 
   void NotifyInterruptRequestBitsChanged(UWO intreq);
 
+  void LoadState(savestate *S);
+  void SaveState(savestate *S);
+
   void EndOfLine();
   void EndOfFrame();
 
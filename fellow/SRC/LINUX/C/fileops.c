@@ -0,0 +1,138 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* Filesystem operations, headless Linux build                             */
+/*                                                                         */
+/* Copyright (C) 1991, 1992, 1996 Free Software Foundation, Inc.           */
+/*                                                                         */
+/* This program is free software; you can redistribute it and/or modify    */
+/* it under the terms of the GNU General Public License as published by    */
+/* the Free Software Foundation; either version 2, or (at your option)     */
+/* any later version.                                                      */
+/*                                                                         */
+/* This program is distributed in the hope that it will be useful,         */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty of          */
+/* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           */
+/* GNU General Public License for more details.                            */
+/*                                                                         */
+/* You should have received a copy of the GNU General Public License       */
+/* along with this program; if not, write to the Free Software Foundation, */
+/* Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.          */
+/*=========================================================================*/
+
+#include <time.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "fileops.h"
+
+/** resolve %VARIABLE% environment variables in a path name, the same
+ * syntax as on Windows so that configuration files can be shared.
+ * Unknown variables are left as they are.
+ * @param[in] szPath path name to resolve
+ * @param[out] szNewPath path name with resolved variables
+ * @return TRUE, if a variable was resolved, FALSE otherwise.
+ */
+BOOLE fileopsResolveVariables(const char *szPath, char *szNewPath)
+{
+  ULO length = 0;
+  BOOLE resolved = FALSE;
+
+  while (*szPath != '\0' && length < CFG_FILENAME_LENGTH - 1)
+  {
+    const char *end = (*szPath == '%') ? strchr(szPath + 1, '%') : NULL;
+
+    if (end != NULL && end - szPath - 1 < CFG_FILENAME_LENGTH)
+    {
+      char name[CFG_FILENAME_LENGTH];
+      const char *value;
+
+      strncpy(name, szPath + 1, end - szPath - 1);
+      name[end - szPath - 1] = '\0';
+      value = getenv(name);
+      if (value != NULL)
+      {
+	while (*value != '\0' && length < CFG_FILENAME_LENGTH - 1)
+	{
+	  szNewPath[length++] = *value++;
+	}
+	szPath = end + 1;
+	resolved = TRUE;
+	continue;
+      }
+    }
+    szNewPath[length++] = *szPath++;
+  }
+  szNewPath[length] = '\0';
+  return resolved;
+}
+
+/** build generic filename, the headless build keeps its files in the
+ * current directory, so that each benchmark run can have its own.
+ * @return TRUE
+ */
+BOOLE fileopsGetGenericFileName(char *szPath, const char *szSubDir, const char *filename)
+{
+  strcpy(szPath, filename);
+  return TRUE;
+}
+
+/* fileopsGetScreenshotFileName                                     */
+/* generate a screenshot filename in the current directory          */
+
+BOOLE fileopsGetScreenshotFileName(char *szFilename)
+{
+  time_t rawtime;
+  char szTime[255] = "";
+  ULO i = 1;
+
+  time(&rawtime);
+  strftime(szTime, 255, "%Y%m%d%H%M%S", localtime(&rawtime));
+  do
+  {
+    sprintf(szFilename, "Fellow-%s_%u.bmp", szTime, i++);
+  } while (access(szFilename, F_OK) != -1);
+  return TRUE;
+}
+
+BOOLE fileopsGetFellowLogfileName(char *szPath)
+{
+  return fileopsGetGenericFileName(szPath, "WinFellow", "fellow.log");
+}
+
+BOOLE fileopsGetDefaultConfigFileName(char *szPath)
+{
+  return fileopsGetGenericFileName(szPath, "WinFellow/configurations", "default.wfc");
+}
+
+/*=========================================*/
+/* Get a temporary file name               */
+/* in TMPDIR if set, else in /tmp          */
+/* The caller frees the returned name      */
+/*=========================================*/
+
+char *fileopsGetTemporaryFilename(void)
+{
+  const char *tempdir = getenv("TMPDIR");
+  char *result;
+  int fd;
+
+  if (tempdir == NULL)
+  {
+    tempdir = "/tmp";
+  }
+  result = (char *) malloc(strlen(tempdir) + 16);
+  if (result == NULL)
+  {
+    return NULL;
+  }
+  sprintf(result, "%s/wftempXXXXXX", tempdir);
+  fd = mkstemp(result);
+  if (fd == -1)
+  {
+    free(result);
+    return NULL;
+  }
+  close(fd);
+  return result;
+}
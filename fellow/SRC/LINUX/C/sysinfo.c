@@ -0,0 +1,27 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* System information retrieval, headless Linux build                      */
+/*                                                                         */
+/* Logs the kernel and machine the emulator runs on, so that benchmark     */
+/* logs from different hosts can be told apart.                            */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <sys/utsname.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "sysinfo.h"
+
+void sysinfoLogSysInfo(void)
+{
+  struct utsname name;
+
+  if (uname(&name) == 0)
+  {
+    fellowAddLog("OS: %s %s %s\n", name.sysname, name.release, name.machine);
+  }
+  fellowAddLog("Processors online: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+}
@@ -0,0 +1,14 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* System information retrieval, headless Linux build                      */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#ifndef _SYSINFO_H_
+#define _SYSINFO_H_
+
+void sysinfoLogSysInfo(void);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef VERSIONINFO_H
+#define VERSIONINFO_H
+
+#define FELLOWVERSION        "Fellow v0.5.4 headless"
+#define FELLOWLONGVERSION    "Fellow Amiga Emulator v0.5.4 headless"
+#define FELLOWNUMERICVERSION "0.5.4"
+
+#endif
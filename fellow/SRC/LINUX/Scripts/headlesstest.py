@@ -0,0 +1,108 @@
+"""
+Shared parts of the tests that run fellow-headless.
+
+The tests run a small Kickstart replacement, written by write_rom(), that
+keeps the chipset busy without needing a real Kickstart ROM:
+
+  - The exception vectors point to a loop, level 2 and level 3 handlers
+    acknowledge the CIA-A timer A, vertical blank and blitter interrupts,
+    the level 3 handler counts them in the long at $104.
+  - A copper list at $1000 points bitplane 1 at $20000 and changes COLOR00
+    and BPLCON1 on every line of a 1 bitplane lores screen.
+  - The main loop fills 4K at $20000 with a pseudo random sequence in d1,
+    waits for the blitter and starts an A to D blit with a shift that
+    changes every time, from $20000 to $20FA0.
+
+State files are read back with read_state(), as a dict of chunk id to
+chunk data.
+"""
+
+import gzip
+import os
+import struct
+import subprocess
+
+ROM_BASE = 0xf80000
+ROM_SIZE = 0x80000
+
+ROM_CODE = [
+  0x0008, 0x0000, 0x00f8, 0x0010, 0x0000, 0x0000, 0x0000, 0x0000, 0x4ff9, 0x0008, 0x0000, 0x13fc,
+  0x0003, 0x00bf, 0xe201, 0x13fc, 0x0002, 0x00bf, 0xe001, 0x4df9, 0x00df, 0xf000, 0x3d7c, 0x7fff,
+  0x009a, 0x3d7c, 0x7fff, 0x0096, 0x3d7c, 0x7fff, 0x009c, 0x41f9, 0x0000, 0x0008, 0x303c, 0x002d,
+  0x20fc, 0x00f8, 0x0190, 0x51c8, 0xfff8, 0x21fc, 0x00f8, 0x0192, 0x0068, 0x21fc, 0x00f8, 0x0182,
+  0x006c, 0x41f9, 0x0000, 0x1000, 0x20fc, 0x00e0, 0x0002, 0x20fc, 0x00e2, 0x0000, 0x303c, 0x2c07,
+  0x7200, 0x30c0, 0x30fc, 0xfffe, 0x30fc, 0x0180, 0x30c1, 0x30fc, 0x0102, 0x30c1, 0x0641, 0x0111,
+  0x0640, 0x0100, 0x0c40, 0xf407, 0x66e0, 0x20fc, 0xffff, 0xfffe, 0x3d7c, 0x1200, 0x0100, 0x3d7c,
+  0x0000, 0x0102, 0x3d7c, 0x0000, 0x0104, 0x3d7c, 0x2c81, 0x008e, 0x3d7c, 0xf4c1, 0x0090, 0x3d7c,
+  0x0038, 0x0092, 0x3d7c, 0x00d0, 0x0094, 0x3d7c, 0x0000, 0x0108, 0x3d7c, 0x0000, 0x0180, 0x3d7c,
+  0x0fff, 0x0182, 0x2d7c, 0x0000, 0x1000, 0x0080, 0x3d40, 0x0088, 0x13fc, 0x0000, 0x00bf, 0xe401,
+  0x13fc, 0x0010, 0x00bf, 0xe501, 0x13fc, 0x0081, 0x00bf, 0xed01, 0x13fc, 0x0011, 0x00bf, 0xee01,
+  0x3d7c, 0xc068, 0x009a, 0x3d7c, 0x83c0, 0x0096, 0x223c, 0x1234, 0x5678, 0x243c, 0x9e37, 0x79b9,
+  0x7800, 0x46fc, 0x2000, 0x43f9, 0x0002, 0x0000, 0x363c, 0x03ff, 0x22c1, 0xd282, 0x51cb, 0xfffa,
+  0x0839, 0x0006, 0x00df, 0xf002, 0x66f6, 0x3004, 0x0240, 0xf000, 0x0040, 0x09f0, 0x3d40, 0x0040,
+  0x3d7c, 0x0000, 0x0042, 0x2d7c, 0xffff, 0xffff, 0x0044, 0x2d7c, 0x0002, 0x0000, 0x0050, 0x2d7c,
+  0x0002, 0x0fa0, 0x0054, 0x2d7c, 0x0000, 0x0000, 0x0064, 0x3d7c, 0x1914, 0x0058, 0x0644, 0x1000,
+  0x60a4, 0x33fc, 0x0070, 0x00df, 0xf09c, 0x52b8, 0x0104, 0x4e73, 0x60fe, 0x4a39, 0x00bf, 0xed01,
+  0x33fc, 0x0008, 0x00df, 0xf09c, 0x4e73
+]
+
+
+def write_rom(path):
+    rom = bytearray(ROM_SIZE)
+    for i, word in enumerate(ROM_CODE):
+        struct.pack_into('>H', rom, 2*i, word)
+    # Kickstart checksum, the sum of all longs with carry is 0xffffffff
+    checksum = 0
+    for i in range(0, ROM_SIZE, 4):
+        checksum += struct.unpack_from('>I', rom, i)[0]
+        if checksum > 0xffffffff:
+            checksum = (checksum & 0xffffffff) + 1
+    struct.pack_into('>I', rom, ROM_SIZE - 24, 0xffffffff - checksum)
+    with open(path, 'wb') as f:
+        f.write(rom)
+
+
+def write_config(path, rom_path, options=()):
+    with open(path, 'w') as f:
+        f.write('kickstart_rom_file=%s\n' % rom_path)
+        for option in options:
+            f.write(option + '\n')
+
+
+def run_headless(headless, config_path, arguments):
+    """Runs fellow-headless in the directory of the config, returns its output"""
+    result = subprocess.run([headless, '-f', config_path] + arguments, cwd=os.path.dirname(config_path),
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        raise RuntimeError('%s failed:\n%s' % (headless, result.stdout))
+    return result.stdout
+
+
+def read_state(path):
+    with gzip.open(path, 'rb') as f:
+        data = f.read()
+    chunks = {}
+    position = 8  # SAVESTATE_MAGIC and SAVESTATE_FORMAT_VERSION
+    while position < len(data):
+        chunk_id, version, size = struct.unpack_from('<III', data, position)
+        position += 12
+        chunks[struct.pack('<I', chunk_id).decode('ascii')] = data[position:position + size]
+        position += size
+    return chunks
+
+
+def compare_states(expected_path, actual_path):
+    """Returns a line for each chunk that differs, an empty list if none do"""
+    expected, actual = read_state(expected_path), read_state(actual_path)
+    differences = []
+    for chunk_id in sorted(set(expected) | set(actual)):
+        a, b = expected.get(chunk_id), actual.get(chunk_id)
+        if a == b:
+            continue
+        if a is None or b is None:
+            differences.append('chunk %s is only in %s' % (chunk_id, expected_path if b is None else actual_path))
+            continue
+        offsets = [i for i in range(min(len(a), len(b))) if a[i] != b[i]]
+        differences.append('chunk %s differs in %d bytes, first at offset %s, sizes %d and %d'
+                           % (chunk_id, len(offsets), offsets[0] if offsets else '-', len(a), len(b)))
+    return differences
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Checks that the drawing threads draw the same pixels as the emulation
+thread does on its own.
+
+fellow-headless runs the test ROM of headlesstest.py in the line exact
+graphics emulation mode, once with the default configuration and once with
+the options of the case. -c writes a checksum of every frame drawn, the two
+runs must draw the same frames, and fellow.log of the case must show that
+it ran the way the case is meant to.
+
+Cases:
+    threads    4 drawing threads, each draws a band of the lines
+    pipelined  3 buffers, frames are drawn on the present thread while the
+               emulation goes on with the next frame. Multiple buffers
+               need deinterlacing off, the test ROM is not interlaced.
+
+Every case runs in a directory of its own under the work directory, so
+that the cases and the other tests can run at the same time.
+
+Usage:
+    runDrawThreadTest.py <fellow-headless> <work directory> <case>
+"""
+
+import os
+import sys
+
+sys.dont_write_bytecode = True  # No __pycache__ in the source tree
+import headlesstest
+
+FRAMES = 300
+
+# The options of a case and the lines its fellow.log must contain
+CASES = {
+    'threads': (['fellow.gfx_draw_threads=4'], []),
+    'pipelined': (['use_multiple_graphical_buffers=yes', 'fellow.gfx_deinterlace=no', 'fellow.gfx_draw_pipelined=yes'],
+                  ['frames drawn in 3 buffers', 'The emulation waited for the present thread']),
+}
+
+
+def read_checksums(path):
+    with open(path) as f:
+        return f.read().split()
+
+
+def main():
+    if len(sys.argv) < 4 or sys.argv[3] not in CASES:
+        print(__doc__)
+        return 2
+    headless = os.path.abspath(sys.argv[1])
+    case = sys.argv[3]
+    work = os.path.join(os.path.abspath(sys.argv[2]), 'drawthreadtest-' + case)
+    os.makedirs(work, exist_ok=True)
+    options, log_lines = CASES[case]
+    rom_path = os.path.join(work, 'drawthreadtest.rom')
+    serial_config_path = os.path.join(work, 'drawthreadtest-serial.wfc')
+    case_config_path = os.path.join(work, 'drawthreadtest-%s.wfc' % case)
+    headlesstest.write_rom(rom_path)
+    headlesstest.write_config(serial_config_path, rom_path)
+    headlesstest.write_config(case_config_path, rom_path, options)
+
+    serial_path = os.path.join(work, 'drawthreadtest-serial.txt')
+    case_path = os.path.join(work, 'drawthreadtest-%s.txt' % case)
+    headlesstest.run_headless(headless, serial_config_path, ['-n', str(FRAMES), '-c', serial_path])
+    headlesstest.run_headless(headless, case_config_path, ['-n', str(FRAMES), '-c', case_path])
+    serial, threaded = read_checksums(serial_path), read_checksums(case_path)
+
+    with open(os.path.join(work, 'fellow.log')) as f:
+        log = f.read()
+    missing = [line for line in log_lines if line not in log]
+    if missing:
+        print('fellow.log of the %s case does not contain "%s"' % (case, missing[0]))
+        return 1
+
+    if len(serial) != FRAMES or len(threaded) != FRAMES:
+        print('Expected %d frames, the runs drew %d and %d' % (FRAMES, len(serial), len(threaded)))
+        return 1
+    if len(set(serial)) < FRAMES // 2:
+        print('Only %d different frames, the test ROM does not draw what it should' % len(set(serial)))
+        return 1
+    different = [i for i in range(FRAMES) if serial[i] != threaded[i]]
+    if different:
+        print('%d of %d frames differ, the first is frame %d' % (len(different), FRAMES, different[0]))
+        return 1
+    print('%d frames, the %s case and the emulation thread drew the same pixels' % (FRAMES, case))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
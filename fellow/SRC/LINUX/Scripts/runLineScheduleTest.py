@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+Checks that the line schedule of the cycle exact graphics draws the same
+pixels as the graphics event list.
+
+fellow-headless runs the test ROM of headlesstest.py in the cycle exact
+graphics emulation mode, once as it is and once with -g, which runs the
+event list on every line. -c writes a checksum of every frame drawn, the
+two runs must draw the same frames.
+
+Usage:
+    runLineScheduleTest.py <fellow-headless> [work directory]
+"""
+
+import os
+import sys
+
+sys.dont_write_bytecode = True  # No __pycache__ in the source tree
+import headlesstest
+
+FRAMES = 300
+
+
+def read_checksums(path):
+    with open(path) as f:
+        return f.read().split()
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 2
+    headless = os.path.abspath(sys.argv[1])
+    work = os.path.abspath(sys.argv[2] if len(sys.argv) > 2 else '.')
+    rom_path = os.path.join(work, 'linescheduletest.rom')
+    config_path = os.path.join(work, 'linescheduletest.wfc')
+    headlesstest.write_rom(rom_path)
+    headlesstest.write_config(config_path, rom_path, ['gfx_emulation_mode=cycleexact'])
+
+    schedule_path = os.path.join(work, 'linescheduletest-schedule.txt')
+    list_path = os.path.join(work, 'linescheduletest-list.txt')
+    headlesstest.run_headless(headless, config_path, ['-n', str(FRAMES), '-c', schedule_path])
+    headlesstest.run_headless(headless, config_path, ['-n', str(FRAMES), '-g', '-c', list_path])
+    schedule, event_list = read_checksums(schedule_path), read_checksums(list_path)
+
+    if len(schedule) != FRAMES or len(event_list) != FRAMES:
+        print('Expected %d frames, the runs drew %d and %d' % (FRAMES, len(schedule), len(event_list)))
+        return 1
+    if len(set(event_list)) < FRAMES // 2:
+        print('Only %d different frames, the test ROM does not draw what it should' % len(set(event_list)))
+        return 1
+    different = [i for i in range(FRAMES) if schedule[i] != event_list[i]]
+    if different:
+        print('%d of %d frames differ, the first is frame %d' % (len(different), FRAMES, different[0]))
+        return 1
+    print('%d frames, the line schedule and the event list drew the same pixels' % FRAMES)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
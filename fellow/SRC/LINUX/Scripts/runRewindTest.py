@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Checks that rewind restores the machine it took a snapshot of.
+
+fellow-headless runs the test ROM of headlesstest.py with rewind on, goes
+back with -r and writes the state right after the rewind with -x. That
+state must be the same as the state written by a run that stops at the
+frame of the snapshot, all of the CPU, the chipset and the memory. The
+frames gone back are then run again, and must end in the same state as a
+run that never went back.
+
+A snapshot is taken every 5 frames and a keyframe every 50 snapshots, the
+second case goes back to a snapshot that is restored from a keyframe and
+the pages of 3 snapshots after it. With 3 seconds the ring has room for 80
+snapshots, not a multiple of 50, so the keyframes move to other slots every
+time around the ring. The last two cases run around it several times, and
+the last one asks for more than is left, it goes back to the oldest
+keyframe.
+
+Usage:
+    runRewindTest.py <fellow-headless> [work directory]
+"""
+
+import os
+import sys
+
+sys.dont_write_bytecode = True  # No __pycache__ in the source tree
+import headlesstest
+
+# (rewind seconds, frames run, frames to go back, frame of the snapshot that is restored)
+CASES = [(10, 130, 30, 100), (10, 400, 130, 270), (3, 700, 130, 570), (3, 1000, 300, 755)]
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 2
+    headless = os.path.abspath(sys.argv[1])
+    work = os.path.abspath(sys.argv[2] if len(sys.argv) > 2 else '.')
+    rom_path = os.path.join(work, 'rewindtest.rom')
+    headlesstest.write_rom(rom_path)
+
+    failed = False
+    for seconds, frames, back, snapshot_frame in CASES:
+        config_path = os.path.join(work, 'rewindtest-%d.wfc' % seconds)
+        headlesstest.write_config(config_path, rom_path, ['fellow.rewind_seconds=%d' % seconds])
+
+        def state(name):
+            return os.path.join(work, 'rewindtest-%d-%d-%s.fst' % (seconds, frames, name))
+
+        for path in [state('snapshot'), state('rewound'), state('end'), state('rerun')]:
+            if os.path.exists(path):
+                os.remove(path)
+        headlesstest.run_headless(headless, config_path, ['-n', str(snapshot_frame), '-w', state('snapshot')])
+        headlesstest.run_headless(headless, config_path, ['-n', str(frames), '-w', state('end')])
+        output = headlesstest.run_headless(headless, config_path,
+                                           ['-n', str(frames), '-r', str(back), '-x', state('rewound'), '-w', state('rerun')])
+        if 'Rewound %d frames' % (frames - snapshot_frame) not in output:
+            print('Going back %d frames from frame %d did not reach frame %d:\n%s' % (back, frames, snapshot_frame, output))
+            failed = True
+            continue
+
+        for name, expected, actual in [('rewound to frame %d' % snapshot_frame, state('snapshot'), state('rewound')),
+                                       ('run again to frame %d' % frames, state('end'), state('rerun'))]:
+            differences = headlesstest.compare_states(expected, actual)
+            print('%s: %s' % (name, 'same state' if not differences else 'different state'))
+            for difference in differences:
+                print('  ' + difference)
+            failed = failed or bool(differences)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
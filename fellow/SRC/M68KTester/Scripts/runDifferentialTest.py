@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+"""
+Compare two builds of the M68KTester instruction by instruction.
+
+The 68000 instructions below are run by the reference tester, its results
+become the expected results for the tester under test. Use it to check that
+optional CPU speedups (lazy flags, fused pairs) do not change
+what the core computes.
+
+Only instructions that leave the code at M68K_CODE_BASE are left out, the
+tester stops at the first 0x7100 after the instruction. Each instruction is
+also run again with other extension words, and pairs of instructions are
+run in one test.
+
+Usage:
+    runDifferentialTest.py <reference tester> <tester under test> [work directory]
+    runDifferentialTest.py --pair-profile <cpupairs.txt>
+
+Exits with 0 when the tester under test gets the same d0, d1 and CCR in
+every test, the values the tester compares.
+
+--pair-profile writes the pairs that are tested in the format of the
+cpupairs.txt written by CPU_INSTRUCTION_PAIR_PROFILE, 68kgenerate makes
+fused handlers for them.
+"""
+
+import os
+import random
+import re
+import subprocess
+import sys
+
+TESTS_PER_INSTRUCTION = 8
+PAIR_COUNT = 1500
+
+EDGE_VALUES = [0x00000000, 0x00000001, 0x0000007f, 0x00000080, 0x000000ff,
+               0x00007fff, 0x00008000, 0x0000ffff, 0x7fffffff, 0x80000000,
+               0xffffffff, 0x00000009, 0x00000099, 0x00010000]
+
+
+class Instruction:
+    def __init__(self, name, words, nonzero_divisor=None, second_opcode=None):
+        self.name = name
+        self.words = words
+        self.nonzero_divisor = nonzero_divisor  # Register that must have a non-zero low word
+        self.second_opcode = second_opcode      # For pairs
+
+
+def immediate_words(size, rng):
+    value = rng.choice(EDGE_VALUES + [rng.getrandbits(32)])
+    if size == 0:
+        return [value & 0xff]
+    if size == 1:
+        return [value & 0xffff]
+    return [value >> 16, value & 0xffff]
+
+
+def single_instructions(rng):
+    """Instructions on d0 and d1, (name, opcode, extension word generator or None)"""
+    sizes = 'bwl'
+    result = []
+
+    def add(name, opcode, ext=None, nonzero_divisor=None):
+        result.append((name, opcode, ext, nonzero_divisor))
+
+    for base, name in [(0x0000, 'ori'), (0x0200, 'andi'), (0x0400, 'subi'),
+                       (0x0600, 'addi'), (0x0a00, 'eori'), (0x0c00, 'cmpi')]:
+        for s in range(3):
+            for r in range(2):
+                add(name + sizes[s], base | (s << 6) | r, lambda s=s: immediate_words(s, rng))
+    for opcode, name in [(0x003c, 'oriccr'), (0x023c, 'andiccr'), (0x0a3c, 'eoriccr')]:
+        add(name, opcode, lambda: [rng.getrandbits(5)])
+
+    for t, name in enumerate(['btst', 'bchg', 'bclr', 'bset']):
+        for dn in range(2):
+            for r in range(2):
+                add(name, 0x0100 | (dn << 9) | (t << 6) | r)
+        for r in range(2):
+            add(name + 'i', 0x0800 | (t << 6) | r, lambda: [rng.getrandbits(5)])
+
+    for code, s in [(1, 0), (3, 1), (2, 2)]:
+        for dst in range(2):
+            for src in range(2):
+                add('move' + sizes[s], (code << 12) | (dst << 9) | src)
+            add('movei' + sizes[s], (code << 12) | (dst << 9) | 0x3c, lambda s=s: immediate_words(s, rng))
+
+    for base, name in [(0x4000, 'negx'), (0x4200, 'clr'), (0x4400, 'neg'), (0x4600, 'not'), (0x4a00, 'tst')]:
+        for s in range(3):
+            for r in range(2):
+                add(name + sizes[s], base | (s << 6) | r)
+    for r in range(2):
+        add('extw', 0x4880 | r)
+        add('extl', 0x48c0 | r)
+        add('swap', 0x4840 | r)
+        add('nbcd', 0x4800 | r)
+        add('tas', 0x4ac0 | r)
+
+    for q in range(8):
+        for d, name in [(0, 'addq'), (1, 'subq')]:
+            for s in range(3):
+                for r in range(2):
+                    add(name + sizes[s], 0x5000 | (q << 9) | (d << 8) | (s << 6) | r)
+    for c in range(16):
+        for r in range(2):
+            add('scc', 0x50c0 | (c << 8) | r)
+
+    for r in range(2):
+        for value in [0x00, 0x01, 0x7f, 0x80, 0xff, rng.getrandbits(8)]:
+            add('moveq', 0x7000 | (r << 9) | value)
+
+    for base, name in [(0x8000, 'or'), (0x9000, 'sub'), (0xb000, 'cmp'), (0xc000, 'and'), (0xd000, 'add')]:
+        for s in range(3):
+            for dn in range(2):
+                for r in range(2):
+                    add(name + sizes[s], base | (dn << 9) | (s << 6) | r)
+                add(name + 'i' + sizes[s], base | (dn << 9) | (s << 6) | 0x3c, lambda s=s: immediate_words(s, rng))
+    for s in range(3):
+        for dn in range(2):
+            for r in range(2):
+                add('eor' + sizes[s], 0xb100 | (dn << 9) | (s << 6) | r)
+                add('addx' + sizes[s], 0xd100 | (dn << 9) | (s << 6) | r)
+                add('subx' + sizes[s], 0x9100 | (dn << 9) | (s << 6) | r)
+    for dn in range(2):
+        for r in range(2):
+            add('abcd', 0xc100 | (dn << 9) | r)
+            add('sbcd', 0x8100 | (dn << 9) | r)
+            add('exg', 0xc140 | (dn << 9) | r)
+            add('mulu', 0xc0c0 | (dn << 9) | r)
+            add('muls', 0xc1c0 | (dn << 9) | r)
+            add('divu', 0x80c0 | (dn << 9) | r, None, r)
+            add('divs', 0x81c0 | (dn << 9) | r, None, r)
+
+    for t, name in enumerate(['as', 'ls', 'rox', 'ro']):
+        for d in range(2):
+            for s in range(3):
+                for r in range(2):
+                    for count in range(8):
+                        add(name + sizes[s], 0xe000 | (count << 9) | (d << 8) | (s << 6) | (t << 3) | r)
+                    for dn in range(2):
+                        add(name + sizes[s], 0xe020 | (dn << 9) | (d << 8) | (s << 6) | (t << 3) | r)
+    return result
+
+
+def make_instructions(rng):
+    singles = single_instructions(rng)
+    instructions = []
+    for name, opcode, ext, nonzero_divisor in singles:
+        instructions.append(Instruction(name, [opcode] + (ext() if ext else []), nonzero_divisor))
+        if ext:
+            # Same opcode at the same address with other extension words
+            instructions.append(Instruction(name, [opcode] + ext(), nonzero_divisor))
+    # Pairs, for fused instructions and flags that are used by the next instruction
+    pairs = [s for s in singles if s[3] is None]
+    pair_count = 0
+    while pair_count < PAIR_COUNT:
+        first, second = rng.choice(pairs), rng.choice(pairs)
+        words = [first[1]] + (first[2]() if first[2] else []) + [second[1]] + (second[2]() if second[2] else [])
+        if len(words) <= 8:
+            instructions.append(Instruction('pair', words, None, second[1]))
+            pair_count += 1
+    return instructions
+
+
+def make_inputs(rng, instruction):
+    inputs = []
+    while len(inputs) < TESTS_PER_INSTRUCTION:
+        d = [rng.choice(EDGE_VALUES + [rng.getrandbits(32)] * 4) for _ in range(2)]
+        if instruction.nonzero_divisor is not None and (d[instruction.nonzero_divisor] & 0xffff) == 0:
+            continue
+        inputs.append((d[0], d[1], rng.getrandbits(5)))
+    return inputs
+
+
+def ccr_text(ccr):
+    return ''.join(c if ccr & (0x10 >> i) else '.' for i, c in enumerate('XNZVC'))
+
+
+def write_results(path, instructions, inputs, outputs):
+    with open(path, 'w') as f:
+        for instruction, tests, results in zip(instructions, inputs, outputs):
+            f.write('opcode_bin:%s\n' % ' '.join('%04x' % w for w in instruction.words))
+            for (d0, d1, ccr), (r0, r1, rccr) in zip(tests, results):
+                f.write('good opcode: %s\n' % instruction.name)
+                f.write('before d0=%08x    d1=%08x    CCR=%s (%d)\n' % (d0, d1, ccr_text(ccr), ccr))
+                f.write('M68K   d0=%08x    d1=%08x    CCR=%s (%d)\n' % (r0, r1, ccr_text(rccr), rccr))
+                f.write('\n')
+            f.write('0 errors out of %d tests done for %s (%04x)\n' % (len(tests), instruction.name, instruction.words[0]))
+
+
+GEN_LINE = re.compile(r'^GEN\s+d0=([0-9a-f]{8})\s*\*?\s+d1=([0-9a-f]{8})\s*\*?\s+CCR=\S+\s*\*?\s*\((\d+)\)')
+SUMMARY_LINE = re.compile(r'^Global summary: (\d+) errors out of (\d+) tests done')
+
+
+def run_tester(tester, path, verbose):
+    arguments = [tester, 'test', '--file=' + path] + (['--verbose'] if verbose else [])
+    return subprocess.run(arguments, stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+
+
+def write_pair_profile(path, instructions):
+    counts = {}
+    for instruction in instructions:
+        if instruction.second_opcode is not None:
+            pair = (instruction.words[0], instruction.second_opcode)
+            counts[pair] = counts.get(pair, 0) + 1
+    with open(path, 'w') as f:
+        f.write('FIRST\tSECOND\tCOUNT\n')
+        for (first, second), count in sorted(counts.items()):
+            f.write('%.4X\t%.4X\t%d\n' % (first, second, count))
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 2
+    rng = random.Random(68000)
+    instructions = make_instructions(rng)
+    if sys.argv[1] == '--pair-profile':
+        write_pair_profile(sys.argv[2], instructions)
+        return 0
+    reference, tested = sys.argv[1], sys.argv[2]
+    work = sys.argv[3] if len(sys.argv) > 3 else '.'
+
+    inputs = [make_inputs(rng, instruction) for instruction in instructions]
+    test_count = sum(len(tests) for tests in inputs)
+
+    # The reference results, the M68K lines of the input file are ignored
+    input_path = os.path.join(work, 'differential-input.txt')
+    write_results(input_path, instructions, inputs, [[(0, 0, 0)] * len(tests) for tests in inputs])
+    gen = [tuple(int(v, 16) if i < 2 else int(v) for i, v in enumerate(m.groups()))
+           for m in map(GEN_LINE.match, run_tester(reference, input_path, True).splitlines()) if m]
+    if len(gen) != test_count:
+        print('The reference tester ran %d of %d tests' % (len(gen), test_count))
+        return 1
+    outputs = []
+    for tests in inputs:
+        outputs.append(gen[:len(tests)])
+        gen = gen[len(tests):]
+    expected_path = os.path.join(work, 'differential-expected.txt')
+    write_results(expected_path, instructions, inputs, outputs)
+
+    failed = False
+    for name, tester in [('reference', reference), ('tested', tested)]:
+        output = run_tester(tester, expected_path, False)
+        summary = [m for m in map(SUMMARY_LINE.match, output.splitlines()) if m]
+        if not summary:
+            print('%s tester %s gave no summary' % (name, tester))
+            failed = True
+            continue
+        errors, tests = int(summary[-1].group(1)), int(summary[-1].group(2))
+        print('%s tester %s: %d errors out of %d tests' % (name, tester, errors, tests))
+        if errors != 0 or tests != test_count:
+            print('\n'.join(line for line in output.splitlines() if line and not line.startswith('0 errors')))
+            failed = True
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -25,7 +25,7 @@
 #if DEBUG
 #define D(x) x
 #else
-#define D(x) ;
+#define D(x) do { if (0) { x; } } while (0)
 #endif
 
 #endif /* DEBUG_H */
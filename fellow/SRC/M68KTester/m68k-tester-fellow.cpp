@@ -91,6 +91,16 @@ void memoryWriteLong(ULO data, ULO address)
 
 
 
+// The CPU module state functions are not used, but are linked
+
+void savestateWrite(savestate *S, const void *data, ULO size)
+{
+}
+
+void savestateRead(savestate *S, void *data, ULO size)
+{
+}
+
 extern void cpuSetRaiseInterrupt(BOOLE f);
 
 m68k_cpu::m68k_cpu()
@@ -124,7 +134,7 @@ uint32 m68k_cpu::get_ccr() const
 
 void m68k_cpu::set_ccr(uint32 ccr)
 {
-  cpuSetSR(cpuGetSR() & 0xff00 | (ccr & 0xff));
+  cpuSetSR((cpuGetSR() & 0xff00) | (ccr & 0xff));
 }
 
 uint32 m68k_cpu::get_dreg(int r) const
@@ -598,7 +598,6 @@ static int read_testcase_binary(FILE *fp, m68k_testcase_t *tp)
 			inst->n_words = 1 + 2 * len;
 			inst->words[0] = INS_opcode::extract(value);
 			for (int i = 0; i < len; i++) {
-				uint32 opcode;
 				error |= get_be32(fp, &value);
 				inst->words[2*i + 0] = value >> 16;
 				inst->words[2*i + 1] = value;
@@ -702,7 +701,6 @@ static int get_mnemo(m68k_instruction_t *inst)
 		{ 0xf118, 0xe000, i_ASR },
 		{ 0x0000, 0x0000, i_UNKNOWN }
 	};
-	int insn = i_UNKNOWN;
 	for (int i = 0; instr_table[i].insn != i_UNKNOWN; i++) {
 		if ((opcode & instr_table[i].mask) == instr_table[i].match)
 			return instr_table[i].insn;
@@ -719,7 +717,6 @@ static void patch_immi(m68k_cpu *cpu, m68k_testcase_t *tp)
 {
 	m68k_instruction_t *inst = tp->inst;
 	uint32 d0 = tp->input_state.dregs[0];
-	uint32 d1 = tp->input_state.dregs[1];
 
 	// XXX: this is terribly wrong
 	static uint16 old_opcode = 0;
@@ -955,7 +952,6 @@ static int put_RES_block(FILE *fp, int type, uint32 count)
 
 static void print_test_binary(m68k_testcase_t *tp)
 {
-	uint32 value;
 	FILE *fp = stdout;
 
 	// CPU block (before)
@@ -1165,8 +1161,8 @@ int main(int argc, char *argv[])
 
 	m68k_testcase_t testcase;
 	memset(&testcase, 0, sizeof(testcase));
-	int n_tests, n_tests_total = 0;
-	int n_errors, n_errors_total = 0;
+	int n_tests = 0, n_tests_total = 0;
+	int n_errors = 0, n_errors_total = 0;
 
 	while (!feof(stdin) && !ferror(stdin)) {
 		int rc;
@@ -40,11 +40,17 @@ typedef uint64_t uint64;
 typedef uintptr_t uintptr;
 
 
+#ifdef _WIN32
 #include <Winsock2.h>
 #include <io.h>
 #define STDIN_FILENO 0
 #define STDOUT_FILENO 1
 #include <malloc.h>
 #define alloca _alloca
+#else
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <alloca.h>
+#endif
 
 #endif /* SYSDEPS_H */
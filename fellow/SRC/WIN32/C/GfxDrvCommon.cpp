@@ -583,7 +583,7 @@ void GfxDrvCommon::SetDrawMode(draw_mode* mode, bool windowed)
 
 void GfxDrvCommon::Flip()
 {
-  if (soundGetEmulation() == SOUND_PLAY)
+  if (soundGetEmulation() == SOUND_PLAY && !fellowGetWarpMode())
   {
     MaybeDelayFlip();
   }
@@ -54,6 +54,8 @@
 
 extern struct uaedev_mount_info mountinfo;
 
+static int get_volume_name(struct uaedev_mount_info *, char *, char *, int, int, int, int);
+
 /*===========================================================================*/
 /* automount drives if wanted                                                */
 /*===========================================================================*/
@@ -152,6 +152,7 @@ felist               *gfx_drv_ddraw_devices;
 
 bool gfx_drv_ddraw_initialized;
 bool gfx_drv_ddraw_clear_borders;
+bool gfx_drv_ddraw_present_full;    /* Next flip shows the whole buffer */
 ULO gfx_drv_output_width;
 ULO gfx_drv_output_height;
 
@@ -834,11 +835,13 @@ void gfxDrvDDrawReleaseFullScreenModeInformation(gfx_drv_ddraw_device *ddraw_dev
 
 /*==========================================================================*/
 /* Set cooperative level                                                    */
+/* Multithreaded, the present thread of the pipelined mode locks and flips  */
+/* the surfaces that the emulation thread created.                          */
 /*==========================================================================*/
 
 bool gfxDrvDDrawSetCooperativeLevelNormal(gfx_drv_ddraw_device *ddraw_device)
 {
-  HRESULT err = IDirectDraw2_SetCooperativeLevel(ddraw_device->lpDD2, gfxDrvCommon->GetHWND(), DDSCL_NORMAL);
+  HRESULT err = IDirectDraw2_SetCooperativeLevel(ddraw_device->lpDD2, gfxDrvCommon->GetHWND(), DDSCL_NORMAL | DDSCL_MULTITHREADED);
   if (err != DD_OK)
   {
     gfxDrvDDrawFailure("gfxDrvDDrawSetCooperativeLevelNormal(): ", err);
@@ -849,7 +852,7 @@ bool gfxDrvDDrawSetCooperativeLevelNormal(gfx_drv_ddraw_device *ddraw_device)
 
 bool gfxDrvDDrawSetCooperativeLevelExclusive(gfx_drv_ddraw_device *ddraw_device)
 {
-  HRESULT err = IDirectDraw2_SetCooperativeLevel(ddraw_device->lpDD2, gfxDrvCommon->GetHWND(), DDSCL_FULLSCREEN | DDSCL_EXCLUSIVE);
+  HRESULT err = IDirectDraw2_SetCooperativeLevel(ddraw_device->lpDD2, gfxDrvCommon->GetHWND(), DDSCL_FULLSCREEN | DDSCL_EXCLUSIVE | DDSCL_MULTITHREADED);
   if (err != DD_OK)
   {
     gfxDrvDDrawFailure("gfxDrvDDrawSetCooperativeLevelExclusive(): ", err);
@@ -920,7 +923,17 @@ HRESULT gfxDrvDDrawSurfaceRestore(gfx_drv_ddraw_device *ddraw_device, LPDIRECTDR
         gfxDrvDDrawSurfaceClear(ddraw_device, ddraw_device->lpDDSBack);
       }
     }
-    graphLineDescClear();
+    gfx_drv_ddraw_present_full = true;
+    if (drawGetPipelined())
+    {
+      // On the present thread the emulation is filling in the next frame,
+      // let it clear the line descriptions at the end of that frame
+      graph_buffer_lost = TRUE;
+    }
+    else
+    {
+      graphLineDescClear();
+    }
   }
   return err;
 }
@@ -985,11 +998,41 @@ void gfxDrvDDrawCalculateDestinationRectangle(ULO output_width, ULO output_heigh
   }
 }
 
+/*==========================================================================*/
+/* Maps a changed part of the secondary buffer to the part of the           */
+/* destination it is stretched to                                           */
+/* Returns false if it is outside the source window                         */
+/*==========================================================================*/
+
+static bool gfxDrvDDrawDirtyRectangle(const draw_rect &dirty, const RECT &srcwin, const RECT &dstwin, RECT &srcpart, RECT &dstpart)
+{
+  srcpart.left = ((LONG) dirty.left > srcwin.left) ? (LONG) dirty.left : srcwin.left;
+  srcpart.top = ((LONG) dirty.top > srcwin.top) ? (LONG) dirty.top : srcwin.top;
+  srcpart.right = ((LONG) dirty.right < srcwin.right) ? (LONG) dirty.right : srcwin.right;
+  srcpart.bottom = ((LONG) dirty.bottom < srcwin.bottom) ? (LONG) dirty.bottom : srcwin.bottom;
+  if (srcpart.left >= srcpart.right || srcpart.top >= srcpart.bottom)
+  {
+    return false;
+  }
+
+  LONG srcwidth = srcwin.right - srcwin.left;
+  LONG srcheight = srcwin.bottom - srcwin.top;
+  LONG dstwidth = dstwin.right - dstwin.left;
+  LONG dstheight = dstwin.bottom - dstwin.top;
+  dstpart.left = dstwin.left + ((srcpart.left - srcwin.left)*dstwidth)/srcwidth;
+  dstpart.top = dstwin.top + ((srcpart.top - srcwin.top)*dstheight)/srcheight;
+  dstpart.right = dstwin.left + ((srcpart.right - srcwin.left)*dstwidth)/srcwidth;
+  dstpart.bottom = dstwin.top + ((srcpart.bottom - srcwin.top)*dstheight)/srcheight;
+  return (dstpart.left < dstpart.right) && (dstpart.top < dstpart.bottom);
+}
+
 /*==========================================================================*/
 /* Blit secondary buffer to the primary surface                             */
+/* With a dirty region only the parts that changed are blitted, the rest of */
+/* the destination still shows them from the previous frame                 */
 /*==========================================================================*/
 
-void gfxDrvDDrawSurfaceBlit(gfx_drv_ddraw_device *ddraw_device)
+void gfxDrvDDrawSurfaceBlit(gfx_drv_ddraw_device *ddraw_device, const draw_dirty_region *dirty_region)
 {
   HRESULT err;
   RECT srcwin;
@@ -1029,6 +1072,25 @@ void gfxDrvDDrawSurfaceBlit(gfx_drv_ddraw_device *ddraw_device)
   /* Destination window */
   gfxDrvDDrawCalculateDestinationRectangle(gfx_drv_output_width, gfx_drv_output_height, ddraw_device, dstwin);
 
+  if (dirty_region != nullptr)
+  {
+    err = DD_OK;
+    for (ULO i = 0; i < dirty_region->rect_count && err == DD_OK; i++)
+    {
+      RECT srcpart;
+      RECT dstpart;
+      if (gfxDrvDDrawDirtyRectangle(dirty_region->rects[i], srcwin, dstwin, srcpart, dstpart))
+      {
+        err = IDirectDrawSurface_Blt(lpDDSDestination, &dstpart, ddraw_device->lpDDSSecondary, &srcpart, DDBLT_ASYNC, &bltfx);
+      }
+    }
+    if (err == DD_OK)
+    {
+      return;
+    }
+    /* Blit everything below, it also handles lost surfaces */
+  }
+
   /* This can fail when a surface is lost */
   err = IDirectDrawSurface_Blt(lpDDSDestination, &dstwin, ddraw_device->lpDDSSecondary, &srcwin, DDBLT_ASYNC, &bltfx);
   if (err != DD_OK)
@@ -1441,11 +1503,23 @@ void gfxDrvDDrawSurfaceUnlock(gfx_drv_ddraw_device *ddraw_device)
 /* Flip to next buffer                                                      */
 /*==========================================================================*/
 
-void gfxDrvDDrawFlip()
+void gfxDrvDDrawFlip(const draw_dirty_region *dirty_region)
 {
+  /* Parts of the frame can only be shown when they are blitted to a single */
+  /* primary surface that still holds the previous frame */
+  bool present_partial = gfx_drv_ddraw_device_current->use_blitter
+                      && gfx_drv_ddraw_device_current->buffercount == 1
+                      && !gfx_drv_ddraw_present_full
+                      && !dirty_region->full;
+
+  gfx_drv_ddraw_present_full = false;
+  if (present_partial && dirty_region->identical)
+  {
+    return;
+  }
   if (gfx_drv_ddraw_device_current->use_blitter)     /* Blit secondary buffer to primary */
   {
-    gfxDrvDDrawSurfaceBlit(gfx_drv_ddraw_device_current);
+    gfxDrvDDrawSurfaceBlit(gfx_drv_ddraw_device_current, (present_partial) ? dirty_region : nullptr);
   }
   if (gfx_drv_ddraw_device_current->buffercount > 1)    /* Flip buffer if there are several */
   {
@@ -1619,6 +1693,7 @@ void gfxDrvDDrawSizeChanged(unsigned int width, unsigned int height)
 
     gfxDrvDDrawFindWindowClientRect(gfx_drv_ddraw_device_current);
     gfx_drv_ddraw_clear_borders = true;
+    gfx_drv_ddraw_present_full = true;
   }
   else
     fellowAddLog("DDraw fullscreen size ignored: %u %u\n", width, height);
@@ -1630,6 +1705,7 @@ void gfxDrvDDrawPositionChanged()
   {
     gfxDrvDDrawFindWindowClientRect(gfx_drv_ddraw_device_current);
     gfx_drv_ddraw_clear_borders = true;
+    gfx_drv_ddraw_present_full = true;
   }
 }
 
@@ -1673,6 +1749,7 @@ void gfxDrvDDrawSetMode(draw_mode *dm, bool windowed)
 bool gfxDrvDDrawEmulationStart(ULO maxbuffercount)
 {
   gfx_drv_ddraw_device_current->maxbuffercount = maxbuffercount;
+  gfx_drv_ddraw_present_full = true;
   return true;
 }
 
@@ -1715,6 +1792,7 @@ bool gfxDrvDDrawStartup()
 {
   graph_buffer_lost = FALSE;
   gfx_drv_ddraw_clear_borders = false;
+  gfx_drv_ddraw_present_full = true;
   gfx_drv_ddraw_initialized = gfxDrvDDrawInitialize();
   return gfx_drv_ddraw_initialized;
 }
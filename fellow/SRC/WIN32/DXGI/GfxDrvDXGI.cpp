@@ -246,6 +246,7 @@ bool GfxDrvDXGI::CreateAmigaScreenTexture()
   texture2DDesc.MiscFlags = 0;
 
   HRESULT hr = _d3d11device->CreateTexture2D(&texture2DDesc, 0, &_shaderInputTexture);
+  _present_full = true;
 
   if (FAILED(hr))
   {
@@ -292,6 +293,7 @@ bool GfxDrvDXGI::CreateSwapChain()
   int height = _current_draw_mode->height;
 
   _resize_swapchain_buffers = false;
+  _present_full = true;
 
   DXGI_SWAP_CHAIN_DESC swapChainDescription = { 0 };
   DXGI_SWAP_EFFECT swapEffect = DXGI_SWAP_EFFECT_DISCARD;
@@ -391,6 +393,7 @@ DXGI_MODE_DESC* GfxDrvDXGI::GetDXGIMode(unsigned int id)
 void GfxDrvDXGI::NotifyActiveStatus(bool active)
 {
   fellowAddLog("GfxDrvDXGI::NotifyActiveStatus(%s)\n", active ? "TRUE" : "FALSE");
+  _present_full = true;
   if (!gfxDrvCommon->GetOutputWindowed() && _swapChain != nullptr)
   {
     _swapChain->SetFullscreenState(active, 0);
@@ -402,10 +405,12 @@ void GfxDrvDXGI::SizeChanged(unsigned int width, unsigned int height)
 {
   // Don't execute the resize here, do it in the thread that renders
   _resize_swapchain_buffers = true;
+  _present_full = true;
 }
 
 void GfxDrvDXGI::PositionChanged()
 {
+  _present_full = true;
 }
 
 void GfxDrvDXGI::ResizeSwapChainBuffers()
@@ -848,10 +853,37 @@ bool GfxDrvDXGI::RenderAmigaScreenToBackBuffer()
   return shaderResult;
 }
 
-void GfxDrvDXGI::FlipTexture()
+// Uploads the host buffer to the shader input texture, only the changed
+// parts of it when there is a dirty region
+
+void GfxDrvDXGI::FlipTexture(const draw_dirty_region *dirty_region)
 {
   ID3D11Texture2D *amigaScreenBuffer = GetCurrentAmigaScreenTexture();
-  _immediateContext->CopyResource(_shaderInputTexture, amigaScreenBuffer);
+  if (dirty_region == nullptr)
+  {
+    _immediateContext->CopyResource(_shaderInputTexture, amigaScreenBuffer);
+  }
+  else
+  {
+    D3D11_TEXTURE2D_DESC amigaScreenBufferDesc;
+    amigaScreenBuffer->GetDesc(&amigaScreenBufferDesc);
+
+    for (ULO i = 0; i < dirty_region->rect_count; i++)
+    {
+      const draw_rect &rect = dirty_region->rects[i];
+      D3D11_BOX box;
+      box.left = rect.left;
+      box.top = rect.top;
+      box.front = 0;
+      box.right = (rect.right < amigaScreenBufferDesc.Width) ? rect.right : amigaScreenBufferDesc.Width;
+      box.bottom = (rect.bottom < amigaScreenBufferDesc.Height) ? rect.bottom : amigaScreenBufferDesc.Height;
+      box.back = 1;
+      if (box.left < box.right && box.top < box.bottom)
+      {
+        _immediateContext->CopySubresourceRegion(_shaderInputTexture, 0, box.left, box.top, 0, amigaScreenBuffer, 0, &box);
+      }
+    }
+  }
 
   ID3D11Texture2D *backBuffer;
   HRESULT getBufferResult = _swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&backBuffer);
@@ -888,9 +920,18 @@ void GfxDrvDXGI::FlipTexture()
   }
 }
 
-void GfxDrvDXGI::Flip()
+// A frame that did not change is not presented again, unless the window
+// or the textures changed since the last present
+
+void GfxDrvDXGI::Flip(const draw_dirty_region *dirty_region)
 {
-  FlipTexture();
+  bool present_full = _present_full || dirty_region->full;
+
+  _present_full = false;
+  if (present_full || !dirty_region->identical)
+  {
+    FlipTexture((present_full) ? nullptr : dirty_region);
+  }
 
   _currentAmigaScreenTexture++;
   if (_currentAmigaScreenTexture >= _amigaScreenTextureCount)
@@ -1072,7 +1113,8 @@ GfxDrvDXGI::GfxDrvDXGI()
     _shaderInputTexture(nullptr),
     _amigaScreenTextureCount(AmigaScreenTextureCount),
     _currentAmigaScreenTexture(0),
-    _resize_swapchain_buffers(false)
+    _resize_swapchain_buffers(false),
+    _present_full(true)
 {
   for (unsigned int i = 0; i < _amigaScreenTextureCount; i++)
   {
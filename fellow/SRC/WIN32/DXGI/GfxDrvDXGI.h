@@ -51,6 +51,7 @@ private:
   draw_mode *_current_draw_mode;
 
   bool _resize_swapchain_buffers;
+  bool _present_full;
 
 private:
   void CreateAdapterList();
@@ -83,7 +84,7 @@ private:
 
   bool RenderAmigaScreenToBackBuffer();
 
-  void FlipTexture();
+  void FlipTexture(const draw_dirty_region *dirty_region);
 
   STR* GetFeatureLevelString(D3D_FEATURE_LEVEL featureLevel);
 
@@ -122,7 +123,7 @@ public:
   unsigned char *ValidateBufferPointer();
   void InvalidateBufferPointer();
   void GetBufferInformation(draw_buffer_information *buffer_information);
-  void Flip();
+  void Flip(const draw_dirty_region *dirty_region);
 
   bool SaveScreenshot(const bool, const STR *);
 
@@ -13,7 +13,7 @@ UBY *gfxDrvDDrawValidateBufferPointer();
 void gfxDrvDDrawInvalidateBufferPointer();
 void gfxDrvDDrawGetBufferInformation(draw_buffer_information *buffer_information);
 
-void gfxDrvDDrawFlip();
+void gfxDrvDDrawFlip(const draw_dirty_region *dirty_region);
 
 bool gfxDrvDDrawEmulationStart(ULO maxbuffercount);
 unsigned int gfxDrvDDrawEmulationStartPost();
@@ -0,0 +1,395 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* Blitter benchmark, replays a blitter operation trace (blitterops.trc)   */
+/* through the blitter kernels and reports how fast they ran.              */
+/* With --selftest it checks the row kernel against the word at a time     */
+/* blitter instead.                                                        */
+/*                                                                         */
+/* The trace is recorded by an emulator built with BLIT_OPERATION_LOG and  */
+/* the operation log turned on. This program links with C/BLIT.C, also     */
+/* built with BLIT_OPERATION_LOG, and stubs out the rest of the emulator.  */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "blit.h"
+#include "fmem.h"
+#include "graph.h"
+#include "draw.h"
+#include "bus.h"
+#include "fileops.h"
+#include "CpuIntegration.h"
+#include "chipset.h"
+#include "savestate.h"
+
+/*=========================================================================*/
+/* The parts of the emulator the blitter uses                              */
+/*=========================================================================*/
+
+UBY memory_chip[0x200000 + 32];
+UBY memory_chip_dirty[(0x200000 >> MEMORY_PAGE_SHIFT) + 1];
+ULO memory_chipsize;
+chipset_information chipset;
+bus_state bus;
+bus_event blitterEvent;
+ULO dmaconr;
+ULO dmacon;
+ULO draw_frame_count;
+
+void memoryWriteWord(UWO data, ULO address) {}
+void memorySetIoWriteStub(ULO index, memoryIoWriteFunc iowritefunction) {}
+void busInsertEvent(bus_event *ev) {}
+void busRemoveEvent(bus_event *ev) {}
+ULO busGetCyclesInThisFrame(void) {return 0;}
+ULO busGetRasterX(void) {return 0;}
+ULO busGetRasterY(void) {return 0;}
+void cpuIntegrationSetChipSlowdown(ULO chip_slowdown) {}
+void cpuIntegrationSetChipCycles(ULO chip_cycles) {}
+bool chipsetGetECS(void) {return true;}
+BOOLE fileopsGetGenericFileName(char *path, const char *subdir, const char *filename) {return FALSE;}
+BOOLE fellowCPUHasSSE2(void) {return TRUE;}
+void memoryNotifyDirectWrite(UBY *address, ULO size)
+{
+  ULO first = (ULO) (address - memory_chip);
+  ULO page;
+  for (page = first >> MEMORY_PAGE_SHIFT; page <= (first + size - 1) >> MEMORY_PAGE_SHIFT; page++) memory_chip_dirty[page] = 1;
+}
+void savestateChunkBegin(savestate *S, ULO id, ULO version) {}
+void savestateChunkEnd(savestate *S) {}
+void savestateWrite(savestate *S, const void *data, ULO size) {}
+void savestateRead(savestate *S, void *data, ULO size) {}
+
+/*=========================================================================*/
+/* Trace loading                                                           */
+/*=========================================================================*/
+
+typedef struct
+{
+  ULO ptr_mask;
+  ULO size;
+  UBY *memory;
+} blitreplay_snapshot;
+
+blitreplay_snapshot *blitreplay_snapshots;
+ULO blitreplay_snapshot_count;
+blitter_trace_record *blitreplay_records;
+ULO blitreplay_record_count;
+
+static BOOLE blitreplayReadULO(FILE *F, ULO *data)
+{
+  return fread(data, sizeof(ULO), 1, F) == 1;
+}
+
+static BOOLE blitreplayLoadTrace(char *filename)
+{
+  FILE *F = fopen(filename, "rb");
+  ULO magic, version, item;
+  ULO record_capacity = 0;
+
+  if (F == NULL)
+  {
+    fprintf(stderr, "Can't open %s\n", filename);
+    return FALSE;
+  }
+  if (!blitreplayReadULO(F, &magic) || !blitreplayReadULO(F, &version) || magic != BLITTER_TRACE_MAGIC || version != BLITTER_TRACE_VERSION)
+  {
+    fprintf(stderr, "%s is not a version %u blitter trace\n", filename, BLITTER_TRACE_VERSION);
+    fclose(F);
+    return FALSE;
+  }
+  while (blitreplayReadULO(F, &item))
+  {
+    if (item == BLITTER_TRACE_ITEM_CHIPMEM)
+    {
+      blitreplay_snapshot *snapshot;
+      ULO number;
+
+      blitreplay_snapshots = (blitreplay_snapshot *) realloc(blitreplay_snapshots, sizeof(blitreplay_snapshot)*(blitreplay_snapshot_count + 1));
+      snapshot = &blitreplay_snapshots[blitreplay_snapshot_count];
+      if (!blitreplayReadULO(F, &number) || !blitreplayReadULO(F, &snapshot->ptr_mask) || !blitreplayReadULO(F, &snapshot->size)) break;
+      if (number != blitreplay_snapshot_count + 1 || snapshot->size > 0x200000) break;
+      snapshot->memory = (UBY *) malloc(snapshot->size);
+      if (fread(snapshot->memory, sizeof(UBY), snapshot->size, F) != snapshot->size) break;
+      blitreplay_snapshot_count++;
+    }
+    else if (item == BLITTER_TRACE_ITEM_BLIT)
+    {
+      if (blitreplay_record_count == record_capacity)
+      {
+	record_capacity = (record_capacity == 0) ? 4096 : 2*record_capacity;
+	blitreplay_records = (blitter_trace_record *) realloc(blitreplay_records, sizeof(blitter_trace_record)*record_capacity);
+      }
+      if (fread(&blitreplay_records[blitreplay_record_count], sizeof(blitter_trace_record), 1, F) != 1) break;
+      if (blitreplay_records[blitreplay_record_count].chipmem_snapshot == 0 || blitreplay_records[blitreplay_record_count].chipmem_snapshot > blitreplay_snapshot_count) break;
+      blitreplay_record_count++;
+    }
+    else
+    {
+      break;
+    }
+  }
+  if (!feof(F))
+  {
+    fprintf(stderr, "%s is damaged, using the first %u blits\n", filename, blitreplay_record_count);
+  }
+  fclose(F);
+  return TRUE;
+}
+
+/*=========================================================================*/
+/* Replay                                                                  */
+/*=========================================================================*/
+
+static void blitreplayRestoreSnapshot(ULO number)
+{
+  blitreplay_snapshot *snapshot = &blitreplay_snapshots[number - 1];
+  chipset.ptr_mask = snapshot->ptr_mask;
+  memory_chipsize = snapshot->size;
+  memset(memory_chip, 0, sizeof(memory_chip));
+  memcpy(memory_chip, snapshot->memory, snapshot->size);
+}
+
+/* Chip memory words read and written by a blit */
+static ULL blitreplayBlitWords(blitter_trace_record *record)
+{
+  ULO channels = (record->bltcon >> 24) & 0xf;
+  ULO channel_count = ((channels >> 3) & 1) + ((channels >> 2) & 1) + ((channels >> 1) & 1) + (channels & 1);
+  ULL words = (record->bltcon & 1) ? record->height : (((ULL) record->width)*record->height);
+  return words*channel_count;
+}
+
+/*=========================================================================*/
+/* Self test                                                               */
+/* Random area blits are done by the row kernel and by the word at a time  */
+/* blitter from the same chip memory. The memory, the registers and the    */
+/* zero flag must be the same after both. The pages a blit writes are      */
+/* found in memory_chip_dirty, written by both blitters.                   */
+/*=========================================================================*/
+
+#define BLITREPLAY_PAGES ((0x200000 >> MEMORY_PAGE_SHIFT) + 1)
+
+UBY blitreplay_memory_before[0x200000 + 32];
+UBY blitreplay_memory_row[0x200000 + 32];
+BOOLE blitreplay_page_written[BLITREPLAY_PAGES];
+
+static ULO blitreplay_random_state = 1;
+
+static ULO blitreplayRandom(ULO range)
+{
+  blitreplay_random_state = blitreplay_random_state*1103515245 + 12345;
+  return ((blitreplay_random_state >> 8) & 0xffffff) % range;
+}
+
+static ULO blitreplayRandomWord(void)
+{
+  return (blitreplayRandom(0x1000) << 4) | blitreplayRandom(0x10);
+}
+
+/* A pointer anywhere, or close enough to either end of chip memory for the blit to wrap around */
+static ULO blitreplayRandomPointer(void)
+{
+  switch (blitreplayRandom(4))
+  {
+    case 0: return chipset.ptr_mask - 2*blitreplayRandom(64);
+    case 1: return 2*blitreplayRandom(64);
+    default: return blitreplayRandom(chipset.ptr_mask + 2) & chipset.ptr_mask;
+  }
+}
+
+static ULO blitreplayRandomModulo(ULO width)
+{
+  LON modulo = (blitreplayRandom(4) == 0) ? 0 : (((LON) blitreplayRandom(4*width + 64)) - (LON) (2*width));
+  return (ULO) (LON) (WOR) (modulo & 0xfffe);
+}
+
+static void blitreplayRandomBlit(blitter_trace_record *record)
+{
+  static const UBY minterms[] = {0x00, 0xf0, 0xca, 0x3c, 0x5a, 0x66, 0x0f, 0xff};
+  ULO channels = blitreplayRandom(16);
+  ULO minterm = (blitreplayRandom(2) == 0) ? minterms[blitreplayRandom(sizeof(minterms))] : blitreplayRandom(256);
+  ULO a_shift = blitreplayRandom(16);
+  ULO b_shift = blitreplayRandom(16);
+  ULO fill = (blitreplayRandom(3) == 0) ? (blitreplayRandom(3) + 1) << 3 : 0;
+
+  memset(record, 0, sizeof(blitter_trace_record));
+  record->width = (blitreplayRandom(4) == 0) ? blitreplayRandom(64) + 1 : blitreplayRandom(16) + 1;
+  record->height = blitreplayRandom(32) + 1;
+  record->bltcon = (a_shift << 28) | (channels << 24) | (minterm << 16) | (b_shift << 12) | fill | (blitreplayRandom(2) << 2) | (blitreplayRandom(2) << 1);
+  record->bltafwm = (blitreplayRandom(2) == 0) ? 0xffff : blitreplayRandomWord();
+  record->bltalwm = (blitreplayRandom(2) == 0) ? 0xffff : blitreplayRandomWord();
+  record->bltdpt = blitreplayRandomPointer();
+  record->bltdmod = blitreplayRandomModulo(record->width);
+  record->bltapt = blitreplayRandomPointer();
+  record->bltamod = blitreplayRandomModulo(record->width);
+  record->bltbpt = blitreplayRandomPointer();
+  record->bltbmod = blitreplayRandomModulo(record->width);
+  record->bltcpt = blitreplayRandomPointer();
+  record->bltcmod = blitreplayRandomModulo(record->width);
+  switch (blitreplayRandom(4))
+  {
+    case 0: /* Source and destination are the same words, the usual cookie cut */
+      record->bltcpt = record->bltdpt;
+      record->bltcmod = record->bltdmod;
+      break;
+    case 1: /* Overlapping, the row kernel must leave it to the word at a time blitter */
+      record->bltapt = (record->bltdpt + 2*blitreplayRandom(8)) & chipset.ptr_mask;
+      record->bltamod = record->bltdmod;
+      break;
+  }
+  record->bltadat = blitreplayRandomWord();
+  record->bltbdat = blitreplayRandomWord();
+  record->bltbdat_original = record->bltbdat;
+  record->bltcdat = blitreplayRandomWord();
+  record->a_shift_asc = a_shift;
+  record->a_shift_desc = 16 - a_shift;
+  record->b_shift_asc = b_shift;
+  record->b_shift_desc = 16 - b_shift;
+}
+
+/* Runs the blit from blitreplay_memory_before, returns the registers and the zero flag after it */
+static BOOLE blitreplayRunBlit(blitter_trace_record *record, BOOLE row_kernel, blitter_trace_record *result)
+{
+  ULO page;
+  memset(memory_chip_dirty, 0, sizeof(memory_chip_dirty));
+  blitterSetRowKernel(row_kernel);
+  blitterOperationReplay(record);
+  memset(result, 0, sizeof(blitter_trace_record));
+  blitterOperationRecord(result);
+  for (page = 0; page < BLITREPLAY_PAGES; page++)
+  {
+    if (memory_chip_dirty[page]) blitreplay_page_written[page] = TRUE;
+  }
+  return blitterGetZeroFlag();
+}
+
+static void blitreplayPrintRecord(const char *title, blitter_trace_record *record)
+{
+  printf("%s bltcon %.8X fwm %.4X lwm %.4X width %u height %u\n", title, record->bltcon, record->bltafwm, record->bltalwm, record->width, record->height);
+  printf("  A %.6X %.8X  B %.6X %.8X  C %.6X %.8X  D %.6X %.8X\n", record->bltapt, record->bltamod, record->bltbpt, record->bltbmod, record->bltcpt, record->bltcmod, record->bltdpt, record->bltdmod);
+  printf("  adat %.4X bdat %.8X (%.4X) cdat %.4X\n", record->bltadat, record->bltbdat, record->bltbdat_original, record->bltcdat);
+}
+
+static int blitreplaySelfTest(ULO count)
+{
+  ULO errors = 0;
+  ULO i, page;
+
+  blitterStartup();
+  for (i = 0; i < sizeof(memory_chip); i++) memory_chip[i] = (UBY) blitreplayRandom(256);
+  memcpy(blitreplay_memory_before, memory_chip, sizeof(memory_chip));
+  memcpy(blitreplay_memory_row, memory_chip, sizeof(memory_chip));
+  for (i = 0; i < count; i++)
+  {
+    blitter_trace_record record, row_result, word_result;
+    BOOLE row_zero, word_zero, same_memory = TRUE;
+
+    chipset.ptr_mask = (i & 1) ? 0x1ffffe : 0x7fffe;
+    memory_chipsize = chipset.ptr_mask + 2;
+    blitreplayRandomBlit(&record);
+    memset(blitreplay_page_written, 0, sizeof(blitreplay_page_written));
+
+    row_zero = blitreplayRunBlit(&record, TRUE, &row_result);
+    for (page = 0; page < BLITREPLAY_PAGES; page++)
+    {
+      if (blitreplay_page_written[page])
+      {
+	ULO offset = page << MEMORY_PAGE_SHIFT;
+	memcpy(blitreplay_memory_row + offset, memory_chip + offset, MEMORY_PAGE_SIZE);
+	memcpy(memory_chip + offset, blitreplay_memory_before + offset, MEMORY_PAGE_SIZE);
+      }
+    }
+
+    word_zero = blitreplayRunBlit(&record, FALSE, &word_result);
+    for (page = 0; page < BLITREPLAY_PAGES; page++)
+    {
+      if (blitreplay_page_written[page])
+      {
+	ULO offset = page << MEMORY_PAGE_SHIFT;
+	if (memcmp(blitreplay_memory_row + offset, memory_chip + offset, MEMORY_PAGE_SIZE) != 0) same_memory = FALSE;
+	memcpy(blitreplay_memory_before + offset, memory_chip + offset, MEMORY_PAGE_SIZE);
+	memcpy(blitreplay_memory_row + offset, memory_chip + offset, MEMORY_PAGE_SIZE);
+      }
+    }
+
+    if (!same_memory || row_zero != word_zero || memcmp(&row_result, &word_result, sizeof(blitter_trace_record)) != 0)
+    {
+      if (++errors <= 10)
+      {
+	printf("Blit %u differs:%s%s%s\n", i, (same_memory) ? "" : " memory", (row_zero != word_zero) ? " zero flag" : "",
+	       (memcmp(&row_result, &word_result, sizeof(blitter_trace_record)) != 0) ? " registers" : "");
+	blitreplayPrintRecord("Blit", &record);
+	blitreplayPrintRecord("Row kernel", &row_result);
+	blitreplayPrintRecord("Word at a time", &word_result);
+      }
+    }
+  }
+  blitterShutdown();
+  printf("%u errors out of %u blits\n", errors, count);
+  return (errors == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+  ULO repeat = 1;
+  ULO i, r;
+  ULL words = 0;
+  clock_t start, elapsed = 0;
+  double seconds;
+
+  if (argc < 2)
+  {
+    printf("Usage: blitreplay <blitterops.trc> [repeat count]\n");
+    printf("       blitreplay --selftest [blit count]\n");
+    return 1;
+  }
+  if (strcmp(argv[1], "--selftest") == 0)
+  {
+    return blitreplaySelfTest((argc >= 3) ? atoi(argv[2]) : 20000);
+  }
+  if (argc >= 3) repeat = atoi(argv[2]);
+  if (repeat == 0) repeat = 1;
+  if (!blitreplayLoadTrace(argv[1])) return 1;
+  if (blitreplay_record_count == 0)
+  {
+    printf("No blits in %s\n", argv[1]);
+    return 0;
+  }
+
+  blitterStartup();
+  start = clock();
+  for (r = 0; r < repeat; r++)
+  {
+    ULO snapshot = 0;
+    for (i = 0; i < blitreplay_record_count; i++)
+    {
+      blitter_trace_record *record = &blitreplay_records[i];
+      if (record->chipmem_snapshot != snapshot)
+      {
+	/* Restoring the chip memory is not part of the time */
+	elapsed += clock() - start;
+	snapshot = record->chipmem_snapshot;
+	blitreplayRestoreSnapshot(snapshot);
+	start = clock();
+      }
+      blitterOperationReplay(record);
+      words += blitreplayBlitWords(record);
+    }
+  }
+  elapsed += clock() - start;
+  blitterShutdown();
+
+  seconds = ((double) elapsed)/CLOCKS_PER_SEC;
+  if (seconds <= 0.0) seconds = 1.0/CLOCKS_PER_SEC;
+  printf("%u blits, %u snapshots, %u passes in %.3f seconds\n", blitreplay_record_count, blitreplay_snapshot_count, repeat, seconds);
+  printf("%.0f blits per second\n", (((double) blitreplay_record_count)*repeat)/seconds);
+  printf("%.0f bytes per second\n", (((double) words)*2.0)/seconds);
+  return 0;
+}
@@ -0,0 +1,331 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* Bus event queue benchmark, replays an event queue trace (busevents.trc) */
+/* through the sorted list in C/BusEventQueue.c and through an indexed     */
+/* binary min-heap, checks that both pop the events in the recorded order  */
+/* and reports how fast they ran.                                          */
+/*                                                                         */
+/* The trace is recorded by an emulator built with BUS_EVENT_TRACE. This   */
+/* program links with C/BusEventQueue.c and stubs out the rest of the      */
+/* emulator. The heap below orders events with equal cycle by insertion,   */
+/* like the list.                                                          */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "fellow.h"
+#include "bus.h"
+
+#define BUSREPLAY_EVENTS (BUS_EVENT_TRACE_INTERRUPT + 1)
+
+/*=========================================================================*/
+/* The parts of the emulator the event queue uses                          */
+/*=========================================================================*/
+
+bus_state bus;
+bus_event cpuEvent;
+bus_event copperEvent;
+bus_event eolEvent;
+bus_event eofEvent;
+bus_event ciaEvent;
+bus_event blitterEvent;
+bus_event interruptEvent;
+
+static bus_event *busreplay_events[BUSREPLAY_EVENTS] = {NULL, &cpuEvent, &copperEvent, &eolEvent, &eofEvent, &ciaEvent, &blitterEvent, &interruptEvent};
+
+/*=========================================================================*/
+/* Trace loading                                                           */
+/*=========================================================================*/
+
+bus_event_trace_record *busreplay_records;
+ULO busreplay_record_count;
+
+static BOOLE busreplayReadULO(FILE *F, ULO *data)
+{
+  return fread(data, sizeof(ULO), 1, F) == 1;
+}
+
+static BOOLE busreplayLoadTrace(char *filename)
+{
+  FILE *F = fopen(filename, "rb");
+  ULO magic, version;
+  ULO record_capacity = 0;
+
+  if (F == NULL)
+  {
+    fprintf(stderr, "Can't open %s\n", filename);
+    return FALSE;
+  }
+  if (!busreplayReadULO(F, &magic) || !busreplayReadULO(F, &version) || magic != BUS_EVENT_TRACE_MAGIC || version != BUS_EVENT_TRACE_VERSION)
+  {
+    fprintf(stderr, "%s is not a version %u bus event trace\n", filename, BUS_EVENT_TRACE_VERSION);
+    fclose(F);
+    return FALSE;
+  }
+  for (;;)
+  {
+    bus_event_trace_record *record;
+
+    if (busreplay_record_count == record_capacity)
+    {
+      record_capacity = (record_capacity == 0) ? 65536 : 2*record_capacity;
+      busreplay_records = (bus_event_trace_record *) realloc(busreplay_records, sizeof(bus_event_trace_record)*record_capacity);
+    }
+    record = &busreplay_records[busreplay_record_count];
+    if (fread(record, sizeof(bus_event_trace_record), 1, F) != 1) break;
+    if (record->operation > BUS_EVENT_TRACE_POP) break;
+    if (record->operation != BUS_EVENT_TRACE_SESSION && (record->event == 0 || record->event >= BUSREPLAY_EVENTS)) break;
+    busreplay_record_count++;
+  }
+  if (!feof(F))
+  {
+    fprintf(stderr, "%s is damaged, using the first %u records\n", filename, busreplay_record_count);
+  }
+  fclose(F);
+  return TRUE;
+}
+
+/*=========================================================================*/
+/* Replay through the list                                                 */
+/* Returns the number of pops that did not return the recorded event       */
+/*=========================================================================*/
+
+static ULO busreplayList(void)
+{
+  ULO errors = 0;
+
+  busClearQueue();
+  for (ULO i = 0; i < busreplay_record_count; i++)
+  {
+    bus_event_trace_record *record = &busreplay_records[i];
+    bus_event *ev = busreplay_events[record->event];
+
+    switch (record->operation)
+    {
+      case BUS_EVENT_TRACE_SESSION:
+	busClearQueue();
+	break;
+      case BUS_EVENT_TRACE_INSERT:
+	ev->cycle = record->cycle;
+	busInsertEvent(ev);
+	break;
+      case BUS_EVENT_TRACE_REMOVE:
+	busRemoveEvent(ev);
+	break;
+      case BUS_EVENT_TRACE_POP:
+	if (bus.events == NULL || busPopEvent() != ev) errors++;
+	break;
+    }
+  }
+  return errors;
+}
+
+/*=========================================================================*/
+/* Replay through the heap                                                 */
+/* The heap is stored 1-based in busreplay_heap, every event remembers its */
+/* position in it, 0 when it is not queued.                                */
+/*=========================================================================*/
+
+typedef struct busreplay_heap_event_
+{
+  ULO cycle;
+  ULL order;
+  ULO position;
+} busreplay_heap_event;
+
+static busreplay_heap_event busreplay_heap_events[BUSREPLAY_EVENTS];
+static busreplay_heap_event *busreplay_heap[BUSREPLAY_EVENTS + 1];
+static ULO busreplay_heap_count;
+static ULL busreplay_heap_order;
+
+static BOOLE busreplayHeapIsBefore(busreplay_heap_event *a, busreplay_heap_event *b)
+{
+  if (a->cycle != b->cycle)
+  {
+    return a->cycle < b->cycle;
+  }
+  return a->order < b->order;
+}
+
+static void busreplayHeapPlace(busreplay_heap_event *ev, ULO position)
+{
+  busreplay_heap[position] = ev;
+  ev->position = position;
+}
+
+static void busreplayHeapSiftUp(ULO position)
+{
+  busreplay_heap_event *ev = busreplay_heap[position];
+  while (position > 1)
+  {
+    ULO parent = position >> 1;
+    if (!busreplayHeapIsBefore(ev, busreplay_heap[parent]))
+    {
+      break;
+    }
+    busreplayHeapPlace(busreplay_heap[parent], position);
+    position = parent;
+  }
+  busreplayHeapPlace(ev, position);
+}
+
+static void busreplayHeapSiftDown(ULO position)
+{
+  busreplay_heap_event *ev = busreplay_heap[position];
+  for (;;)
+  {
+    ULO child = position << 1;
+    if (child > busreplay_heap_count)
+    {
+      break;
+    }
+    if (child < busreplay_heap_count && busreplayHeapIsBefore(busreplay_heap[child + 1], busreplay_heap[child]))
+    {
+      child++;
+    }
+    if (!busreplayHeapIsBefore(busreplay_heap[child], ev))
+    {
+      break;
+    }
+    busreplayHeapPlace(busreplay_heap[child], position);
+    position = child;
+  }
+  busreplayHeapPlace(ev, position);
+}
+
+static void busreplayHeapRemove(busreplay_heap_event *ev)
+{
+  ULO position = ev->position;
+  if (position == 0)
+  {
+    return;
+  }
+
+  busreplay_heap_event *last = busreplay_heap[busreplay_heap_count--];
+  ev->position = 0;
+  if (last == ev)
+  {
+    return;
+  }
+
+  busreplayHeapPlace(last, position);
+  if (position > 1 && busreplayHeapIsBefore(last, busreplay_heap[position >> 1]))
+  {
+    busreplayHeapSiftUp(position);
+  }
+  else
+  {
+    busreplayHeapSiftDown(position);
+  }
+}
+
+static void busreplayHeapInsert(busreplay_heap_event *ev)
+{
+  busreplayHeapRemove(ev);
+  ev->order = busreplay_heap_order++;
+  busreplayHeapPlace(ev, ++busreplay_heap_count);
+  busreplayHeapSiftUp(busreplay_heap_count);
+}
+
+static busreplay_heap_event *busreplayHeapPop(void)
+{
+  busreplay_heap_event *tmp = busreplay_heap[1];
+  busreplay_heap_event *last = busreplay_heap[busreplay_heap_count--];
+  tmp->position = 0;
+  if (last != tmp)
+  {
+    busreplayHeapPlace(last, 1);
+    busreplayHeapSiftDown(1);
+  }
+  return tmp;
+}
+
+static ULO busreplayHeap(void)
+{
+  ULO errors = 0;
+
+  memset(busreplay_heap_events, 0, sizeof(busreplay_heap_events));
+  busreplay_heap_count = 0;
+  for (ULO i = 0; i < busreplay_record_count; i++)
+  {
+    bus_event_trace_record *record = &busreplay_records[i];
+    busreplay_heap_event *ev = &busreplay_heap_events[record->event];
+
+    switch (record->operation)
+    {
+      case BUS_EVENT_TRACE_SESSION:
+	memset(busreplay_heap_events, 0, sizeof(busreplay_heap_events));
+	busreplay_heap_count = 0;
+	break;
+      case BUS_EVENT_TRACE_INSERT:
+	ev->cycle = record->cycle;
+	busreplayHeapInsert(ev);
+	break;
+      case BUS_EVENT_TRACE_REMOVE:
+	busreplayHeapRemove(ev);
+	break;
+      case BUS_EVENT_TRACE_POP:
+	if (busreplay_heap_count == 0 || busreplayHeapPop() != ev) errors++;
+	break;
+    }
+  }
+  return errors;
+}
+
+/*=========================================================================*/
+/* Benchmark                                                               */
+/*=========================================================================*/
+
+typedef ULO (*busreplayFunc)(void);
+
+static ULO busreplayRun(const char *name, busreplayFunc replay, ULO repeat)
+{
+  ULO errors = 0;
+  clock_t start, stop;
+  double seconds;
+
+  start = clock();
+  for (ULO r = 0; r < repeat; r++)
+  {
+    errors += replay();
+  }
+  stop = clock();
+
+  seconds = ((double) (stop - start))/CLOCKS_PER_SEC;
+  if (seconds <= 0.0) seconds = 1.0/CLOCKS_PER_SEC;
+  printf("%-5s %u passes in %.3f seconds, %.0f operations per second, %u pops out of order\n",
+    name, repeat, seconds, (((double) busreplay_record_count)*repeat)/seconds, errors/repeat);
+  return errors;
+}
+
+int main(int argc, char *argv[])
+{
+  ULO repeat = 1;
+  ULO errors;
+
+  if (argc < 2)
+  {
+    printf("Usage: busreplay <busevents.trc> [repeat count]\n");
+    return 1;
+  }
+  if (argc >= 3) repeat = atoi(argv[2]);
+  if (repeat == 0) repeat = 1;
+  if (!busreplayLoadTrace(argv[1])) return 1;
+  if (busreplay_record_count == 0)
+  {
+    printf("No events in %s\n", argv[1]);
+    return 0;
+  }
+
+  printf("%u queue operations\n", busreplay_record_count);
+  errors = busreplayRun("list", busreplayList, repeat);
+  errors += busreplayRun("heap", busreplayHeap, repeat);
+  return (errors == 0) ? 0 : 1;
+}
@@ -31,9 +31,9 @@
 
 #include "Graphics.h"
 
-static STR *BPLDMA_StateNames[3] = {"NONE",
-				    "FETCH_LORES",
-				    "FETCH_HIRES"};
+static const STR *BPLDMA_StateNames[3] = {"NONE",
+					  "FETCH_LORES",
+					  "FETCH_HIRES"};
 
 void BitplaneDMA::Log(ULO line, ULO cylinder)
 {
@@ -120,7 +120,7 @@ void BitplaneDMA::Start(ULO arriveTime)
 // Called from within the state machine
 void BitplaneDMA::Restart(bool ddfIsActive)
 {
-  if (ddfIsActive || !ddfIsActive && _stopDDF && BitplaneUtility::IsHires())
+  if (ddfIsActive || (!ddfIsActive && _stopDDF && BitplaneUtility::IsHires()))
   {
     _stopDDF = false;
     ULO startOfNextFetchUnit = _arriveTime + 1;
@@ -179,6 +179,8 @@ void BitplaneDMA::Handler(ULO rasterY, ULO cylinder)
       case BPL_DMA_STATE_FETCH_HIRES:
 	FetchHires();
 	break;
+      case BPL_DMA_STATE_NONE:
+	break;
     }
     Restart(GraphicsContext.DDFStateMachine.CanRead());
   }
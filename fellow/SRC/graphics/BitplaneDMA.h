@@ -57,13 +57,15 @@ private:
 public:
   void Start(ULO cycle);
   void Stop(void);
+  // A pending stop is part of the state, it decides whether the next unit is fetched
+  ULO GetState(void) {return _state | (_stopDDF ? 0x100 : 0);}
 
   virtual void InitializeEvent(GraphicsEventQueue *queue);
   virtual void Handler(ULO rasterY, ULO cylinder);
 
   void EndOfFrame(void);
 
-  BitplaneDMA(void) : GraphicsEvent(), _stopDDF(false), _state(BPL_DMA_STATE_NONE) {};
+  BitplaneDMA(void) : GraphicsEvent(), _state(BPL_DMA_STATE_NONE), _stopDDF(false) {};
 
 };
 
@@ -201,8 +201,8 @@ void BitplaneDraw::TmpFrame(ULO next_line_offset)
 {
   ULO real_pitch_in_bytes = next_line_offset/2;
 
-  ULO *draw_buffer_first_ptr_local = (ULO *) draw_buffer_info.current_ptr;
-  ULO *draw_buffer_second_ptr_local = (ULO *) (draw_buffer_info.current_ptr + real_pitch_in_bytes);
+  ULO *draw_buffer_first_ptr_local = (ULO *) draw_buffer_current_ptr;
+  ULO *draw_buffer_second_ptr_local = (ULO *) (draw_buffer_current_ptr + real_pitch_in_bytes);
 
   ULO startx = drawGetInternalClip().left*2;
   ULO stopx = drawGetInternalClip().right*2;
@@ -80,7 +80,7 @@ void CycleExactCopper::Move()
 
 void CycleExactCopper::Wait()
 {
-  bool blitter_finish_disable = (_second & 0x8000) == 0x8000;
+  // Bit 15 of the second word, blitter finish disable, is not emulated
   ULO ve = (((ULO) _second >> 8) & 0x7f) | 0x80;
   ULO he = (ULO) _second & 0xfe;
 
@@ -237,6 +237,8 @@ void CycleExactCopper::EventHandler()
     case COPPER_STATE_TRANSFER_SECOND_WORD:
       TransferSecondWord();
       break;
+    case COPPER_STATE_NONE:
+      break;
   }
 }
 
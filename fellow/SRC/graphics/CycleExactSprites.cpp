@@ -324,6 +324,8 @@ void CycleExactSprites::DMAHandler(ULO rasterY)
       case SPRITE_DMA_STATE_READ_DATA:
 	DMAReadData(spriteNo, rasterY);
   	break;
+      case SPRITE_DMA_STATE_DISABLED:
+	break;
     }
     spriteNo++;
   }
@@ -366,6 +368,15 @@ void CycleExactSprites::EmulationStop()
 {
 }
 
+// States are not saved or loaded in the cycle exact mode, see fellowStateIsSupported()
+void CycleExactSprites::SaveState(savestate *S)
+{
+}
+
+void CycleExactSprites::LoadState(savestate *S)
+{
+}
+
 CycleExactSprites::CycleExactSprites()
   : Sprites()
 {
@@ -107,6 +107,9 @@ public:
   virtual void EmulationStart();
   virtual void EmulationStop();
 
+  virtual void SaveState(savestate *S);
+  virtual void LoadState(savestate *S);
+
   CycleExactSprites();
   virtual ~CycleExactSprites();
 };
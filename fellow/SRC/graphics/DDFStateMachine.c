@@ -29,8 +29,8 @@
 
 #include "Graphics.h"
 
-static STR *DDFStateNames[2] = {"WAITING_FOR_FIRST_FETCH",
-				"WAITING_FOR_NEXT_FETCH"};
+static const STR *DDFStateNames[2] = {"WAITING_FOR_FIRST_FETCH",
+				      "WAITING_FOR_NEXT_FETCH"};
 
 void DDFStateMachine::Log(ULO line, ULO cylinder)
 {
@@ -53,6 +53,7 @@ private:
 
 public:
   bool CanRead(void);
+  ULO GetState(void) {return _state;}
   void ChangedValue(void);
 
   virtual void InitializeEvent(GraphicsEventQueue *queue);
@@ -26,8 +26,8 @@
 
 #include "Graphics.h"
 
-static STR *DIWXStateNames[2] = {"WAITING_FOR_START_POS",
-				 "WAITING_FOR_STOP_POS"};
+static const STR *DIWXStateNames[2] = {"WAITING_FOR_START_POS",
+				       "WAITING_FOR_STOP_POS"};
 
 void DIWXStateMachine::Log(ULO line, ULO cylinder)
 {
@@ -54,6 +54,7 @@ private:
 public:
   //UBY GetOutputMask(ULO rasterX);
   bool IsVisible(void);
+  ULO GetState(void) {return _state;}
   void ChangedValue(void);
 
   virtual void InitializeEvent(GraphicsEventQueue *queue);
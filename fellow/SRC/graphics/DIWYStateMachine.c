@@ -29,8 +29,8 @@
 
 #include "Graphics.h"
 
-static STR *DIWYStateNames[2] = {"WAITING_FOR_START_LINE",
-				 "WAITING_FOR_STOP_LINE"};
+static const STR *DIWYStateNames[2] = {"WAITING_FOR_START_LINE",
+				       "WAITING_FOR_STOP_LINE"};
 
 void DIWYStateMachine::Log(ULO line, ULO cylinder)
 {
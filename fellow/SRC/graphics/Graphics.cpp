@@ -4,6 +4,11 @@
 
 Graphics GraphicsContext;
 
+void Graphics::SetUseLineSchedule(bool useLineSchedule)
+{
+  _queue.SetUseSchedule(useLineSchedule);
+}
+
 void Graphics::Commit(ULO untilRasterY, ULO untilRasterX)
 {
   if (GraphicsContext.Logger.IsLogEnabled())
@@ -11,11 +16,28 @@ void Graphics::Commit(ULO untilRasterY, ULO untilRasterX)
     GraphicsContext.Logger.Log(untilRasterY, untilRasterX*2+1, "Commit:\n-------------------------\n"); 
   }
   _queue.Run(untilRasterY*GraphicsEventQueue::GetCylindersPerLine() + untilRasterX*2 + 1);
+  PixelSerializer.OutputCylindersUntil(untilRasterY, untilRasterX*2 + 1);
+}
+
+// For writes that change what is fetched next, but not the pixels already fetched.
+// The fetches up to the position are done, the pixels are serialized later in one batch.
+void Graphics::CommitEvents(ULO untilRasterY, ULO untilRasterX)
+{
+  if (GraphicsContext.Logger.IsLogEnabled())
+  {
+    GraphicsContext.Logger.Log(untilRasterY, untilRasterX*2+1, "Commit events:\n-------------------------\n"); 
+  }
+  _queue.Run(untilRasterY*GraphicsEventQueue::GetCylindersPerLine() + untilRasterX*2 + 1);
 }
 
 void Graphics::InitializeEventQueue(void)
 {
   _queue.Clear();
+  _queue.Register(&DIWXStateMachine, GRAPHICS_ACTION_DIWX);
+  _queue.Register(&DIWYStateMachine, GRAPHICS_ACTION_DIWY);
+  _queue.Register(&DDFStateMachine, GRAPHICS_ACTION_DDF);
+  _queue.Register(&BitplaneDMA, GRAPHICS_ACTION_BITPLANE_DMA);
+  _queue.Register(&PixelSerializer, GRAPHICS_ACTION_PIXEL_SERIALIZER);
 
   DIWXStateMachine.InitializeEvent(&_queue);
   DIWYStateMachine.InitializeEvent(&_queue);
@@ -71,6 +93,7 @@ void Graphics::Startup(void)
   DIWYStateMachine.Startup();
   DDFStateMachine.Startup();
   PixelSerializer.Startup();
+  Planar2ChunkyDecoder.Startup();
 
   InitializeEventQueue();
 }
@@ -27,16 +27,21 @@ private:
   void InitializePixelSerializerEvent(void);
 
 public:
-  DIWXStateMachine DIWXStateMachine;
-  DIWYStateMachine DIWYStateMachine;
-  DDFStateMachine DDFStateMachine;
-  BitplaneDMA BitplaneDMA;
-  PixelSerializer PixelSerializer;
-  Planar2ChunkyDecoder Planar2ChunkyDecoder;
-  BitplaneDraw BitplaneDraw;
-  Logger Logger;
+  // The members have the names of their classes, qualified so that the
+  // class names keep their meaning in the class scope
+  ::DIWXStateMachine DIWXStateMachine;
+  ::DIWYStateMachine DIWYStateMachine;
+  ::DDFStateMachine DDFStateMachine;
+  ::BitplaneDMA BitplaneDMA;
+  ::PixelSerializer PixelSerializer;
+  ::Planar2ChunkyDecoder Planar2ChunkyDecoder;
+  ::BitplaneDraw BitplaneDraw;
+  ::Logger Logger;
+
+  void SetUseLineSchedule(bool useLineSchedule);
 
   void Commit(ULO untilRasterY, ULO untilRasterX);
+  void CommitEvents(ULO untilRasterY, ULO untilRasterX);
 
   void EndOfFrame(void);
   void SoftReset(void);
@@ -8,9 +8,11 @@ ULO GraphicsEvent::MakeArriveTime(ULO rasterY, ULO cylinder)
 }
 
 GraphicsEvent::GraphicsEvent(void)
-  : _arriveTime(GraphicsEventQueue::GRAPHICS_ARRIVE_TIME_NONE),
-    _next(0),
+  : _next(0),
     _prev(0),
-    _priority(0)
+    _arriveTime(GraphicsEventQueue::GRAPHICS_ARRIVE_TIME_NONE),
+    _priority(0),
+    _sequence(0),
+    _action(GRAPHICS_ACTION_COUNT)
 {
 }
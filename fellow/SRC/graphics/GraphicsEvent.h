@@ -3,6 +3,7 @@
 
 #include "DEFS.H"
 #include "BUS.H"
+#include "GraphicsLineSchedule.h"
 
 class GraphicsEventQueue;
 
@@ -14,6 +15,8 @@ public:
   GraphicsEvent *_prev;
   ULO _arriveTime;
   ULO _priority;
+  ULL _sequence;
+  GraphicsLineScheduleActions _action;
 
   ULO MakeArriveTime(ULO rasterY, ULO cylinder);
 
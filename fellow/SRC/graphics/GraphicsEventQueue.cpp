@@ -3,24 +3,49 @@
 #include "Graphics.h"
 #include "BUS.H"
 
+// The events are kept in a list sorted by arrive time. Events on the same
+// cylinder run in priority order, and then in the order they were inserted.
+//
+// Most lines run the same events on the same cylinders as the line before. The
+// events of a line are recorded in a line schedule, which is replayed for the
+// following lines for as long as they start with the same register values and
+// event states. While it is replayed the handlers only update their own state,
+// and the list is rebuilt from it when the queue takes over again.
+
 void GraphicsEventQueue::Clear(void)
 {
-  _events = 0;
+  while (_events != 0)
+  {
+    Unlink(_events);
+  }
+  for (ULO i = 0; i < GRAPHICS_ACTION_COUNT; ++i)
+  {
+    _actionEvents[i] = 0;
+  }
+  _nextSequence = 0;
+  _schedule.Clear();
+  _scheduleMode = GRAPHICS_SCHEDULE_NONE;
+  _inHandler = false;
+  _leaveSchedule = false;
 }
 
-void GraphicsEventQueue::Remove(GraphicsEvent *graphics_event)
+// Without the line schedule every line runs the list, to compare the two
+void GraphicsEventQueue::SetUseSchedule(bool useSchedule)
 {
-  bool found = false;
-  for (GraphicsEvent *tmp = _events; tmp != 0; tmp = tmp->_next)
-  {
-    if (tmp == graphics_event)
-    {
-      found = true;
-      break;
-    }
-  }
-  if (!found)
+  _useSchedule = useSchedule;
+}
+
+void GraphicsEventQueue::Register(GraphicsEvent *graphics_event, GraphicsLineScheduleActions action)
+{
+  graphics_event->_action = action;
+  _actionEvents[action] = graphics_event;
+}
+
+void GraphicsEventQueue::Unlink(GraphicsEvent *graphics_event)
+{
+  if (graphics_event->_prev == 0 && _events != graphics_event)
   {
+    // Not in the list
     return;
   }
 
@@ -39,7 +64,7 @@ void GraphicsEventQueue::Remove(GraphicsEvent *graphics_event)
   graphics_event->_prev = graphics_event->_next = 0;
 }
 
-void GraphicsEventQueue::Insert(GraphicsEvent *graphics_event)
+void GraphicsEventQueue::Link(GraphicsEvent *graphics_event)
 {
   if (_events == 0)
   {
@@ -76,6 +101,107 @@ void GraphicsEventQueue::Insert(GraphicsEvent *graphics_event)
   }
 }
 
+// Rebuilds the list from the arrive times the handlers kept while the line schedule ran.
+// Linking in insertion order puts events on the same cylinder back in the same order.
+void GraphicsEventQueue::Relink(void)
+{
+  GraphicsEvent *events[GRAPHICS_ACTION_COUNT];
+  ULO count = 0;
+
+  _events = 0;
+  for (ULO i = 0; i < GRAPHICS_ACTION_COUNT; ++i)
+  {
+    GraphicsEvent *graphics_event = _actionEvents[i];
+    graphics_event->_prev = graphics_event->_next = 0;
+    if (graphics_event->_arriveTime != GRAPHICS_ARRIVE_TIME_NONE)
+    {
+      ULO j = count++;
+      for (; j > 0 && events[j - 1]->_sequence > graphics_event->_sequence; --j)
+      {
+        events[j] = events[j - 1];
+      }
+      events[j] = graphics_event;
+    }
+  }
+  for (ULO i = 0; i < count; ++i)
+  {
+    Link(events[i]);
+  }
+}
+
+void GraphicsEventQueue::LeaveSchedule(void)
+{
+  Relink();
+  _scheduleMode = GRAPHICS_SCHEDULE_NONE;
+  _leaveSchedule = false;
+}
+
+// True when the rest of the line schedule runs the event at its new arrive time,
+// or the event arrives after the line. Otherwise only the list runs it on time.
+bool GraphicsEventQueue::IsInSchedule(GraphicsEvent *graphics_event)
+{
+  ULO entryCount = _schedule.GetEntryCount();
+  for (ULO i = _nextEntry; i < entryCount; ++i)
+  {
+    const GraphicsLineScheduleEntry& entry = _schedule.GetEntry(i);
+    if (entry.action == graphics_event->_action)
+    {
+      return graphics_event->_arriveTime == _lineStart + entry.cylinder;
+    }
+  }
+  return graphics_event->_arriveTime >= _lineStart + GetCylindersPerLine();
+}
+
+// An event is moved from outside a handler, a register write or a reset.
+// The line that is running can no longer be recorded or replayed.
+void GraphicsEventQueue::ChangedFromOutside(void)
+{
+  if (_scheduleMode == GRAPHICS_SCHEDULE_REPLAYING)
+  {
+    LeaveSchedule();
+  }
+  _scheduleMode = GRAPHICS_SCHEDULE_NONE;
+}
+
+void GraphicsEventQueue::Remove(GraphicsEvent *graphics_event)
+{
+  if (_inHandler)
+  {
+    if (_scheduleMode == GRAPHICS_SCHEDULE_REPLAYING)
+    {
+      return;
+    }
+  }
+  else
+  {
+    ChangedFromOutside();
+  }
+  Unlink(graphics_event);
+}
+
+void GraphicsEventQueue::Insert(GraphicsEvent *graphics_event)
+{
+  graphics_event->_sequence = _nextSequence++;
+  if (_inHandler)
+  {
+    if (_scheduleMode == GRAPHICS_SCHEDULE_REPLAYING)
+    {
+      if (!IsInSchedule(graphics_event))
+      {
+        // The recorded line had no event there, the list takes over after the handler
+        _leaveSchedule = true;
+      }
+      return;
+    }
+  }
+  else
+  {
+    ChangedFromOutside();
+    Unlink(graphics_event);
+  }
+  Link(graphics_event);
+}
+
 GraphicsEvent *GraphicsEventQueue::Pop(void)
 {
   GraphicsEvent *tmp = _events;
@@ -87,13 +213,170 @@ GraphicsEvent *GraphicsEventQueue::Pop(void)
   return tmp;
 }
 
-void GraphicsEventQueue::Run(ULO untilTime)
+// Called at the start of line _lineY, decides how the line is run
+bool GraphicsEventQueue::StartLine(void)
+{
+  GraphicsLineScheduleKey key;
+
+  if (!_useSchedule || _lineY < FIRST_SCHEDULED_LINE || _lineY >= busGetLinesInThisFrame()
+    || !GraphicsLineSchedule::MakeKey(&key, _actionEvents, _lineStart))
+  {
+    _scheduleMode = GRAPHICS_SCHEDULE_WAITING;
+    _lineY++;
+    _lineStart = _lineY*GetCylindersPerLine();
+    return false;
+  }
+
+  if (_schedule.IsScheduleFor(&key))
+  {
+    _scheduleMode = GRAPHICS_SCHEDULE_REPLAYING;
+    _nextEntry = 0;
+    return true;
+  }
+
+  _schedule.Begin(&key);
+  _scheduleMode = GRAPHICS_SCHEDULE_RECORDING;
+  return false;
+}
+
+// Calls the handler of an event directly, without going through the virtual Handler
+void GraphicsEventQueue::RunHandler(GraphicsLineScheduleActions action, ULO rasterY, ULO cylinder)
+{
+  _inHandler = true;
+  switch (action)
+  {
+    case GRAPHICS_ACTION_DIWX:
+      GraphicsContext.DIWXStateMachine.DIWXStateMachine::Handler(rasterY, cylinder);
+      break;
+    case GRAPHICS_ACTION_DIWY:
+      GraphicsContext.DIWYStateMachine.DIWYStateMachine::Handler(rasterY, cylinder);
+      break;
+    case GRAPHICS_ACTION_DDF:
+      GraphicsContext.DDFStateMachine.DDFStateMachine::Handler(rasterY, cylinder);
+      break;
+    case GRAPHICS_ACTION_BITPLANE_DMA:
+      GraphicsContext.BitplaneDMA.BitplaneDMA::Handler(rasterY, cylinder);
+      break;
+    case GRAPHICS_ACTION_PIXEL_SERIALIZER:
+      GraphicsContext.PixelSerializer.PixelSerializer::Handler(rasterY, cylinder);
+      break;
+    default: // GRAPHICS_ACTION_COUNT, an event that was never registered
+      break;
+  }
+  _inHandler = false;
+}
+
+// Runs the sorted list, and records the line schedule on the way.
+// Returns false when the line schedule takes over before untilTime.
+bool GraphicsEventQueue::RunQueue(ULO untilTime)
 {
-  while (_events->_arriveTime <= untilTime)
+  ULO cylindersPerLine = GetCylindersPerLine();
+
+  if (_scheduleMode == GRAPHICS_SCHEDULE_RECORDING && !_schedule.HasSameRegisters())
   {
+    // A register was written during the line, the line is not like the next one
+    _scheduleMode = GRAPHICS_SCHEDULE_NONE;
+  }
+  if (_scheduleMode == GRAPHICS_SCHEDULE_NONE)
+  {
+    _lineY = untilTime/cylindersPerLine + 1;
+    _lineStart = _lineY*cylindersPerLine;
+    _scheduleMode = GRAPHICS_SCHEDULE_WAITING;
+  }
+
+  for (;;)
+  {
+    ULO lineEnd = (_scheduleMode == GRAPHICS_SCHEDULE_WAITING) ? _lineStart : (_lineStart + cylindersPerLine);
+    if (lineEnd <= untilTime && lineEnd <= _events->_arriveTime)
+    {
+      if (_scheduleMode == GRAPHICS_SCHEDULE_RECORDING)
+      {
+        _schedule.Complete();
+        _lineY++;
+        _lineStart = _lineY*cylindersPerLine;
+      }
+      if (StartLine())
+      {
+        return false;
+      }
+      continue;
+    }
+    if (_events->_arriveTime > untilTime)
+    {
+      return true;
+    }
+
     GraphicsEvent *graphics_event = Pop();
     ULO arrive_time = graphics_event->_arriveTime;
-    graphics_event->Handler(arrive_time / GetCylindersPerLine(), arrive_time % GetCylindersPerLine());
+    if (_scheduleMode == GRAPHICS_SCHEDULE_RECORDING
+      && (arrive_time < _lineStart || !_schedule.Add(arrive_time - _lineStart, graphics_event->_action)))
+    {
+      _scheduleMode = GRAPHICS_SCHEDULE_WAITING;
+      _lineY++;
+      _lineStart = _lineY*cylindersPerLine;
+    }
+    _inHandler = true;
+    graphics_event->Handler(arrive_time / cylindersPerLine, arrive_time % cylindersPerLine);
+    _inHandler = false;
+  }
+}
+
+// Runs the recorded line schedule for as long as the lines match it.
+// Returns false when the list must take over before untilTime.
+bool GraphicsEventQueue::RunSchedule(ULO untilTime)
+{
+  if (!_schedule.HasSameRegisters())
+  {
+    LeaveSchedule();
+    return false;
+  }
+
+  for (;;)
+  {
+    ULO entryCount = _schedule.GetEntryCount();
+    while (_nextEntry < entryCount)
+    {
+      const GraphicsLineScheduleEntry& entry = _schedule.GetEntry(_nextEntry);
+      ULO arrive_time = _lineStart + entry.cylinder;
+      if (arrive_time > untilTime)
+      {
+        return true;
+      }
+      if (_actionEvents[entry.action]->_arriveTime != arrive_time)
+      {
+        // The line went differently than the one recorded, let the list sort it out
+        LeaveSchedule();
+        return false;
+      }
+      _nextEntry++;
+      RunHandler(entry.action, _lineY, entry.cylinder);
+      if (_leaveSchedule)
+      {
+        LeaveSchedule();
+        return false;
+      }
+    }
+
+    ULO cylindersPerLine = GetCylindersPerLine();
+    if (untilTime < _lineStart + cylindersPerLine)
+    {
+      return true;
+    }
+    _lineY++;
+    _lineStart = _lineY*cylindersPerLine;
+    if (!StartLine())
+    {
+      Relink();
+      return false;
+    }
   }
-  GraphicsContext.PixelSerializer.OutputCylindersUntil(untilTime / GetCylindersPerLine(), untilTime % GetCylindersPerLine());
+}
+
+void GraphicsEventQueue::Run(ULO untilTime)
+{
+  bool reachedUntilTime;
+  do
+  {
+    reachedUntilTime = (_scheduleMode == GRAPHICS_SCHEDULE_REPLAYING) ? RunSchedule(untilTime) : RunQueue(untilTime);
+  } while (!reachedUntilTime);
 }
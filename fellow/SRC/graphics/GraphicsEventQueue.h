@@ -3,13 +3,45 @@
 
 #include "DEFS.H"
 #include "GraphicsEvent.h"
+#include "GraphicsLineSchedule.h"
+
+typedef enum GraphicsScheduleModes_
+{
+  GRAPHICS_SCHEDULE_NONE = 0,        // Line position not known, set on the next run
+  GRAPHICS_SCHEDULE_WAITING = 1,     // Queue runs until the start of the next line
+  GRAPHICS_SCHEDULE_RECORDING = 2,   // Queue runs and the line schedule is recorded
+  GRAPHICS_SCHEDULE_REPLAYING = 3    // Line schedule runs, the queue list is not kept
+} GraphicsScheduleModes;
 
 class GraphicsEventQueue
 {
 private:
+  // The pixel serializer treats the lines before this, and the last line of the frame, differently
+  const static ULO FIRST_SCHEDULED_LINE = 0x1b;
+
   GraphicsEvent *_events;
+  GraphicsEvent *_actionEvents[GRAPHICS_ACTION_COUNT];
+  ULL _nextSequence;
 
-  void RunQueue(ULO untilTime);
+  GraphicsLineSchedule _schedule;
+  GraphicsScheduleModes _scheduleMode;
+  ULO _lineY;
+  ULO _lineStart;
+  ULO _nextEntry;
+  bool _inHandler;
+  bool _leaveSchedule;
+  bool _useSchedule;
+
+  void Link(GraphicsEvent *graphics_event);
+  void Unlink(GraphicsEvent *graphics_event);
+  void Relink(void);
+  void ChangedFromOutside(void);
+  void LeaveSchedule(void);
+  bool StartLine(void);
+  bool IsInSchedule(GraphicsEvent *graphics_event);
+  void RunHandler(GraphicsLineScheduleActions action, ULO rasterY, ULO cylinder);
+  bool RunQueue(ULO untilTime);
+  bool RunSchedule(ULO untilTime);
 
 public:
   const static ULO GRAPHICS_ARRIVE_TIME_NONE = 0xffffffff;
@@ -17,11 +49,16 @@ public:
   static ULO GetCylindersPerLine() {return busGetCyclesInThisLine()*2;}
 
   void Clear(void);
+  void Register(GraphicsEvent *graphics_event, GraphicsLineScheduleActions action);
   GraphicsEvent* Pop(void);
   void Insert(GraphicsEvent *graphics_event);
   void Remove(GraphicsEvent *graphics_event);
 
   void Run(ULO untilTime);
+
+  void SetUseSchedule(bool useSchedule);
+
+  GraphicsEventQueue(void) : _useSchedule(true) {};
 };
 
 #endif
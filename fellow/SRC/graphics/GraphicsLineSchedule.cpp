@@ -0,0 +1,110 @@
+#include "DEFS.H"
+
+#include <string.h>
+
+#include "Graphics.h"
+#include "graph.h"
+
+void GraphicsLineSchedule::MakeRegisters(GraphicsLineScheduleRegisters *registers)
+{
+  registers->bplcon0 = bplcon0 & 0xf000;   // Resolution and bitplane count
+  registers->dmaconr = dmaconr & 0x0300;   // Bitplane DMA enable
+  registers->ddfstrt = ddfstrt;
+  registers->ddfstop = ddfstop;
+  registers->diwxleft = diwxleft;
+  registers->diwxright = diwxright;
+  registers->diwytop = diwytop;
+  registers->diwybottom = diwybottom;
+}
+
+// Fails when an event is overdue, the queue must run it before the line starts
+bool GraphicsLineSchedule::MakeKey(GraphicsLineScheduleKey *key, GraphicsEvent **events, ULO lineStart)
+{
+  ULO cylindersPerLine = GraphicsEventQueue::GetCylindersPerLine();
+
+  key->cylindersPerLine = cylindersPerLine;
+  MakeRegisters(&key->registers);
+  key->states[GRAPHICS_ACTION_DIWX] = GraphicsContext.DIWXStateMachine.GetState();
+  key->states[GRAPHICS_ACTION_DIWY] = GraphicsContext.DIWYStateMachine.GetState();
+  key->states[GRAPHICS_ACTION_DDF] = GraphicsContext.DDFStateMachine.GetState();
+  key->states[GRAPHICS_ACTION_BITPLANE_DMA] = GraphicsContext.BitplaneDMA.GetState();
+  key->states[GRAPHICS_ACTION_PIXEL_SERIALIZER] = 0;
+
+  for (ULO i = 0; i < GRAPHICS_ACTION_COUNT; ++i)
+  {
+    ULO arriveTime = events[i]->_arriveTime;
+    if (arriveTime == GraphicsEventQueue::GRAPHICS_ARRIVE_TIME_NONE || arriveTime >= lineStart + cylindersPerLine)
+    {
+      // Not seen on this line, when exactly does not matter
+      key->cylinders[i] = CYLINDER_LATER;
+    }
+    else if (arriveTime >= lineStart)
+    {
+      key->cylinders[i] = arriveTime - lineStart;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  // Events on the same cylinder with the same priority run in the order they were inserted
+  key->order = 0;
+  ULO bit = 1;
+  for (ULO i = 0; i < GRAPHICS_ACTION_COUNT; ++i)
+  {
+    for (ULO j = i + 1; j < GRAPHICS_ACTION_COUNT; ++j, bit <<= 1)
+    {
+      if (key->cylinders[i] != CYLINDER_LATER 
+        && key->cylinders[i] == key->cylinders[j] 
+        && events[i]->_priority == events[j]->_priority 
+        && events[i]->_sequence < events[j]->_sequence)
+      {
+        key->order |= bit;
+      }
+    }
+  }
+  return true;
+}
+
+bool GraphicsLineSchedule::HasSameRegisters(void)
+{
+  GraphicsLineScheduleRegisters registers;
+  MakeRegisters(&registers);
+  return memcmp(&registers, &_key.registers, sizeof(GraphicsLineScheduleRegisters)) == 0;
+}
+
+bool GraphicsLineSchedule::IsScheduleFor(const GraphicsLineScheduleKey *key)
+{
+  return _isComplete && memcmp(key, &_key, sizeof(GraphicsLineScheduleKey)) == 0;
+}
+
+void GraphicsLineSchedule::Begin(const GraphicsLineScheduleKey *key)
+{
+  _key = *key;
+  _entryCount = 0;
+  _isComplete = false;
+}
+
+bool GraphicsLineSchedule::Add(ULO cylinder, GraphicsLineScheduleActions action)
+{
+  if (_entryCount == MAX_ENTRIES)
+  {
+    return false;
+  }
+  _entries[_entryCount].cylinder = cylinder;
+  _entries[_entryCount].action = action;
+  _entryCount++;
+  return true;
+}
+
+void GraphicsLineSchedule::Complete(void)
+{
+  _isComplete = true;
+}
+
+void GraphicsLineSchedule::Clear(void)
+{
+  _entryCount = 0;
+  _isComplete = false;
+}
@@ -0,0 +1,81 @@
+#ifndef GRAPHICS_LINE_SCHEDULE_H
+#define GRAPHICS_LINE_SCHEDULE_H
+
+#include "DEFS.H"
+
+class GraphicsEvent;
+
+// One action for each event in the graphics context, in registration order
+typedef enum GraphicsLineScheduleActions_
+{
+  GRAPHICS_ACTION_DIWX = 0,
+  GRAPHICS_ACTION_DIWY = 1,
+  GRAPHICS_ACTION_DDF = 2,
+  GRAPHICS_ACTION_BITPLANE_DMA = 3,
+  GRAPHICS_ACTION_PIXEL_SERIALIZER = 4,
+  GRAPHICS_ACTION_COUNT = 5
+} GraphicsLineScheduleActions;
+
+typedef struct GraphicsLineScheduleEntry_
+{
+  ULO cylinder;
+  GraphicsLineScheduleActions action;
+} GraphicsLineScheduleEntry;
+
+// The register bits the event handlers base their timing on
+typedef struct GraphicsLineScheduleRegisters_
+{
+  ULO bplcon0;
+  ULO dmaconr;
+  ULO ddfstrt;
+  ULO ddfstop;
+  ULO diwxleft;
+  ULO diwxright;
+  ULO diwytop;
+  ULO diwybottom;
+} GraphicsLineScheduleRegisters;
+
+// Everything that decides which events run on a line, and when.
+// Two lines with the same key run the same events on the same cylinders.
+typedef struct GraphicsLineScheduleKey_
+{
+  ULO cylindersPerLine;
+  GraphicsLineScheduleRegisters registers;
+  ULO states[GRAPHICS_ACTION_COUNT];
+  ULO cylinders[GRAPHICS_ACTION_COUNT];
+  ULO order;
+} GraphicsLineScheduleKey;
+
+// The events of one line, recorded from the event queue the first time a line
+// with this key is run. Replaying it calls the same handlers without sorting
+// the queue or dispatching through the virtual Handler.
+class GraphicsLineSchedule
+{
+private:
+  const static ULO MAX_ENTRIES = 128;
+  const static ULO CYLINDER_LATER = 0xffffffff;
+
+  GraphicsLineScheduleEntry _entries[MAX_ENTRIES];
+  ULO _entryCount;
+  GraphicsLineScheduleKey _key;
+  bool _isComplete;
+
+  static void MakeRegisters(GraphicsLineScheduleRegisters *registers);
+
+public:
+  static bool MakeKey(GraphicsLineScheduleKey *key, GraphicsEvent **events, ULO lineStart);
+
+  bool HasSameRegisters(void);
+  bool IsScheduleFor(const GraphicsLineScheduleKey *key);
+  ULO GetEntryCount(void) {return _entryCount;}
+  const GraphicsLineScheduleEntry& GetEntry(ULO index) {return _entries[index];}
+
+  void Begin(const GraphicsLineScheduleKey *key);
+  bool Add(ULO cylinder, GraphicsLineScheduleActions action);
+  void Complete(void);
+  void Clear(void);
+
+  GraphicsLineSchedule(void) : _entryCount(0), _isComplete(false) {};
+};
+
+#endif
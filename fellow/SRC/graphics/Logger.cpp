@@ -4,7 +4,7 @@
 #include "fileops.h"
 #include "BUS.H"
 
-void Logger::Log(ULO line, ULO cylinder, STR *message)
+void Logger::Log(ULO line, ULO cylinder, const STR *message)
 {
   if (_enableLog)
   {
@@ -15,7 +15,7 @@ void Logger::Log(ULO line, ULO cylinder, STR *message)
       _logfile = fopen(filename, "w");
     }
     fprintf(_logfile, 
-            "Frame %.16I64X Line %.3X Cylinder %.3X (%.3X,%.3X): %s",
+            "Frame %.16llX Line %.3X Cylinder %.3X (%.3X,%.3X): %s",
             busGetRasterFrameCount(),
             line,
             cylinder,
@@ -10,7 +10,7 @@ private:
   FILE *_logfile;
 
 public:
-  void Log(ULO line, ULO cylinder, STR *message);
+  void Log(ULO line, ULO cylinder, const STR *message);
   bool IsLogEnabled(void) {return _enableLog;}
 
   void Shutdown(void);
@@ -24,6 +24,7 @@
 
 #include "DEFS.H"
 
+#include "fellow.h"
 #include "bus.h"
 #include "graph.h"
 #include "draw.h"
@@ -100,10 +101,22 @@ void PixelSerializer::Commit(UWO dat1, UWO dat2, UWO dat3, UWO dat4, UWO dat5, U
   _active[5].l = (_active[5].l & invevenmask) | ( ( ((ULO) dat6) << scrolleven) & evenmask);
 }
 
+// Whole fetch groups are converted 16 pixels at a time, the rest of a batch
+// that was split by a register write in 8, 4 and single pixels.
 void PixelSerializer::SerializePixels(ULO pixelCount)
 {
-  ULO pixelIterations8 = pixelCount >> 3;
-  for (ULO i = 0; i < pixelIterations8; ++i)
+  ULO pixelIterations16 = pixelCount >> 4;
+  for (ULO i = 0; i < pixelIterations16; ++i)
+  {
+    GraphicsContext.Planar2ChunkyDecoder.P2CNext16Pixels(_active[0].l >> 16,
+			                                 _active[1].l >> 16,
+			                                 _active[2].l >> 16,
+			                                 _active[3].l >> 16,
+			                                 _active[4].l >> 16,
+			                                 _active[5].l >> 16);
+    ShiftActive(16);
+  }
+  if (pixelCount & 8)
   {
     GraphicsContext.Planar2ChunkyDecoder.P2CNext8Pixels(_active[0].b[3],
 			                                _active[1].b[3],
@@ -150,6 +163,18 @@ void PixelSerializer::SerializeBatch(ULO cylinderCount)
   }
 }
 
+// Frames that won't be shown only keep the shifters in step
+void PixelSerializer::SkipBatch(ULO cylinderCount)
+{
+  ULO pixelCount = (BitplaneUtility::IsLores()) ? cylinderCount : cylinderCount*2;
+  while (pixelCount >= 16)
+  {
+    ShiftActive(16);
+    pixelCount -= 16;
+  }
+  ShiftActive(pixelCount);
+}
+
 ULO PixelSerializer::GetOutputLine(ULO rasterY, ULO cylinder)
 {
   if (cylinder <= LAST_CYLINDER)
@@ -188,12 +213,12 @@ void PixelSerializer::OutputCylindersUntil(ULO rasterY, ULO cylinder)
   if (outputUntilCylinder > 479)
   {
     // For debug
-    MessageBox(0, "outputUntilCylinder larger than it should be", "outputUntilCylinder out of range", 0);
+    fellowAddLog("PixelSerializer: outputUntilCylinder larger than it should be\n");
   }
 
   if (outputUntilCylinder < _lastCylinderOutput)
   {
-    MessageBox(0, "outputUntilCylinder less than _lastCylinderOutput", "outputUntilCylinder out of range", 0);
+    fellowAddLog("PixelSerializer: outputUntilCylinder less than _lastCylinderOutput\n");
   }
 
   if (cylinderCount == 0)
@@ -201,13 +226,25 @@ void PixelSerializer::OutputCylindersUntil(ULO rasterY, ULO cylinder)
     return;
   }
 
+  bool frameShown = (draw_frame_skip == 0);
+
   GraphicsContext.Planar2ChunkyDecoder.NewBatch();
-  SerializeBatch(cylinderCount);
+  if (frameShown)
+  {
+    SerializeBatch(cylinderCount);
+  }
+  else
+  {
+    SkipBatch(cylinderCount);
+  }
   if (GraphicsContext.DIWYStateMachine.IsVisible() && _activated)
   {
     cycle_exact_sprites->OutputSprites(_lastCylinderOutput + 1, cylinderCount);
   }
-  GraphicsContext.BitplaneDraw.DrawBatch(outputLine, _lastCylinderOutput + 1);
+  if (frameShown)
+  {
+    GraphicsContext.BitplaneDraw.DrawBatch(outputLine, _lastCylinderOutput + 1);
+  }
 
   _lastCylinderOutput = outputUntilCylinder;
 }
@@ -52,6 +52,7 @@ private:
   
   void SerializePixels(ULO pixelCount);
   void SerializeBatch(ULO cylinderCount);
+  void SkipBatch(ULO cylinderCount);
 
 public:
   void Commit(UWO dat1, UWO dat2, UWO dat3, UWO dat4, UWO dat5, UWO dat6);
@@ -24,6 +24,9 @@
 
 #include "defs.h"
 
+#include <emmintrin.h>
+
+#include "fellow.h"
 #include "graph.h"
 
 #include "Graphics.h"
@@ -88,6 +91,33 @@ ULO Planar2ChunkyDecoder::P2CDual2(ULO dat1, ULO dat2, ULO dat3)
   return graph_deco1[dat1][1] | graph_deco2[dat2][1] | graph_deco3[dat3][1]; 
 }
 
+//----------------------------------------------------------------------------
+// Planar to chunky conversion of a whole 16 pixel fetch group with SSE2.
+//
+// The 16 bits of a bitplane word are spread to one byte per pixel, each byte
+// is value where its bit is set. The values are the bits the lookup tables
+// above set for each plane.
+//
+//----------------------------------------------------------------------------
+
+static __inline __m128i P2CPlane16(ULO dat, UBY value)
+{
+  const __m128i mask = _mm_setr_epi8((char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1, (char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1);
+
+  // The high byte holds the first 8 pixels
+  __m128i bits = _mm_cvtsi32_si128(((dat >> 8) & 0xff) | ((dat & 0xff) << 8));
+  bits = _mm_unpacklo_epi8(bits, bits);
+  bits = _mm_unpacklo_epi16(bits, bits);
+  bits = _mm_unpacklo_epi32(bits, bits);
+  bits = _mm_cmpeq_epi8(_mm_and_si128(bits, mask), mask);
+  return _mm_and_si128(bits, _mm_set1_epi8((char) value));
+}
+
+static __inline __m128i P2CPlanes16(ULO datA, ULO datB, ULO datC, UBY valueA, UBY valueB, UBY valueC)
+{
+  return _mm_or_si128(_mm_or_si128(P2CPlane16(datA, valueA), P2CPlane16(datB, valueB)), P2CPlane16(datC, valueC));
+}
+
 //----------------------------------------------------------------------------
 // Mode dependent planar to chunky decoding of the next pixels.
 // The result is stored in the playfield pixel output stream.
@@ -152,6 +182,22 @@ void Planar2ChunkyDecoder::P2CNext8PixelsDual(ULO dat1, ULO dat2, ULO dat3, ULO
   _batch_size += 8;
 }
 
+void Planar2ChunkyDecoder::P2CNext16PixelsNormal(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6)
+{
+  __m128i pixels = _mm_or_si128(P2CPlanes16(dat1, dat3, dat5, 0x04, 0x10, 0x40), P2CPlanes16(dat2, dat4, dat6, 0x08, 0x20, 0x80));
+  _mm_storeu_si128((__m128i *) (_playfield_odd.barray + _batch_size), pixels);
+
+  _batch_size += 16;
+}
+
+void Planar2ChunkyDecoder::P2CNext16PixelsDual(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6)
+{
+  _mm_storeu_si128((__m128i *) (_playfield_odd.barray + _batch_size), P2CPlanes16(dat1, dat3, dat5, 0x04, 0x08, 0x10));
+  _mm_storeu_si128((__m128i *) (_playfield_even.barray + _batch_size), P2CPlanes16(dat2, dat4, dat6, 0x04, 0x08, 0x10));
+
+  _batch_size += 16;
+}
+
 void Planar2ChunkyDecoder::P2CNextPixels(ULO pixelCount, ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6)
 {
   if (BitplaneUtility::IsDualPlayfield())
@@ -188,11 +234,35 @@ void Planar2ChunkyDecoder::P2CNext8Pixels(ULO dat1, ULO dat2, ULO dat3, ULO dat4
   }
 }
 
+// dat1 to dat6 are 16 bits of bitplane data, the first pixel in bit 15
+// Without SSE2 the group is decoded as two groups of 8 pixels.
+void Planar2ChunkyDecoder::P2CNext16Pixels(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6)
+{
+  if (!_sse2)
+  {
+    P2CNext8Pixels(dat1 >> 8, dat2 >> 8, dat3 >> 8, dat4 >> 8, dat5 >> 8, dat6 >> 8);
+    P2CNext8Pixels(dat1 & 0xff, dat2 & 0xff, dat3 & 0xff, dat4 & 0xff, dat5 & 0xff, dat6 & 0xff);
+  }
+  else if (BitplaneUtility::IsDualPlayfield())
+  {
+    P2CNext16PixelsDual(dat1, dat2, dat3, dat4, dat5, dat6);
+  }
+  else
+  {
+    P2CNext16PixelsNormal(dat1, dat2, dat3, dat4, dat5, dat6);
+  }
+}
+
 void Planar2ChunkyDecoder::NewBatch(void)
 {
   _batch_size = 0;
 }
 
+void Planar2ChunkyDecoder::Startup(void)
+{
+  _sse2 = (fellowCPUHasSSE2() == TRUE);
+}
+
 UBY *Planar2ChunkyDecoder::GetOddPlayfield(void)
 {
   return _playfield_odd.barray;
@@ -39,6 +39,7 @@ class Planar2ChunkyDecoder
 {
 private:
   ULO _batch_size;
+  bool _sse2; // The host CPU has SSE2, set in Startup()
   ByteLongArrayUnion _playfield_odd;
   ByteLongArrayUnion _playfield_even;
   ByteLongArrayUnion _playfield_ham_sprites;
@@ -59,6 +60,8 @@ private:
   void P2CNext4PixelsDual(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
   void P2CNext8PixelsNormal(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
   void P2CNext8PixelsDual(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
+  void P2CNext16PixelsNormal(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
+  void P2CNext16PixelsDual(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
 
 public:
   UBY *GetOddPlayfield(void);
@@ -67,9 +70,11 @@ public:
   ULO GetBatchSize(void);
 
   void NewBatch(void);
+  void Startup(void);
   void P2CNextPixels(ULO pixelCount, ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
   void P2CNext4Pixels(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
   void P2CNext8Pixels(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
+  void P2CNext16Pixels(ULO dat1, ULO dat2, ULO dat3, ULO dat4, ULO dat5, ULO dat6);
 };
 
 #endif
@@ -0,0 +1,336 @@
+/*=========================================================================*/
+/* Fellow                                                                  */
+/*                                                                         */
+/* Line hash benchmark, replays a decoded line trace (graphlines.trc)      */
+/* through the old compare and copy of the line data and through the line  */
+/* hash, and reports the hit rate and the cycles each of them took.        */
+/*                                                                         */
+/* The trace is recorded by an emulator built with GRAPH_LINE_LOG. The     */
+/* two methods below are copies of the ones in C/GRAPH.C, before and after */
+/* the line hash replaced the compare.                                     */
+/*                                                                         */
+/* This file is under the GNU Public License (GPL)                         */
+/*=========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "defs.h"
+#include "graph.h"
+#include "graph_line_hash.h"
+
+#define LINEHASHBENCH_LINES (3*628)
+
+/*=========================================================================*/
+/* Trace loading                                                           */
+/*=========================================================================*/
+
+typedef struct
+{
+  graph_line_trace_record record;
+  UBY *decoded1;
+  UBY *decoded2;
+  UBY *merged1;
+  UBY *merged2;
+} linehashbench_line;
+
+UBY *linehashbench_trace;
+linehashbench_line *linehashbench_lines;
+ULO linehashbench_line_count;
+ULO linehashbench_frame_count;
+
+static BOOLE linehashbenchLoadTrace(char *filename)
+{
+  FILE *F = fopen(filename, "rb");
+  long size;
+  ULO offset, line_capacity = 0, last_frame = 0;
+
+  if (F == NULL)
+  {
+    fprintf(stderr, "Can't open %s\n", filename);
+    return FALSE;
+  }
+  fseek(F, 0, SEEK_END);
+  size = ftell(F);
+  fseek(F, 0, SEEK_SET);
+  linehashbench_trace = (UBY *) malloc(size);
+  if (size < 8 || fread(linehashbench_trace, 1, size, F) != (size_t) size
+    || ((ULO *) linehashbench_trace)[0] != GRAPH_LINE_TRACE_MAGIC || ((ULO *) linehashbench_trace)[1] != GRAPH_LINE_TRACE_VERSION)
+  {
+    fprintf(stderr, "%s is not a version %u line trace\n", filename, GRAPH_LINE_TRACE_VERSION);
+    fclose(F);
+    return FALSE;
+  }
+  fclose(F);
+
+  offset = 8;
+  while (offset + sizeof(graph_line_trace_record) <= (ULO) size)
+  {
+    linehashbench_line *line;
+    ULO copies, pixels;
+
+    if (linehashbench_line_count == line_capacity)
+    {
+      line_capacity = (line_capacity == 0) ? 65536 : 2*line_capacity;
+      linehashbench_lines = (linehashbench_line *) realloc(linehashbench_lines, sizeof(linehashbench_line)*line_capacity);
+    }
+    line = &linehashbench_lines[linehashbench_line_count];
+    memcpy(&line->record, linehashbench_trace + offset, sizeof(graph_line_trace_record));
+    offset += sizeof(graph_line_trace_record);
+
+    pixels = line->record.pixel_count;
+    copies = ((line->record.flags & GRAPH_LINE_TRACE_DUAL) ? 2 : 1)*((line->record.flags & GRAPH_LINE_TRACE_SPRITES) ? 2 : 1);
+    if (line->record.line_index >= LINEHASHBENCH_LINES || line->record.first_pixel + pixels > 1024 || offset + copies*pixels > (ULO) size) break;
+
+    // The line buffers are indexed by pixel position, like graph_line1_tmp
+    line->decoded1 = linehashbench_trace + offset - line->record.first_pixel;
+    offset += pixels;
+    line->decoded2 = line->decoded1;
+    if (line->record.flags & GRAPH_LINE_TRACE_DUAL)
+    {
+      line->decoded2 = linehashbench_trace + offset - line->record.first_pixel;
+      offset += pixels;
+    }
+    line->merged1 = line->merged2 = NULL;
+    if (line->record.flags & GRAPH_LINE_TRACE_SPRITES)
+    {
+      line->merged1 = linehashbench_trace + offset - line->record.first_pixel;
+      offset += pixels;
+      line->merged2 = line->merged1;
+      if (line->record.flags & GRAPH_LINE_TRACE_DUAL)
+      {
+	line->merged2 = linehashbench_trace + offset - line->record.first_pixel;
+	offset += pixels;
+      }
+    }
+    if (linehashbench_line_count == 0 || line->record.frame != last_frame)
+    {
+      last_frame = line->record.frame;
+      linehashbench_frame_count++;
+    }
+    linehashbench_line_count++;
+  }
+  if (offset != (ULO) size)
+  {
+    fprintf(stderr, "%s is damaged, using the first %u lines\n", filename, linehashbench_line_count);
+  }
+  return TRUE;
+}
+
+/*=========================================================================*/
+/* Old method, compare the stored line and copy from the first difference  */
+/*=========================================================================*/
+
+static BOOLE linehashbenchCompareCopyRest(ULO first_pixel, LON pixel_count, UBY* dest_line, UBY* source_line)
+{
+  while ((first_pixel & 0x3) != 0)
+  {
+    dest_line[first_pixel] = source_line[first_pixel];
+    first_pixel++;
+    pixel_count--;
+    if (pixel_count == 0)
+    {
+      return TRUE;
+    }
+  }
+
+  while (pixel_count >= 4)
+  {
+    *((ULO *) (dest_line + first_pixel)) = *((ULO *) (source_line + first_pixel));
+    first_pixel += 4;
+    pixel_count -= 4;
+  }
+
+  while (pixel_count > 0)
+  {
+    dest_line[first_pixel] = source_line[first_pixel];
+    first_pixel++;
+    pixel_count--;
+  }
+  return TRUE;
+}
+
+static BOOLE linehashbenchCompareCopy(ULO first_pixel, LON pixel_count, UBY* dest_line, UBY* source_line)
+{
+  BOOLE result = FALSE;
+
+  if (pixel_count > 0)
+  {
+    while ((first_pixel & 0x3) != 0)
+    {
+      if (dest_line[first_pixel] == source_line[first_pixel])
+      {
+	first_pixel++;
+	pixel_count--;
+	if (pixel_count == 0)
+	{
+	  return FALSE;
+	}
+      }
+      else
+      {
+	return linehashbenchCompareCopyRest(first_pixel, pixel_count, dest_line, source_line);
+      }
+    }
+
+    while (pixel_count >= 4)
+    {
+      if (*((ULO *) (source_line + first_pixel)) == *((ULO *) (dest_line + first_pixel)))
+      {
+	first_pixel += 4;
+	pixel_count -= 4;
+      }
+      else
+      {
+	return linehashbenchCompareCopyRest(first_pixel, pixel_count, dest_line, source_line);
+      }
+    }
+
+    while (pixel_count > 0)
+    {
+      if (source_line[first_pixel] == dest_line[first_pixel])
+      {
+	first_pixel++;
+	pixel_count--;
+      }
+      else
+      {
+	result = TRUE;
+	dest_line[first_pixel] = source_line[first_pixel];
+	first_pixel++;
+	pixel_count--;
+      }
+    }
+  }
+  return result;
+}
+
+static BOOLE linehashbenchOld(graph_line *stored, linehashbench_line *line, BOOLE dual)
+{
+  BOOLE changed = linehashbenchCompareCopy(line->record.first_pixel, (LON) line->record.pixel_count, stored->line1, line->decoded1);
+  if (dual)
+  {
+    changed |= linehashbenchCompareCopy(line->record.first_pixel, (LON) line->record.pixel_count, stored->line2, line->decoded2);
+  }
+  return changed;
+}
+
+/*=========================================================================*/
+/* New method, compare the hash of the line and copy all of it if changed  */
+/*=========================================================================*/
+
+static BOOLE linehashbenchNew(graph_line *stored, linehashbench_line *line, BOOLE dual)
+{
+  ULO first_pixel = line->record.first_pixel;
+  ULO pixel_count = line->record.pixel_count;
+  ULL hash = graphLineHash(graphLineHashSeed(first_pixel, pixel_count, dual), line->decoded1 + first_pixel, pixel_count);
+
+  if (dual)
+  {
+    hash = graphLineHash(hash, line->decoded2 + first_pixel, pixel_count);
+  }
+  if (stored->line_hash_valid && stored->line_hash == hash)
+  {
+    return FALSE;
+  }
+
+  memcpy(stored->line1 + first_pixel, line->decoded1 + first_pixel, pixel_count);
+  if (dual)
+  {
+    memcpy(stored->line2 + first_pixel, line->decoded2 + first_pixel, pixel_count);
+  }
+  stored->line_hash = hash;
+  stored->line_hash_valid = true;
+  return TRUE;
+}
+
+/*=========================================================================*/
+/* Replay                                                                  */
+/*=========================================================================*/
+
+/* Runs the trace through one of the methods, the stored lines start out empty. */
+/* changed gets the decision for each line, the return value is the cycle count. */
+static ULL linehashbenchReplay(graph_line *stored_lines, BOOLE use_hash, UBY *changed)
+{
+  ULL start;
+  ULO i;
+
+  memset(stored_lines, 0, sizeof(graph_line)*LINEHASHBENCH_LINES);
+  start = __rdtsc();
+  for (i = 0; i < linehashbench_line_count; i++)
+  {
+    linehashbench_line *line = &linehashbench_lines[i];
+    graph_line *stored = &stored_lines[line->record.line_index];
+    BOOLE dual = (line->record.flags & GRAPH_LINE_TRACE_DUAL) != 0;
+    changed[i] = (UBY) ((use_hash) ? linehashbenchNew(stored, line, dual) : linehashbenchOld(stored, line, dual));
+
+    // Sprites are merged into the stored line, the same way in both methods
+    if (line->merged1 != NULL)
+    {
+      memcpy(stored->line1 + line->record.first_pixel, line->merged1 + line->record.first_pixel, line->record.pixel_count);
+      if (dual)
+      {
+	memcpy(stored->line2 + line->record.first_pixel, line->merged2 + line->record.first_pixel, line->record.pixel_count);
+      }
+      stored->line_hash_valid = false;
+    }
+  }
+  return __rdtsc() - start;
+}
+
+int main(int argc, char *argv[])
+{
+  ULO repeat = 1;
+  ULO i, r;
+  ULO hits = 0, sprite_lines = 0, false_skips = 0, extra_copies = 0;
+  ULL old_cycles = 0, new_cycles = 0;
+  graph_line *stored_lines;
+  UBY *old_changed, *new_changed;
+
+  if (argc < 2)
+  {
+    printf("Usage: linehashbench <graphlines.trc> [repeat count]\n");
+    return 1;
+  }
+  if (argc >= 3) repeat = atoi(argv[2]);
+  if (repeat == 0) repeat = 1;
+  if (!linehashbenchLoadTrace(argv[1])) return 1;
+  if (linehashbench_line_count == 0)
+  {
+    printf("No lines in %s\n", argv[1]);
+    return 0;
+  }
+
+  stored_lines = (graph_line *) malloc(sizeof(graph_line)*LINEHASHBENCH_LINES);
+  old_changed = (UBY *) malloc(linehashbench_line_count);
+  new_changed = (UBY *) malloc(linehashbench_line_count);
+  for (r = 0; r < repeat; r++)
+  {
+    old_cycles += linehashbenchReplay(stored_lines, FALSE, old_changed);
+    new_cycles += linehashbenchReplay(stored_lines, TRUE, new_changed);
+  }
+
+  for (i = 0; i < linehashbench_line_count; i++)
+  {
+    if (linehashbench_lines[i].record.flags & (GRAPH_LINE_TRACE_SPRITES | GRAPH_LINE_TRACE_HAM_SPRITES)) sprite_lines++;
+    if (!new_changed[i]) hits++;
+    if (!new_changed[i] && old_changed[i]) false_skips++;
+    if (new_changed[i] && !old_changed[i]) extra_copies++;
+  }
+
+  printf("%u lines in %u frames, %u passes\n", linehashbench_line_count, linehashbench_frame_count, repeat);
+  printf("%u lines unchanged (%.1f%%), %u lines with sprites\n", hits, (100.0*hits)/linehashbench_line_count, sprite_lines);
+  printf("Compare and copy: %.1f cycles per line\n", ((double) old_cycles)/(((double) linehashbench_line_count)*repeat));
+  printf("Hash and copy:    %.1f cycles per line\n", ((double) new_cycles)/(((double) linehashbench_line_count)*repeat));
+  printf("Saved:            %.0f cycles per frame\n", (((double) old_cycles) - ((double) new_cycles))/(((double) linehashbench_frame_count)*repeat));
+  printf("%u lines copied by the hash that the compare found unchanged\n", extra_copies);
+  printf("%u lines skipped by the hash that the compare found changed\n", false_skips);
+  return (false_skips == 0) ? 0 : 2;
+}
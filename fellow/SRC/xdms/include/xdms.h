@@ -1,6 +1,7 @@
 #ifndef XDMS_H
 #define XDMS_H
 
+#include "cdata.h"
 #include "pfile.h"
 
 USHORT dmsUnpack(char *, char *);